@@ -22,11 +22,16 @@
 #include "client/animation.hpp"
 #include "client/animationmanager.hpp"
 #include "client/bone.hpp"
+#include "client/snapshotinterpolator.hpp"
 
+#include "shared/game/movementpredictor.hpp"
 #include "shared/game/sharedgamestate.hpp"
 #include "shared/game/sharedobject.hpp"
 #include "shared/network/packet.hpp"
+#include "shared/network/resyncreceiver.hpp"
 #include "shared/network/session.hpp"
+#include "shared/network/snapshotchannel.hpp"
+#include "shared/network/snapshotreceiver.hpp"
 #include "shared/utilities/config.hpp"
 #include "shared/utilities/constants.hpp"
 #include "shared/utilities/typedefs.hpp"
@@ -93,7 +98,8 @@ public:
     void idleCallback();
 
     /**
-     * @brief sends all queued packets to server
+     * @brief sends all of the input generated this frame to the server, as a single
+     * InputFrame packet
      */
     void sendPacketsToServer();
 
@@ -209,6 +215,24 @@ private:
      */
     void processServerInput(bool allow_defer);
 
+    /**
+     * @brief Sets up snapshot_channel once the server has told us its UDP port, and queues
+     * up any snapshots that have arrived on it in events_received
+     */
+    void _pollSnapshotChannel();
+
+    /**
+     * @brief Sends an input event that moves the player to the server, and applies it to
+     * the predicted movement straight away
+     */
+    void _addMovementInput(const Event& event);
+
+    /**
+     * @brief Starts or stops predicting the player's own movement as needed, and predicts
+     * however many ticks the server would have run since the last call
+     */
+    void _updatePrediction();
+
     GLuint gBuffer;
     GLuint gPosition, gNormal, gAlbedoSpec;
     GLuint quadVAO = 0;
@@ -371,6 +395,27 @@ private:
     basic_resolver_results<class boost::asio::ip::tcp> endpoints;
     std::shared_ptr<Session> session;
 
+    /// @brief Where snapshots arrive once the server has told us its UDP port
+    std::shared_ptr<SnapshotChannel> snapshot_channel;
+
+    /// @brief Which snapshot chunks have arrived, from either the session or snapshot_channel
+    SnapshotReceiver snapshot_receiver;
+
+    /// @brief Holds on to the full state the server sends when we (re)connect until all of it is here
+    ResyncReceiver resync_receiver;
+
+    /// @brief Smooths the motion of objects between snapshots when drawing them
+    SnapshotInterpolator interpolator;
+
+    /// @brief Predicts the player's own movement ahead of the server
+    MovementPredictor predictor;
+
+    /// @brief Time up to which predictor has predicted, from glfwGetTime()
+    double prediction_time = 0.0;
+
+    /// @brief EntityID snapshot_channel said hello as
+    EntityID snapshot_channel_eid = 0;
+
     glm::vec3 world_pos; // stored world pause, calculated before the GUI is rendered
 
     std::array<boost::optional<SharedObject>, MAX_POINT_LIGHTS> closest_light_sources;
@@ -9,3 +9,11 @@
 #define UNIT_WINDOW_HEIGHT 1080
 
 #define PLAYER_EYE_LEVEL 3.45f
+
+// Snapshot interpolation (see SnapshotInterpolator)
+#define INTERP_BUFFER_CAPACITY   16     // snapshots kept for interpolation
+#define INTERP_MIN_DELAY_TICKS   1.0    // render at least this many ticks behind the server
+#define INTERP_JITTER_MULTIPLIER 2.0    // how many times the measured jitter to add to the delay
+#define INTERP_MAX_EXTRAPOLATION 0.1    // seconds to keep moving objects once snapshots run out
+#define INTERP_SNAP_DISTANCE     5.0f   // jumps further than this are teleports, not movement
+#define INTERP_CLOCK_RELAX       0.0001 // seconds per snapshot to let the clock offset drift up
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "client/constants.hpp"
+#include "shared/game/sharedgamestate.hpp"
+#include "shared/game/sharedobject.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+using ObjectMap = std::unordered_map<EntityID, boost::optional<SharedObject>>;
+
+/**
+ * Smooths out the motion of objects between game state snapshots.
+ *
+ * The server only sends a snapshot every TIMESTEP_LEN, and they don't arrive exactly that
+ * far apart, so drawing the newest state as soon as it arrives looks stepped and jittery.
+ * Instead this keeps the poses of moving objects from the last few snapshots, and renders
+ * slightly in the past, interpolating between the two snapshots on either side of that
+ * time. If snapshots stop arriving it extrapolates for a short while.
+ *
+ * How far in the past to render adapts to how much the arrival times of the snapshots
+ * vary, so a steady connection has less delay than a jittery one.
+ *
+ * This doesn't depend on anything graphical, so it can be tested by feeding it made up
+ * snapshots and times.
+ */
+class SnapshotInterpolator {
+public:
+    /**
+     * @param capacity Number of snapshots to keep
+     */
+    explicit SnapshotInterpolator(std::size_t capacity = INTERP_BUFFER_CAPACITY);
+
+    /**
+     * Records the state after a snapshot has been applied.
+     *
+     * @param state Client's game state, with the snapshot applied
+     * @param moved Ids of every object whose physics the snapshot changed
+     * @param arrival_time When the snapshot arrived, in seconds on the client's clock
+     */
+    void addSnapshot(const SharedGameState& state, const std::unordered_set<EntityID>& moved,
+        double arrival_time);
+
+    /**
+     * Picks the two snapshots to interpolate between for this frame.
+     *
+     * @param now Current time, in seconds on the same clock as addSnapshot
+     */
+    void update(double now);
+
+    /**
+     * Replaces the pose of every moving object with its interpolated pose, remembering
+     * the real poses so that restore() can put them back.
+     *
+     * @param objects Objects to draw, which should be the ones passed to addSnapshot
+     */
+    void apply(ObjectMap& objects);
+
+    /**
+     * Undoes the previous apply(), so that later snapshots apply on top of the real state.
+     */
+    void restore(ObjectMap& objects);
+
+    /**
+     * @returns Interpolated pose of an object at the time picked by update(), or none
+     * if it isn't moving
+     */
+    boost::optional<SharedPhysics> getPose(EntityID id, const SharedPhysics& current) const;
+
+    /**
+     * Forgets every snapshot, e.g. on reconnecting or starting a new game.
+     */
+    void clear();
+
+    /**
+     * @returns How far behind the newest snapshot objects are drawn, in seconds
+     */
+    double getRenderDelay() const;
+
+    /**
+     * @returns Smoothed variation in snapshot arrival times, in seconds
+     */
+    double getJitter() const;
+
+    /**
+     * @returns Number of snapshots held
+     */
+    std::size_t size() const;
+
+    /**
+     * @returns Whether update() ran out of snapshots and is extrapolating
+     */
+    bool isExtrapolating() const;
+
+private:
+    /**
+     * Poses of every moving object in a single snapshot
+     */
+    struct Frame {
+        unsigned int timestep;
+        /// @brief Server time of the snapshot, in seconds
+        double server_time;
+        std::unordered_map<EntityID, SharedPhysics> poses;
+    };
+
+    /**
+     * @returns The frame the given number of snapshots back from the newest
+     */
+    const Frame& _frame(std::size_t age) const;
+
+    /**
+     * Updates the jitter estimate and render delay with a new arrival time
+     */
+    void _measureArrival(double server_time, double arrival_time);
+
+    /// @brief Ring buffer of snapshots, with the newest at newest_index
+    std::vector<Frame> frames;
+    std::size_t newest_index;
+    std::size_t count;
+
+    /// @brief Objects that have moved at some point, and so need interpolating
+    std::unordered_set<EntityID> moving;
+
+    /// @brief Smallest arrival time minus server time seen, which maps client time to
+    /// server time for the snapshot that arrived fastest
+    double clock_offset;
+    bool has_clock_offset;
+
+    /// @brief Arrival time minus server time of the previous snapshot
+    double last_transit;
+
+    double jitter;
+    double render_delay;
+
+    /// @brief Frames picked by update(): interpolate from from_age to to_age by alpha.
+    /// If extrapolating, alpha is greater than 1
+    std::size_t from_age;
+    std::size_t to_age;
+    double alpha;
+    bool extrapolating;
+
+    /// @brief Poses replaced by apply(), to be put back by restore()
+    std::vector<std::pair<EntityID, SharedPhysics>> saved_poses;
+};
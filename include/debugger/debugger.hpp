@@ -200,10 +200,10 @@ public:
 					std::cout << (object->physics.movable ? "true" : "false") << std::endl;
 				}
 				else if (property.compare("physics.velocity") == 0) {
-					std::cout << glm::to_string(object->physics.velocity) << std::endl;
+					std::cout << glm::to_string(object->physics.velocity()) << std::endl;
 				}
 				else if (property.compare("physics.acceleration") == 0) {
-					std::cout << glm::to_string(object->physics.velocityMultiplier) << std::endl;
+					std::cout << glm::to_string(object->physics.velocityMultiplier()) << std::endl;
 				}
 				else if (property.compare("physics.shared.facing") == 0) {
 					std::cout << glm::to_string(object->physics.shared.facing) << std::endl;
@@ -347,27 +347,27 @@ public:
 
 		//	Set property
 		else if (property.compare("physics.velocity.x") == 0) {
-			obj->physics.velocity.x = value;
+			obj->physics.velocity().x = value;
 			std::cout << "Set object (global id " << id << ") velocity.x to " << value << ".\n";
 		}
 		else if (property.compare("physics.velocity.y") == 0) {
-			obj->physics.velocity.y = value;
+			obj->physics.velocity().y = value;
 			std::cout << "Set object (global id " << id << ") velocity.y to " << value << ".\n";
 		}
 		else if (property.compare("physics.velocity.z") == 0) {
-			obj->physics.velocity.z = value;
+			obj->physics.velocity().z = value;
 			std::cout << "Set object (global id " << id << ") velocity.z to " << value << ".\n";
 		}
 		else if (property.compare("physics.acceleration.x") == 0) {
-			obj->physics.velocityMultiplier.x = value;
+			obj->physics.velocityMultiplier().x = value;
 			std::cout << "Set object (global id " << id << ") acceleration.x to " << value << ".\n";
 		}
 		else if (property.compare("physics.acceleration.y") == 0) {
-			obj->physics.velocityMultiplier.y = value;
+			obj->physics.velocityMultiplier().y = value;
 			std::cout << "Set object (global id " << id << ") acceleration.y to " << value << ".\n";
 		}
 		else if (property.compare("physics.acceleration.z") == 0) {
-			obj->physics.velocityMultiplier.z = value;
+			obj->physics.velocityMultiplier().z = value;
 			std::cout << "Set object (global id " << id << ") acceleration.z to " << value << ".\n";
 		}
 		else {
@@ -19,6 +19,8 @@
  */
 class ArrowTrap: public Trap {
 public:
+    USE_OBJECT_POOL(ArrowTrap)
+
     /**
      * @param corner Corner position of the spike trap
      * @param dir What direction it should shoot in
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Rectangle of GridCell (x, y) positions, from min to max inclusive.
+ *
+ * Objects are axis-aligned boxes, so the GridCells one overlaps always form a
+ * rectangle, and keeping just its corners means working out (and comparing)
+ * an object's GridCells doesn't need any memory of its own. Iterating visits
+ * the cells column by column (x, then y), like the vector of GridCell
+ * positions that this replaces did.
+ */
+struct CellRange {
+	/**
+	 * @brief Iterates over the GridCell positions in a CellRange.
+	 */
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = glm::ivec2;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = glm::ivec2;
+
+		Iterator() : cell(0, 0), min_y(0), max_y(0) {}
+
+		Iterator(glm::ivec2 cell, int min_y, int max_y) :
+			cell(cell), min_y(min_y), max_y(max_y)
+		{}
+
+		glm::ivec2 operator*() const {
+			return this->cell;
+		}
+
+		Iterator& operator++() {
+			if (this->cell.y < this->max_y) {
+				this->cell.y++;
+			} else {
+				this->cell.y = this->min_y;
+				this->cell.x++;
+			}
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator previous = *this;
+			++(*this);
+			return previous;
+		}
+
+		bool operator==(const Iterator& other) const {
+			return this->cell == other.cell;
+		}
+
+	private:
+		glm::ivec2 cell;
+		int min_y;
+		int max_y;
+	};
+
+	/**
+	 * @brief Makes an empty CellRange.
+	 */
+	CellRange() : min(0, 0), max(-1, -1) {}
+
+	CellRange(glm::ivec2 min, glm::ivec2 max) : min(min), max(max) {}
+
+	/**
+	 * @brief Returns whether there are no GridCells in the range (i.e., min is
+	 * past max along either axis).
+	 */
+	bool empty() const {
+		return this->min.x > this->max.x || this->min.y > this->max.y;
+	}
+
+	/**
+	 * @brief Returns the number of GridCells in the range.
+	 */
+	std::size_t size() const {
+		if (this->empty()) {
+			return 0;
+		}
+		return static_cast<std::size_t>(this->max.x - this->min.x + 1) *
+			static_cast<std::size_t>(this->max.y - this->min.y + 1);
+	}
+
+	bool contains(glm::ivec2 cell) const {
+		return cell.x >= this->min.x && cell.x <= this->max.x &&
+			cell.y >= this->min.y && cell.y <= this->max.y;
+	}
+
+	bool operator==(const CellRange& other) const {
+		return (this->empty() && other.empty()) ||
+			(this->min == other.min && this->max == other.max);
+	}
+
+	Iterator begin() const {
+		return this->empty() ? this->end() : Iterator(this->min, this->min.y, this->max.y);
+	}
+
+	Iterator end() const {
+		return this->empty() ? Iterator() : Iterator(glm::ivec2(this->max.x + 1, this->min.y), this->min.y, this->max.y);
+	}
+
+	glm::ivec2 min;
+	glm::ivec2 max;
+};
@@ -4,6 +4,8 @@
 #include <glm/gtx/string_cast.hpp>
 #include <vector>
 
+#include "shared/game/constants.hpp"
+
 /* ServerGameState Constants */
 #define MAX_ENEMY_VALUE			500
 #define NUM_PLAYERS 4
@@ -71,10 +73,6 @@
 //	Mirror use duration in seconds
 #define	MIRROR_USE_DURATION		30
 
-/*	Game	*/
-#define	GRAVITY					0.03f
-#define	PLAYER_SPEED 			1.65f
-#define JUMP_SPEED				0.59f
 
 /* DM Constants */
 #define MAX_TRAPS 10
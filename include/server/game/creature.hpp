@@ -9,6 +9,12 @@ public:
 	SharedStats stats;
 	SharedStatuses statuses;
 
+	/**
+	 * @brief Creature ID (used to index into the creatures SmartVector in
+	 * ObjectManager)
+	 */
+	CreatureID creatureID{};
+
 	/**
 	 * @param type Type of Object
 	 * @param corner Corner position of object
@@ -2,6 +2,7 @@
 
 #include "server/game/constants.hpp"
 #include "server/game/object.hpp"
+#include "server/game/objecthandle.hpp"
 #include "server/game/creature.hpp"
 #include "shared/game/sharedobject.hpp"
 #include <chrono>
@@ -10,6 +11,8 @@ class Weapon;
 
 class DungeonMaster : public Creature {
 public:
+	USE_OBJECT_POOL(DungeonMaster)
+
 	SharedTrapInventory sharedTrapInventory;
 	SharedDMInfo dmInfo;
 
@@ -74,9 +77,9 @@ public:
 	std::chrono::time_point<std::chrono::system_clock> getParalysisStartTime() const;
 
 	/**
-	 * @brief The DM's lightning weapon
+	 * @brief The DM's lightning weapon (unset until the server gives the DM one)
 	 */
-	Weapon* lightning;
+	ObjectHandle<Weapon> lightning;
 
 private:
 	/**
@@ -6,6 +6,8 @@
 
 class Exit : public Object {
 public:
+	USE_OBJECT_POOL(Exit)
+
 	SharedExit shared;
 
 	Exit(bool open, glm::vec3 corner, glm::vec3 dimensions, const PointLightProperties& properties);
@@ -14,6 +14,8 @@
  */
 class FakeWall : public Trap {
 public:
+    USE_OBJECT_POOL(FakeWall)
+
     /**
      * @param corner Corner position of the fake wall
      * @param dimensions dimensions of the fake wall
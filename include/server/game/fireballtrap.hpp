@@ -11,6 +11,8 @@
  */
 class FireballTrap: public Trap {
 public:
+    USE_OBJECT_POOL(FireballTrap)
+
     /**
      * @param corner Corner position of the fireball trap
      * @param dir is the direction the fireball trap is pointing at
@@ -11,6 +11,8 @@
  */
 class FloorSpike : public Trap {
 public:
+    USE_OBJECT_POOL(FloorSpike)
+
     static const int DAMAGE;
 
     /**
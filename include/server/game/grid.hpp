@@ -1,6 +1,7 @@
 #pragma once
 
 #include "server/game/gridcell.hpp"
+#include "server/game/cellrange.hpp"
 #include "server/game/constants.hpp"
 #include <vector>
 
@@ -113,17 +114,15 @@ public:
 	static glm::ivec2 getGridCellFromPosition(glm::vec3 position);
 
 	/**
-	 * @brief Returns a vector of positions of GridCells that contain the
-	 * rectangle that extends from p1 to p2 
+	 * @brief Returns the range of GridCells that contain the rectangle that
+	 * extends from p1 to p2 
 	 * (assumes p1.x <= p2.x and p1.z <= p2.z)
 	 * @param p1 3-D game world point from which rectangle extands
 	 * @param p2 3-D game world point to which rectangle extends
-	 * @return vector of positions of GridCells that contain the rectangle that
-	 * extends from p1 to p2. If p1.x > p2.x or p1.z > p2.z, returns an empty
-	 * vector.
+	 * @return range of GridCells that contain the rectangle that extends from
+	 * p1 to p2. If p1.x > p2.x or p1.z > p2.z, returns an empty range.
 	 */
-	static std::vector<glm::ivec2> getCellsFromPositionRange(glm::vec3 p1,
-		glm::vec3 p2);
+	static CellRange getCellsFromPositionRange(glm::vec3 p1, glm::vec3 p2);
 
 private:
 
@@ -19,6 +19,8 @@
  */
 class Item : public Object {
 public:
+	USE_OBJECT_POOL(Item)
+
 	SharedItemInfo iteminfo;
 
     /**
@@ -9,6 +9,8 @@
 
 class Lava : public Trap {
 public:
+    USE_OBJECT_POOL(Lava)
+
     static const int DAMAGE;
 
     /**
@@ -5,6 +5,8 @@ using namespace std::chrono_literals;
 
 class Minotaur : public Enemy {
 public:
+    USE_OBJECT_POOL(Minotaur)
+
     inline static const float SIGHT_LIMIT_GRID_CELLS = 10.0f;
 
     Minotaur(glm::vec3 corner, glm::vec3 facing);
@@ -5,6 +5,8 @@
 
 class Mirror : public Item {
 public:
+	USE_OBJECT_POOL(Mirror)
+
 	
 	/**
 	 * @brief Mirror constructor
@@ -3,7 +3,11 @@
 #include "server/game/constants.hpp"
 #include "shared/utilities/serialize.hpp"
 #include "shared/utilities/serialize_macro.hpp"
+#include "server/game/cellrange.hpp"
 #include "server/game/collider.hpp"
+#include "server/game/objectpool.hpp"
+#include "server/game/objecttraits.hpp"
+#include "server/game/physicsstore.hpp"
 #include "shared/game/sharedobject.hpp"
 #include "shared/utilities/typedefs.hpp"
 #include "shared/game/sharedmodel.hpp"
@@ -39,10 +43,21 @@ struct Physics {
 		glm::vec3 corner, glm::vec3 facing,
 		glm::vec3 dimensions = glm::vec3(1.0f)):
 		shared{.corner=corner, .facing=facing, .dimensions=dimensions},
-		movable(movable), feels_gravity(true), velocity(glm::vec3(0.0f)), velocityMultiplier(glm::vec3(1.0f)), \
-		currTickVelocity(glm::vec3(0.0f)), nauseous(1.0f), collider(collider)
+		movable(movable), feels_gravity(true), collider(collider)
 	{}
 
+	/**
+	 * @brief Copies another Physics' values. The copy keeps its own velocities
+	 * instead of sharing the other one's PhysicsStore slot.
+	 */
+	Physics(const Physics& other);
+
+	/**
+	 * @brief Copies another Physics' values into this one (into its PhysicsStore
+	 * slot, if it has one).
+	 */
+	Physics& operator=(const Physics& other);
+
 	/**
 	 * @brief Shared physics properties (needed by both the server and the 
 	 * client)
@@ -62,34 +77,91 @@ struct Physics {
 	 */
 	bool feels_gravity;
 
+	/**
+	 * @brief This object's collider type.
+	 */
+	Collider collider;
+
+	/*	Velocities	*/
+
+	//	While the object is in an ObjectManager, these live in its PhysicsStore
+	//	and are read and written through the object's MovableID. Otherwise (and
+	//	for objects that aren't movable) the Physics keeps them itself.
+
 	/**
 	 * @brief 3-D vector that denotes this object's current velocity.
 	 */
-	glm::vec3 velocity;
+	glm::vec3& velocity() {
+		return this->store != nullptr ? this->store->velocity(this->slot) : this->own_velocity;
+	}
+	const glm::vec3& velocity() const {
+		return this->store != nullptr ? this->store->velocity(this->slot) : this->own_velocity;
+	}
 
 	/**
 	 * @brief 3-D vector that denotes this object's velocity multiplier.
 	 */
-	glm::vec3 velocityMultiplier;
+	glm::vec3& velocityMultiplier() {
+		return this->store != nullptr ? this->store->velocityMultiplier(this->slot) : this->own_velocity_multiplier;
+	}
+	const glm::vec3& velocityMultiplier() const {
+		return this->store != nullptr ? this->store->velocityMultiplier(this->slot) : this->own_velocity_multiplier;
+	}
 
 	/**
 	 * @brief Tick velocity for knockbacks
 	 */
-	glm::vec3 currTickVelocity;
+	glm::vec3& currTickVelocity() {
+		return this->store != nullptr ? this->store->currTickVelocity(this->slot) : this->own_curr_tick_velocity;
+	}
+	const glm::vec3& currTickVelocity() const {
+		return this->store != nullptr ? this->store->currTickVelocity(this->slot) : this->own_curr_tick_velocity;
+	}
 
 	/**
 	 * @brief Factor for potion of nausea
 	 */
-	float nauseous;
+	float& nauseous() {
+		return this->store != nullptr ? this->store->nauseous(this->slot) : this->own_nauseous;
+	}
+	float nauseous() const {
+		return this->store != nullptr ? this->store->nauseous(this->slot) : this->own_nauseous;
+	}
 
 	/**
-	 * @brief This object's collider type.
+	 * @brief Moves this Physics' velocities into the given slot of a
+	 * PhysicsStore, which holds them from then on.
+	 * @param store PhysicsStore of the ObjectManager that the object is added to
+	 * @param slot MovableID of the object
 	 */
-	Collider collider;
+	void attach(PhysicsStore& store, MovableID slot);
+
+	/**
+	 * @brief Moves this Physics' velocities out of its PhysicsStore slot and back
+	 * into the Physics itself.
+	 */
+	void detach();
 
 	/*	Debugger Methods	*/
 	std::string to_string(unsigned int tab_offset);
 	std::string to_string() { return this->to_string(0); }
+
+private:
+	/**
+	 * @brief PhysicsStore that holds the velocities, or nullptr if the Physics
+	 * holds them itself.
+	 */
+	PhysicsStore* store = nullptr;
+
+	/**
+	 * @brief Slot in store (the object's MovableID)
+	 */
+	MovableID slot = 0;
+
+	glm::vec3 own_velocity = glm::vec3(0.0f);
+	glm::vec3 own_velocity_multiplier = glm::vec3(1.0f);
+	glm::vec3 own_curr_tick_velocity = glm::vec3(0.0f);
+	float own_nauseous = 1.0f;
 };
 
 class Object {
@@ -108,7 +180,7 @@ public:
 
 	/**
 	 * @brief Movable ID (used to index into the movable
-	 * objects vector in ServerGameState)
+	 * objects vector and the PhysicsStore in ObjectManager)
 	 */
 	MovableID movableID{};
 
@@ -141,10 +213,10 @@ public:
     bool is_sprinting;
 
 	/**
-	 * @brief Vector of (x, y) positions of GridCells currently occupied by this
+	 * @brief Range of (x, y) positions of GridCells currently occupied by this
 	 * object
 	 */
-	std::vector<glm::ivec2> gridCellPositions;
+	CellRange gridCellPositions;
 
 	/**
 	 * @brief Distance moved, for use in deciding when to play footsteps
@@ -180,6 +252,37 @@ public:
 	 */
 	virtual SharedObject toShared();
 
+	/*	SharedObject caching	*/
+
+	/**
+	 * @brief Returns this object's SharedObject, only calling toShared() again
+	 * if the object was marked dirty since the last time it was built.
+	 * Anything that is sent to clients should go through here, so that an
+	 * object that hasn't changed isn't built again for every client.
+	 *
+	 * @note This is a whole-object dirty flag (set by markDirty(), which
+	 * ServerGameState::markAsUpdated() calls) plus a diff of the rebuilt
+	 * SharedObject against the cached one, rather than per-field dirty bits
+	 * set by every mutator.
+	 */
+	const SharedObject& getShared();
+
+	/**
+	 * @brief Marks the cached SharedObject as out of date, so that the next
+	 * getShared() or takeSharedChanges() calls toShared() again.
+	 */
+	void markDirty();
+
+	/**
+	 * @brief Brings the cached SharedObject up to date (see getShared()) and
+	 * returns which of its fields have changed since the last call, i.e.
+	 * since it was last broadcast. Changes picked up by a getShared() in
+	 * between (e.g. for a resync) are still counted.
+	 * @return Mask of the changed fields: every field if the object has never
+	 * been broadcast, 0 if nothing has changed since it was.
+	 */
+	SharedObjectFieldMask takeSharedChanges();
+
 	/**
 	 * @brief Code to run when this object collides with another
 	 * 
@@ -188,11 +291,55 @@ public:
      */
 	virtual void doCollision(Object* other, ServerGameState& state) {};
 
+	/*	Type checks	*/
+
+	/**
+	 * @brief Returns whether this object is a T, going by its ObjectType (see
+	 * ObjectTypeTraits) rather than RTTI.
+	 */
+	template <typename T>
+	bool is() const {
+		return ObjectTypeTraits<T>::matches(this->type);
+	}
+
+	/**
+	 * @brief Cheaper replacement for dynamic_cast<T*>(this), for the classes
+	 * that ObjectTypeTraits knows about.
+	 * @return This object as a T, or nullptr if it isn't one.
+	 */
+	template <typename T>
+	T* as() {
+		return this->is<T>() ? static_cast<T*>(this) : nullptr;
+	}
 
 	/*	Debugger Methods	*/
 
 	std::string to_string(unsigned int tab_offset);
 	std::string to_string() { return this->to_string(0); }
+
+private:
+	/**
+	 * @brief Calls toShared() again if the object is dirty, adding any fields
+	 * that changed to unbroadcastChanges.
+	 */
+	void rebuildShared();
+
+	/**
+	 * @brief Result of the last toShared() done by getShared() or
+	 * takeSharedChanges()
+	 */
+	boost::optional<SharedObject> sharedCache;
+
+	/**
+	 * @brief Whether the object may have changed since sharedCache was built
+	 */
+	bool sharedDirty = true;
+
+	/**
+	 * @brief Fields of sharedCache that have changed since the object was last
+	 * broadcast (all of them until it has been broadcast once)
+	 */
+	SharedObjectFieldMask unbroadcastChanges = ALL_SHARED_OBJECT_FIELDS;
 };
 
 enum class Direction {
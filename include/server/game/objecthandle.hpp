@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "shared/utilities/typedefs.hpp"
+
+/**
+ * @brief Counter that ObjectManager bumps every time an EntityID is freed, so
+ * that an ObjectHandle made before then can tell that its EntityID now belongs
+ * to a different object (or none).
+ */
+using Generation = uint32_t;
+
+/**
+ * @brief Reference from one object to another that can't dangle.
+ *
+ * An ObjectHandle is an object's EntityID together with the Generation of that
+ * EntityID when the handle was made, packed into 64 bits. ObjectManager::resolve
+ * turns it back into a pointer, or into nullptr once the object has been removed,
+ * even if its EntityID (and its ObjectPool slot) have since been reused by a new
+ * object.
+ *
+ * Get one with ObjectManager::handleOf. A default-constructed handle refers to
+ * no object.
+ *
+ * @tparam T Type of the object referred to, which resolve returns
+ */
+template <typename T>
+class ObjectHandle {
+public:
+	ObjectHandle() : id(0) {}
+
+	/**
+	 * @brief EntityID of the object referred to
+	 */
+	EntityID index() const { return static_cast<EntityID>(this->id); }
+
+	/**
+	 * @brief Generation of the EntityID when the handle was made. 0 means that
+	 * the handle doesn't refer to an object.
+	 */
+	Generation generation() const { return static_cast<Generation>(this->id >> 32); }
+
+	/**
+	 * @brief Whether the handle was made for an object. (It may still be stale;
+	 * only ObjectManager::resolve can tell.)
+	 */
+	bool isSet() const { return this->generation() != 0; }
+
+	uint64_t packed() const { return this->id; }
+
+	bool operator==(const ObjectHandle& other) const = default;
+
+	/**
+	 * @brief For boost::hash (e.g. pair_hash)
+	 */
+	friend std::size_t hash_value(const ObjectHandle& handle) {
+		return std::hash<uint64_t>()(handle.id);
+	}
+
+private:
+	friend class ObjectManager;
+
+	ObjectHandle(EntityID index, Generation generation) :
+		id((static_cast<uint64_t>(generation) << 32) | index) {}
+
+	uint64_t id;
+};
@@ -6,11 +6,14 @@
 #include "glm/gtx/hash.hpp"
 
 #include "server/game/object.hpp"
+#include "server/game/objecthandle.hpp"
 #include "server/game/player.hpp"
 #include "server/game/enemy.hpp"
 #include "server/game/dungeonmaster.hpp"
 #include "server/game/solidsurface.hpp"
 #include "server/game/torchlight.hpp"
+#include "server/game/physicsstore.hpp"
+#include "server/game/spatialgrid.hpp"
 //#include "server/game/grid.hpp"
 #include "shared/utilities/smartvector.hpp"
 
@@ -26,8 +29,16 @@ class WeaponCollider;
 class ObjectManager {
 public:
 	ObjectManager();
+
+	/**
+	 * @brief Deletes every object that is still in the game.
+	 */
 	~ObjectManager();
 
+	//	Owns the objects it points to, so can't be copied
+	ObjectManager(const ObjectManager&) = delete;
+	ObjectManager& operator=(const ObjectManager&) = delete;
+
 	/*	Object CRUD methods	*/
 
 	/**
@@ -39,6 +50,10 @@ public:
 	 * 
 	 * @note this is a public wrapper for the _createObject() method.
 	 * 
+	 * @note The object must have been created with new. Every concrete Object
+	 * class uses its own ObjectPool for new (see USE_OBJECT_POOL), and the
+	 * ObjectManager deletes the object when it is removed.
+	 * 
 	 * @param object pointer to the newly created object to add to the ObjectManager.
 	 * @param id boost::optional<EntityID> which is by default boost::none. If given
 	 * a value for a specific EntityID, the new object will be added with the given
@@ -50,6 +65,9 @@ public:
 	/**
 	 * @brief Attempts to remove an object with the given EntityID.
 	 * 
+	 * @note The object is deleted, which hands its memory back to its
+	 * ObjectPool (see USE_OBJECT_POOL).
+	 * 
 	 * @param globalID EntityID of the object to remove.
 	 * @return true if the object was successfully removed and false otherwise.
 	 */
@@ -144,99 +162,159 @@ public:
 	 */
 	Trap* getTrap(SpecificID trapID);
 
+	/*	Object handles	*/
+
+	/**
+	 * @brief Makes a handle to the given object, for other objects to keep
+	 * instead of a pointer to it.
+	 * @param object Pointer to an object in this ObjectManager, or nullptr.
+	 * @return A handle that resolve() turns back into object for as long as it
+	 * is in the game, or an unset handle if object is nullptr.
+	 */
+	template <typename T>
+	ObjectHandle<T> handleOf(T* object) const {
+		if (object == nullptr) {
+			return ObjectHandle<T>();
+		}
+		return ObjectHandle<T>(object->globalID, this->generations.at(object->globalID));
+	}
+
+	/**
+	 * @brief Looks up the object a handle was made for.
+	 * @param handle Handle from handleOf().
+	 * @return A pointer to the object, or nullptr if the handle is unset or the
+	 * object has been removed since (even if its EntityID has been reused).
+	 */
+	template <typename T>
+	T* resolve(ObjectHandle<T> handle) {
+		if (!handle.isSet()) {
+			return nullptr;
+		}
+
+		EntityID index = handle.index();
+		if (index >= this->generations.size() || this->generations[index] != handle.generation()) {
+#ifndef NDEBUG
+			this->stale_resolutions++;
+#endif
+			return nullptr;
+		}
+
+		return static_cast<T*>(this->objects.get(index));
+	}
+
+	/**
+	 * @brief Number of times resolve() was given a handle to an object that had
+	 * since been removed. Only counted in debug builds; always 0 with NDEBUG.
+	 */
+	std::size_t getStaleResolutions() const;
+
+	/*	Object lists by type	*/
+
+	//	These return the ObjectManager's own SmartVectors, not copies. A loop
+	//	over one skips objects that are removed before it reaches them, and may
+	//	also visit objects created during the loop (see SmartVector::Iterator).
+
 	/**
 	 * @brief Get a list of all objects in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Object pointers of all objects in the game
+	 * @return Read-only view of the SmartVector of Object pointers of all objects in the game
 	 * instance.
 	 */
-	SmartVector<Object*> getObjects();
+	const SmartVector<Object*>& getObjects() const;
 
 	/**
 	 * @brief Get a list of all objects in this game instance at the current
 	 * timestep that are MOVABLE.
-	 * @return SmartVector of Object pointers of all objects in the game
+	 * @return Read-only view of the SmartVector of Object pointers of all objects in the game
 	 * instance that are MOVABLE.
 	 */
-	SmartVector<Object*> getMovableObjects();
+	const SmartVector<Object*>& getMovableObjects() const;
+
+	/**
+	 * @brief Get a list of all Creatures (Players, Enemies and the Dungeon
+	 * Master) in this game instance at the current timestep.
+	 * @return Read-only view of the SmartVector of Creature pointers of all objects in the game
+	 * instance that derive from Creature.
+	 */
+	const SmartVector<Creature*>& getCreatures() const;
 
 	/**
 	 * @brief Get a list of all items in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Item pointers of all items in the game
+	 * @return Read-only view of the SmartVector of Item pointers of all items in the game
 	 * instance.
 	 */
-	SmartVector<Item*> getItems();
+	const SmartVector<Item*>& getItems() const;
 
 	/**
 	 * @brief Get a list of all SolidSurfaces in this game instance at the
 	 * current timestep.
-	 * @return SmartVector of SolidSurface pointers of all SolidSurface objects
+	 * @return Read-only view of the SmartVector of SolidSurface pointers of all SolidSurface objects
 	 * in the game instance.
 	 */
-	SmartVector<SolidSurface*> getSolidSurfaces();
+	const SmartVector<SolidSurface*>& getSolidSurfaces() const;
 
 	/**
 	 * @brief Get a list of all Players in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Player pointers of all Player objects in the game
+	 * @return Read-only view of the SmartVector of Player pointers of all Player objects in the game
 	 * instance.
 	 */
-	SmartVector<Player*> getPlayers();
+	const SmartVector<Player*>& getPlayers() const;
 
 	/**
 	 * @brief Get a list of all Enemies in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Enemy pointers of all Enemy objects in the game
+	 * @return Read-only view of the SmartVector of Enemy pointers of all Enemy objects in the game
 	 * instance.
 	 */
-	SmartVector<Enemy*> getEnemies();
+	const SmartVector<Enemy*>& getEnemies() const;
 
 	/**
 	 * @brief Get a list of all Traps in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Trap pointers of all Trap objects in the game
+	 * @return Read-only view of the SmartVector of Trap pointers of all Trap objects in the game
 	 * instance.
 	 */
-	SmartVector<Trap*> getTraps();
+	const SmartVector<Trap*>& getTraps() const;
 
 	/**
 	 * @brief Get a list of all Projectiles in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Projectile pointers of all Projectile objects in the game
+	 * @return Read-only view of the SmartVector of Projectile pointers of all Projectile objects in the game
 	 * instance.
 	 */
-	SmartVector<Projectile*> getProjectiles();
+	const SmartVector<Projectile*>& getProjectiles() const;
 
 	/**
 	 * @brief Get a list of all Projectiles in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Projectile pointers of all Projectile objects in the game
+	 * @return Read-only view of the SmartVector of Projectile pointers of all Projectile objects in the game
 	 * instance
 	 */
-	SmartVector<Torchlight*> getTorchlights();
+	const SmartVector<Torchlight*>& getTorchlights() const;
 
     /**
 	 * @brief Get a list of all WeaponCollider in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of WeaponCollider pointers of all WeaponCollider objects in the game
+	 * @return Read-only view of the SmartVector of WeaponCollider pointers of all WeaponCollider objects in the game
 	 * instance.
 	 */
-	SmartVector<WeaponCollider*> getWeaponColliders();
+	const SmartVector<WeaponCollider*>& getWeaponColliders() const;
 
 	/**
 	 * @brief Get a list of all Exits in this game instance at the current
 	 * timestep.
-	 * @return SmartVector of Exit pointers of all Exit objects in the game
+	 * @return Read-only view of the SmartVector of Exit pointers of all Exit objects in the game
 	 * instance.
 	 */
-	SmartVector<Exit*> getExits();
+	const SmartVector<Exit*>& getExits() const;
 
 	/*	Object Movement	*/
 	
 	/**
 	 * @brief Attempts to move the given Object to the given corner position,
-	 * updating its GridCell position vector and the cellToObjects hashmap.
+	 * updating its GridCell position vector and the spatial grid.
 	 * @param object Pointer to the Object to move.
 	 * @param newCornerPosition The new corner position the Object to which the
 	 * Object will be moved.
@@ -247,31 +325,47 @@ public:
 	bool moveObject(Object* object, glm::vec3 newCornerPosition);
 
 	/**
-	 * @brief Given an object, his function will return a vector of positions of
-	 * GridCells that are currently occupied by this object.
-	 * @param object Pointer to the Object whose occupied GridCell position
-	 * vector will be calculated.
-	 * @return A vector of positions of GridCells currently occupied by this
-	 * object. If the object pointer is nullptr, an empty vector will be
-	 * returned.
+	 * @brief Given an object, his function will return the range of positions
+	 * of GridCells that are currently occupied by this object.
+	 * @param object Pointer to the Object whose occupied GridCell range will be
+	 * calculated.
+	 * @return The range of positions of GridCells currently occupied by this
+	 * object.
+	 */
+	CellRange objectGridCells(Object* object);
+
+	/**
+	 * @brief Sets the size of the maze that the spatial grid covers (see
+	 * ServerGameState::loadMaze). Objects outside of it still work, but share
+	 * a single bucket.
+	 * @param columns Number of GridCells along the x axis
+	 * @param rows Number of GridCells along the z axis
 	 */
-	std::vector<glm::ivec2> objectGridCells(Object* object);
+	void setGridSize(int columns, int rows);
 
 	/**
-	 * @brief Hashmap that maps GridCell (x, y) positions to a vector of Objects
-	 * that occupy / overlap that GridCell.
+	 * @brief Maps GridCell (x, y) positions to the Objects that occupy /
+	 * overlap that GridCell.
 	 */
-	std::unordered_map<glm::ivec2, std::vector<Object*>> cellToObjects;
+	SpatialGrid spatialGrid;
+
+	/**
+	 * @brief Velocities of all movable objects, indexed by MovableID. Each movable
+	 * object's Physics reads and writes its velocities here for as long as the
+	 * object is in this ObjectManager (see ServerGameState::updateMovement).
+	 */
+	PhysicsStore physicsStore;
 
 	/*	SharedGameState generation	*/
 	
 	/**
 	 * @brief Generates a list of SharedObjects that corresponds to all objects
-	 * in the game instance.
+	 * in the game instance. Empty slots in the objects SmartVector are skipped,
+	 * so the list only holds objects that exist.
 	 * @return Returns a std::vector<SharedObject> that corresponds to all
 	 * objects in the game instance.
 	 */
-	std::vector<boost::optional<SharedObject>> toShared();
+	std::vector<SharedObject> toShared();
 
 private:
 
@@ -328,6 +422,20 @@ private:
 	 */
 	SmartVector<Object *> objects;
 
+	/**
+	 * @brief Current Generation of every EntityID, indexed the same way as
+	 * objects. Starts at 1 and is bumped whenever the object at that EntityID
+	 * is removed, which makes every ObjectHandle to it stale.
+	 */
+	std::vector<Generation> generations;
+
+#ifndef NDEBUG
+	/**
+	 * @brief See getStaleResolutions()
+	 */
+	std::size_t stale_resolutions = 0;
+#endif
+
 	/**
 	 * @brief SmartVector of Object pointers to all objects in the current
 	 * timestep of this game instance that are MOVABLE.
@@ -338,6 +446,15 @@ private:
 	 */
 	SmartVector<Object*> movableObjects;
 
+	/**
+	 * @brief SmartVector of Creature pointers to all objects in the current
+	 * timestep of this game instance that derive from Creature (see
+	 * ObjectCapability::Creature).
+	 *
+	 * Indexed by each Creature's CreatureID.
+	 */
+	SmartVector<Creature*> creatures;
+
 	/*	Type-specific object smart vectors	*/
 	
 	/**
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How much an ObjectPool has been used, since the server started.
+ */
+struct ObjectPoolStats {
+	/// @brief Objects handed out by the pool
+	std::size_t allocations = 0;
+	/// @brief Objects handed back to the pool
+	std::size_t deallocations = 0;
+	/// @brief Objects handed out that haven't been handed back yet
+	std::size_t live = 0;
+	/// @brief Most objects handed out at once
+	std::size_t peak_live = 0;
+	/// @brief Slots in all of the pool's slabs, in use or not
+	std::size_t capacity = 0;
+	/// @brief Number of times the pool went to the heap for a new slab
+	std::size_t slabs = 0;
+};
+
+/**
+ * @brief Makes an ObjectPool's stats available through getObjectPoolStats().
+ * @param name Name of the type the pool is for
+ * @param stats Stats of the pool, which must live as long as the program
+ */
+void registerObjectPool(const std::string& name, const ObjectPoolStats* stats);
+
+/**
+ * @brief Returns the stats of every ObjectPool that has been used so far, by the
+ * name of the type each is for.
+ */
+std::map<std::string, ObjectPoolStats> getObjectPoolStats();
+
+/**
+ * @brief Slab allocator for one concrete Object class.
+ *
+ * Objects are carved out of slabs of slots, and slots are handed back to a free
+ * list when objects are deleted rather than going back to the heap. Slabs are
+ * never freed, so once a game has built up enough slots every later game (e.g. a
+ * new ServerGameState for the next match) reuses them.
+ *
+ * Not thread safe: all game objects are created and deleted on the game thread.
+ *
+ * @tparam T Class the pool is for. Use USE_OBJECT_POOL(T) in the class to make new
+ * and delete use the pool.
+ */
+template <typename T>
+class ObjectPool {
+public:
+	/**
+	 * @brief Returns the pool for T, creating it the first time.
+	 * @param name Name of T, for getObjectPoolStats()
+	 */
+	static ObjectPool& instance(const char* name) {
+		//	Never destroyed, so that objects deleted while the program is exiting
+		//	still have a pool to go back to
+		static ObjectPool* pool = new ObjectPool(name);
+		return *pool;
+	}
+
+	/**
+	 * @brief Returns memory for one object.
+	 * @param size Size of the object being created. Classes derived from T that
+	 * don't have a pool of their own, and so are a different size, come from the
+	 * heap instead.
+	 */
+	void* allocate(std::size_t size) {
+		if (size != sizeof(T)) {
+			return ::operator new(size);
+		}
+
+		if (this->free_slots == nullptr) {
+			this->grow();
+		}
+
+		Slot* slot = this->free_slots;
+		this->free_slots = slot->next;
+
+		this->stats.allocations++;
+		this->stats.live++;
+		if (this->stats.live > this->stats.peak_live) {
+			this->stats.peak_live = this->stats.live;
+		}
+
+		return slot;
+	}
+
+	/**
+	 * @brief Hands back memory returned by allocate().
+	 * @param size Size of the object that was deleted
+	 */
+	void deallocate(void* ptr, std::size_t size) {
+		if (ptr == nullptr) {
+			return;
+		}
+		if (size != sizeof(T)) {
+			::operator delete(ptr);
+			return;
+		}
+
+		Slot* slot = static_cast<Slot*>(ptr);
+		slot->next = this->free_slots;
+		this->free_slots = slot;
+
+		this->stats.deallocations++;
+		this->stats.live--;
+	}
+
+	const ObjectPoolStats& getStats() const {
+		return this->stats;
+	}
+
+private:
+	/**
+	 * @brief Number of slots in the first slab. Each slab after that is as big as
+	 * all of the ones before it, up to MAX_SLAB_SLOTS.
+	 */
+	static constexpr std::size_t FIRST_SLAB_SLOTS = 16;
+	static constexpr std::size_t MAX_SLAB_SLOTS = 1024;
+
+	union Slot {
+		Slot* next;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	explicit ObjectPool(const char* name) {
+		registerObjectPool(name, &this->stats);
+	}
+
+	/**
+	 * @brief Adds a new slab, and puts all of its slots on the free list.
+	 */
+	void grow() {
+		std::size_t num_slots = FIRST_SLAB_SLOTS;
+		if (this->stats.capacity > num_slots) {
+			num_slots = this->stats.capacity < MAX_SLAB_SLOTS ? this->stats.capacity : MAX_SLAB_SLOTS;
+		}
+
+		auto slab = std::make_unique<Slot[]>(num_slots);
+		for (std::size_t i = num_slots; i > 0; i--) {
+			slab[i - 1].next = this->free_slots;
+			this->free_slots = &slab[i - 1];
+		}
+		this->slabs.push_back(std::move(slab));
+
+		this->stats.capacity += num_slots;
+		this->stats.slabs++;
+	}
+
+	std::vector<std::unique_ptr<Slot[]>> slabs;
+	Slot* free_slots = nullptr;
+	ObjectPoolStats stats;
+};
+
+/**
+ * @brief Gives a concrete Object class an ObjectPool of its own, so that creating it
+ * with new and deleting it (e.g. in ObjectManager::removeObject) use the pool instead
+ * of the heap. Goes in the public section of the class.
+ *
+ * Object has a virtual destructor, so deleting through an Object* uses the operator
+ * delete of the class that was actually created.
+ */
+#define USE_OBJECT_POOL(Type) \
+	static void* operator new(std::size_t size) { \
+		return ObjectPool<Type>::instance(#Type).allocate(size); \
+	} \
+	static void operator delete(void* ptr, std::size_t size) { \
+		ObjectPool<Type>::instance(#Type).deallocate(ptr, size); \
+	}
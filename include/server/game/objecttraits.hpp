@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+
+#include "shared/game/sharedobject.hpp"
+
+/**
+ * @brief What kind of class an ObjectType belongs to, for types that share a
+ * base class (e.g. everything that derives from Creature). One bit each, so
+ * that they can be combined.
+ */
+enum class ObjectCapability : uint32_t {
+	Creature = 1 << 0,
+	Enemy = 1 << 1,
+	Item = 1 << 2,
+	Trap = 1 << 3
+};
+
+/**
+ * @brief Returns the ObjectCapability bits of every base class that objects of
+ * the given type derive from. Works out the same thing as a dynamic_cast to
+ * each of those base classes, but without going through RTTI.
+ *
+ * @note When adding a new ObjectType that derives from Creature, Item or Trap,
+ * add it here as well (ObjectTraitsTest checks this against dynamic_cast).
+ */
+constexpr uint32_t objectCapabilities(ObjectType type) {
+	auto bits = [](auto... capabilities) {
+		return (static_cast<uint32_t>(capabilities) | ...);
+	};
+
+	switch (type) {
+	case ObjectType::Player:
+	case ObjectType::DungeonMaster:
+		return bits(ObjectCapability::Creature);
+	case ObjectType::Enemy:
+	case ObjectType::Slime:
+	case ObjectType::Minotaur:
+	case ObjectType::Python:
+		return bits(ObjectCapability::Creature, ObjectCapability::Enemy);
+	case ObjectType::Item:
+	case ObjectType::Potion:
+	case ObjectType::Spell:
+	case ObjectType::Weapon:
+	case ObjectType::Orb:
+	case ObjectType::Mirror:
+		return bits(ObjectCapability::Item);
+	case ObjectType::SpikeTrap:
+	case ObjectType::FireballTrap:
+	case ObjectType::FloorSpike:
+	case ObjectType::Lava:
+	case ObjectType::FakeWall:
+	case ObjectType::ArrowTrap:
+	case ObjectType::TeleporterTrap:
+		return bits(ObjectCapability::Trap);
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Returns whether objects of the given type have the given capability.
+ */
+constexpr bool hasCapability(ObjectType type, ObjectCapability capability) {
+	return (objectCapabilities(type) & static_cast<uint32_t>(capability)) != 0;
+}
+
+/**
+ * @brief Says which ObjectTypes an Object class stands for, which is what
+ * Object::is<T>() and Object::as<T>() go by.
+ *
+ * Only classes that can be told apart by their ObjectType have traits. Using
+ * as<T>() for any other class (e.g. SpellOrb, which is an ObjectType::Projectile
+ * like every other projectile) doesn't compile.
+ *
+ * @tparam T Class derived from Object
+ */
+template <typename T>
+struct ObjectTypeTraits;
+
+class Object;
+class Creature;
+class Enemy;
+class Item;
+class Trap;
+
+template <>
+struct ObjectTypeTraits<Object> {
+	static constexpr bool matches(ObjectType) { return true; }
+};
+
+#define CAPABILITY_TRAITS(Class) \
+	template <> \
+	struct ObjectTypeTraits<Class> { \
+		static constexpr bool matches(ObjectType type) { \
+			return hasCapability(type, ObjectCapability::Class); \
+		} \
+	}
+
+CAPABILITY_TRAITS(Creature);
+CAPABILITY_TRAITS(Enemy);
+CAPABILITY_TRAITS(Item);
+CAPABILITY_TRAITS(Trap);
+
+#undef CAPABILITY_TRAITS
+
+//	Classes that have an ObjectType of their own (and no subclasses with other
+//	ObjectTypes)
+#define EXACT_TYPE_TRAITS(Class) \
+	class Class; \
+	template <> \
+	struct ObjectTypeTraits<Class> { \
+		static constexpr bool matches(ObjectType type) { \
+			return type == ObjectType::Class; \
+		} \
+	}
+
+EXACT_TYPE_TRAITS(Player);
+EXACT_TYPE_TRAITS(DungeonMaster);
+EXACT_TYPE_TRAITS(Slime);
+EXACT_TYPE_TRAITS(Minotaur);
+EXACT_TYPE_TRAITS(Python);
+EXACT_TYPE_TRAITS(Potion);
+EXACT_TYPE_TRAITS(Spell);
+EXACT_TYPE_TRAITS(Weapon);
+EXACT_TYPE_TRAITS(Orb);
+EXACT_TYPE_TRAITS(Mirror);
+EXACT_TYPE_TRAITS(SpikeTrap);
+EXACT_TYPE_TRAITS(FireballTrap);
+EXACT_TYPE_TRAITS(FloorSpike);
+EXACT_TYPE_TRAITS(Lava);
+EXACT_TYPE_TRAITS(FakeWall);
+EXACT_TYPE_TRAITS(ArrowTrap);
+EXACT_TYPE_TRAITS(TeleporterTrap);
+EXACT_TYPE_TRAITS(SolidSurface);
+EXACT_TYPE_TRAITS(Torchlight);
+EXACT_TYPE_TRAITS(Projectile);
+EXACT_TYPE_TRAITS(WeaponCollider);
+EXACT_TYPE_TRAITS(Exit);
+
+#undef EXACT_TYPE_TRAITS
@@ -9,6 +9,8 @@
 
 class Orb : public Item {
 public:
+    USE_OBJECT_POOL(Orb)
+
     /**
      * @param corner     Corner position of the Orb
      * @param dimensions Dimensions applied for the Orb
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "shared/utilities/typedefs.hpp"
+
+/**
+ * @brief Velocity, velocity multiplier, tick velocity and nausea of every movable
+ * object in an ObjectManager, kept as a structure of arrays indexed by each
+ * object's MovableID.
+ *
+ * This is where those values live while an object is in the game: its Physics
+ * reads and writes them through its slot here (see Physics::velocity()). That
+ * lets ServerGameState::updateMovement work out how far every object wants to
+ * move with one pass over the arrays, before resolving collisions object by
+ * object.
+ */
+class PhysicsStore {
+public:
+	/**
+	 * @brief Makes sure that the store has a slot for the given MovableID.
+	 * @param id MovableID of the object that is about to use the slot
+	 */
+	void reserve(MovableID id);
+
+	/**
+	 * @brief Works out the movement step of every slot: velocity times velocity
+	 * multiplier plus tick velocity, with nausea applied to the horizontal
+	 * components.
+	 */
+	void integrate();
+
+	/**
+	 * @brief Returns the movement step of the given slot, as of the last call to
+	 * integrate(), or no movement if the slot didn't exist then.
+	 */
+	glm::vec3 getStep(MovableID id) const;
+
+	/**
+	 * @brief Returns the number of slots in the store.
+	 */
+	std::size_t size() const;
+
+	/*	Columns, indexed by MovableID	*/
+
+	glm::vec3& velocity(MovableID id) { return this->velocities[id]; }
+	glm::vec3& velocityMultiplier(MovableID id) { return this->multipliers[id]; }
+	glm::vec3& currTickVelocity(MovableID id) { return this->tick_velocities[id]; }
+	float& nauseous(MovableID id) { return this->nausea[id]; }
+
+private:
+	std::vector<glm::vec3> velocities;
+	std::vector<glm::vec3> multipliers;
+	std::vector<glm::vec3> tick_velocities;
+	std::vector<float> nausea;
+
+	/**
+	 * @brief Output of integrate(). Slots added since then have no step yet.
+	 */
+	std::vector<glm::vec3> steps;
+};
@@ -8,6 +8,8 @@
 
 class Player : public Creature {
 public:
+	USE_OBJECT_POOL(Player)
+
 	SharedPlayerInfo info;
 	SharedInventory sharedInventory;
 	SharedCompass compass;
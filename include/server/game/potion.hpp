@@ -16,6 +16,8 @@ enum class PotionType {
 
 class Potion : public Item {
 public:
+    USE_OBJECT_POOL(Potion)
+
     /**
      * @param corner     Corner position of the Potion
      * @param dimensions Dimensions applied for the Potion
@@ -88,6 +88,8 @@ private:
 
 class HomingFireball : public Projectile {
 public:
+    USE_OBJECT_POOL(HomingFireball)
+
     inline static const int DAMAGE = 15;
     inline static const float H_MULT = 0.4;
     inline static const float V_MULT = 0.1;
@@ -109,6 +111,8 @@ public:
  */
 class Arrow : public Projectile {
 public:
+    USE_OBJECT_POOL(Arrow)
+
     inline static const int DAMAGE = 10;
     inline static const float H_MULT = 0.55f;
     inline static const float V_MULT = 0.0f; // not affected by gravity
@@ -146,6 +150,8 @@ public:
 
 class SpellOrb : public Projectile {
 public:
+    USE_OBJECT_POOL(SpellOrb)
+
     inline static const int DAMAGE = 25;
     inline static const float H_MULT = 0.4;
     inline static const float V_MULT = 0.0;
@@ -5,6 +5,8 @@ using namespace std::chrono_literals;
 
 class Python : public Enemy {
 public:
+    USE_OBJECT_POOL(Python)
+
     inline static const float SIGHT_LIMIT_GRID_CELLS = 6.0f;
 
     Python(glm::vec3 corner, glm::vec3 facing);
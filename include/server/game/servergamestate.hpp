@@ -6,6 +6,8 @@
 #include "shared/game/sharedgamestate.hpp"
 #include "shared/utilities/config.hpp"
 #include "shared/utilities/smartvector.hpp"
+#include "shared/utilities/entityset.hpp"
+#include "shared/utilities/keyset.hpp"
 #include "shared/utilities/custom_hash.hpp"
 #include "server/audio/soundtable.hpp"
 #include "server/game/object.hpp"
@@ -77,9 +79,11 @@ public:
 	void markForDeletion(EntityID id);
 
 	/**
-	 * @brief mark an entity as updated
+	 * @brief mark an entity as updated, which also marks its cached
+	 * SharedObject as out of date (see Object::getShared())
 	 */
 	void markAsUpdated(EntityID id);
+	void markAsUpdated(Object* object);
 
 	//	TODO: Add specific update methods (E.g., updateMovement() to update
 	//	object movement)
@@ -94,7 +98,7 @@ public:
 	 * collision detection is performed
 	 * @note This method moves the object to the given position - i.e., it
 	 * updates the object's gridCellPositions vector and the ObjectManager's
-	 * cellToObjects unordered_map.
+	 * spatial grid.
 	 * @return true if the object overlaps (collides) with any other object that
 	 * has a collider at the given position, and false otherwise.
 	 */
@@ -152,12 +156,21 @@ public:
 	 * if you should just send the updated objects
 	 * 
 	 * NOTE: if send_all is false and you generate an update based on the diffs, this
-	 * function will clear the updated_entities unordered_set for you
+	 * function will clear the updated_entities set for you. Updated objects
+	 * whose SharedObject turns out not to have changed are left out.
 	 * 
-	 * @return vector of partial ShareGameState instances that represent different pieces
-	 * of the SharedGameState instance
+	 * The returned snapshot can be arbitrarily large, and is split up into packets
+	 * by packetizeSnapshot when it is sent.
+	 * 
+	 * @return SharedGameState containing either every object or just the updated objects
+	 */
+	SharedGameState generateSharedGameState(bool send_all);
+
+	/**
+	 * @brief Returns whether any object has been marked as updated since the
+	 * last partial update was generated (whether or not it actually changed).
 	 */
-	std::vector<SharedGameState> generateSharedGameState(bool send_all);
+	bool hasUpdatedEntities() const;
 
 	/* Audio Information */
 	SoundTable& soundTable();
@@ -271,7 +284,7 @@ private:
 	 * list of entities that have been changed, so we only have to include
 	 * these in partial updates to the clients 
 	 */
-	std::unordered_set<EntityID> updated_entities;
+	EntitySet updated_entities;
 
 	/**
 	 *  Current timestep (starts at 0)
@@ -330,17 +343,25 @@ private:
 	Grid grid;
 
 	/**
-	 * @brief Set of pairs of pointers to Objects that have collided in the
-	 * current timestep.
+	 * @brief Pairs of handles to Objects that have collided in the current
+	 * timestep, in the order they were first detected.
 	 * Maintained by hasObjectCollided() (which adds object pairs to it upon
-	 * collision detection) and updateMovement() (which clears it)
+	 * collision detection) and updateMovement() (which clears it). Kept as a
+	 * vector so that its memory is reused from tick to tick.
+	 */
+	std::vector<std::pair<ObjectHandle<Object>, ObjectHandle<Object>>> collidedObjects;
+
+	/**
+	 * @brief EntityIDs of each pair in collidedObjects packed into one key, so
+	 * that hasObjectCollided() only adds each pair once (an object checks for
+	 * collisions once per movement step).
 	 */
-	std::unordered_set<std::pair<Object*, Object*>, pair_hash> collidedObjects;
+	KeySet collidedPairs;
 
 	/**
 	 * @brief Field that stores the current trap the DM is hovering (not placed yet)
 	 */
-	Trap* currentGhostTrap;
+	ObjectHandle<Trap> currentGhostTrap;
 
 	/**
 	 * @brief Field that stores the lightning pos for cutting lights
@@ -5,6 +5,8 @@ using namespace std::chrono_literals;
 
 class Slime : public Enemy {
 public:
+    USE_OBJECT_POOL(Slime)
+
     inline static const float SIGHT_LIMIT_GRID_CELLS = 8.0f; // can see you within 8 grid cells
     int size;
 
@@ -4,6 +4,8 @@
 
 class SolidSurface : public Object {
 public:
+	USE_OBJECT_POOL(SolidSurface)
+
 	/**
 	 * @param movable Whether or not the surface is affected by velocity
 	 * @param collider Collision type for this object
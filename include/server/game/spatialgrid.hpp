@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <glm/glm.hpp>
+
+class Object;
+
+/**
+ * @brief Objects that overlap a single GridCell.
+ *
+ * Most cells only ever have a handful of objects in them, so the first few are
+ * kept inline and the bucket only goes to the heap past that. Removing an
+ * object swaps the last one into its place, so the order of the objects in a
+ * bucket is not kept.
+ */
+class CellBucket {
+public:
+	CellBucket();
+	~CellBucket();
+
+	//	data may point into the bucket itself, so it can't be copied or moved
+	CellBucket(const CellBucket&) = delete;
+	CellBucket& operator=(const CellBucket&) = delete;
+
+	/**
+	 * @brief Adds an object to the bucket.
+	 */
+	void push(Object* object);
+
+	/**
+	 * @brief Removes one occurrence of the given object from the bucket.
+	 * @return true if the object was in the bucket.
+	 */
+	bool remove(Object* object);
+
+	/**
+	 * @brief Empties the bucket, keeping any memory it has.
+	 */
+	void clear();
+
+	Object* const* begin() const { return this->data; }
+	Object* const* end() const { return this->data + this->count; }
+
+	std::size_t size() const { return this->count; }
+	bool empty() const { return this->count == 0; }
+
+private:
+	static constexpr uint32_t INLINE_CAPACITY = 4;
+
+	/// @brief Either local or an array on the heap
+	Object** data;
+	uint32_t count;
+	uint32_t capacity;
+	Object* local[INLINE_CAPACITY];
+};
+
+/**
+ * @brief Which objects overlap each GridCell of the maze, kept as a row-major
+ * array of CellBuckets so that finding a cell's bucket is a bounds check and
+ * an index.
+ *
+ * Cells outside of the maze (e.g. where held items are parked) all share one
+ * fallback bucket, so looking one of them up can also give objects from other
+ * out of bounds cells.
+ */
+class SpatialGrid {
+public:
+	SpatialGrid();
+
+	/**
+	 * @brief Sets the size of the maze, emptying every bucket.
+	 * @param columns Number of GridCells along the x axis
+	 * @param rows Number of GridCells along the z axis
+	 */
+	void resize(int columns, int rows);
+
+	/**
+	 * @brief Returns whether the given cell has a bucket of its own.
+	 */
+	bool inBounds(glm::ivec2 cell) const {
+		return cell.x >= 0 && cell.x < this->columns && cell.y >= 0 && cell.y < this->rows;
+	}
+
+	/**
+	 * @brief Returns the bucket of the given cell, or the fallback bucket if
+	 * the cell is out of bounds.
+	 */
+	CellBucket& at(glm::ivec2 cell) {
+		return this->inBounds(cell) ? this->cells[this->index(cell)] : this->fallback;
+	}
+
+	const CellBucket& at(glm::ivec2 cell) const {
+		return this->inBounds(cell) ? this->cells[this->index(cell)] : this->fallback;
+	}
+
+	/**
+	 * @brief Returns the bucket shared by every out of bounds cell.
+	 */
+	const CellBucket& outOfBounds() const {
+		return this->fallback;
+	}
+
+	int getColumns() const { return this->columns; }
+	int getRows() const { return this->rows; }
+
+private:
+	std::size_t index(glm::ivec2 cell) const {
+		return static_cast<std::size_t>(cell.y) * this->columns + cell.x;
+	}
+
+	int columns;
+	int rows;
+	std::unique_ptr<CellBucket[]> cells;
+	CellBucket fallback;
+};
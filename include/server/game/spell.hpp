@@ -15,6 +15,8 @@ enum class SpellType {
 
 class Spell : public Item {
 public:
+    USE_OBJECT_POOL(Spell)
+
 
     /**
      * @param corner     Corner position of the Spell
@@ -11,6 +11,8 @@
  */
 class SpikeTrap : public Trap {
 public:
+    USE_OBJECT_POOL(SpikeTrap)
+
     /**
      * @param corner Corner position of the spike trap
      * @param dimensions dimensions of the spike trap (probably will change once we use a non cube model to not have this)
@@ -11,6 +11,8 @@
  */
 class TeleporterTrap : public Trap {
 public:
+    USE_OBJECT_POOL(TeleporterTrap)
+
     /**
      * @param corner Corner position of the teleporter trap
      */
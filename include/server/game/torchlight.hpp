@@ -7,6 +7,8 @@
 
 class Torchlight : public Object {
 public:
+	USE_OBJECT_POOL(Torchlight)
+
 	/**
      * Creates a torchight with default lighting properties.
 	 * @param corner Corner position of the surface
@@ -17,6 +17,8 @@ enum class WeaponType {
 
 class Weapon : public Item {
 public:
+    USE_OBJECT_POOL(Weapon)
+
 
     /**
      * @param corner     Corner position of the weapon
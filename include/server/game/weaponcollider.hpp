@@ -1,4 +1,5 @@
 #include "server/game/object.hpp"
+#include "server/game/objecthandle.hpp"
 #include "server/game/constants.hpp"
 #include "server/game/player.hpp"
 #include "shared/audio/soundtype.hpp"
@@ -24,7 +25,7 @@ public:
         bool followPlayer;
     };
 
-    WeaponCollider(Player* usedPlayer, glm::vec3 corner, glm::vec3 facing, \
+    WeaponCollider(ObjectHandle<Player> usedPlayer, glm::vec3 corner, glm::vec3 facing, \
         glm::vec3 dimensions, ModelType model, WeaponOptions&& options);
 
     void doCollision(Object* other, ServerGameState& state) override;
@@ -36,7 +37,8 @@ public:
 protected:
     std::chrono::time_point<std::chrono::system_clock> preparing_time;
     std::chrono::time_point<std::chrono::system_clock> attacked_time;
-    Player* usedPlayer;
+    /// @brief Player who attacked, or unset for the DM's lightning
+    ObjectHandle<Player> usedPlayer;
     SharedWeaponInfo info;
     WeaponOptions opt;
     bool playSound;
@@ -44,9 +46,11 @@ protected:
 
 class ShortAttack : public WeaponCollider {
 public:
+    USE_OBJECT_POOL(ShortAttack)
+
     inline static const glm::vec3 DIMENSION = glm::vec3(1.0f, 5.0f, 1.0f);
 
-    ShortAttack(Player* usedPlayer, glm::vec3 corner, glm::vec3 facing):
+    ShortAttack(ObjectHandle<Player> usedPlayer, glm::vec3 corner, glm::vec3 facing):
         WeaponCollider(usedPlayer, corner, facing, DIMENSION, ModelType::Cube,
             WeaponOptions(DAGGER_DMG, DAGGER_PREP, DAGGER_DUR, true))
     {
@@ -56,9 +60,11 @@ public:
 
 class MediumAttack : public WeaponCollider {
 public:
+    USE_OBJECT_POOL(MediumAttack)
+
     inline static const glm::vec3 DIMENSION = glm::vec3(1.5f, 5.0f, 1.5f);
 
-    MediumAttack(Player* usedPlayer, glm::vec3 corner, glm::vec3 facing) :
+    MediumAttack(ObjectHandle<Player> usedPlayer, glm::vec3 corner, glm::vec3 facing) :
         WeaponCollider(usedPlayer, corner, facing, DIMENSION, ModelType::Cube,
             WeaponOptions(SWORD_DMG, SWORD_PREP, SWORD_DUR, true))
     {
@@ -68,9 +74,11 @@ public:
 
 class BigAttack : public WeaponCollider {
 public:
+    USE_OBJECT_POOL(BigAttack)
+
     inline static const glm::vec3 DIMENSION = glm::vec3(2.5f, 5.0f, 2.5f);
 
-    BigAttack(Player* usedPlayer, glm::vec3 corner, glm::vec3 facing) :
+    BigAttack(ObjectHandle<Player> usedPlayer, glm::vec3 corner, glm::vec3 facing) :
         WeaponCollider(usedPlayer, corner, facing, DIMENSION, ModelType::Cube,
             WeaponOptions(HAMMER_DMG, HAMMER_PREP, HAMMER_DUR, true))
     {
@@ -80,10 +88,12 @@ public:
 
 class Lightning : public WeaponCollider {
 public:
+    USE_OBJECT_POOL(Lightning)
+
     inline static const glm::vec3 DIMENSION = glm::vec3(3.0f, 100.0f, 3.0f);
 
     Lightning(glm::vec3 corner, glm::vec3 facing, const PointLightProperties& properties) :
-        WeaponCollider(nullptr, corner, facing, DIMENSION, ModelType::Lightning,
+        WeaponCollider(ObjectHandle<Player>(), corner, facing, DIMENSION, ModelType::Lightning,
             WeaponOptions(LIGHTNING_DMG, LIGHTNING_PREP, LIGHTNING_DUR, false)),
         properties(properties)
     {
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "shared/game/event.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+/// Represents a list of events from a certain client with a specified ID
+using EventList = std::vector<std::pair<EntityID, Event>>;
+
+/**
+ * Counters describing the work done by coalesceInputs during a single tick
+ */
+struct InputCoalescingStats {
+    /// @brief Number of events received from clients
+    std::size_t events_received = 0;
+    /// @brief Number of those events that were merged into another event or dropped
+    std::size_t events_collapsed = 0;
+};
+
+/**
+ * Collapses the input events clients send every frame down to what actually matters
+ * for a single tick, before they are applied by ServerGameState::update.
+ *
+ * Per client, between any two events that change game state in a way that depends
+ * on order (using, dropping or selecting items, placing traps, stopping actions, ...):
+ * - Only the latest ChangeFacing is kept.
+ * - Only the latest trap hover TrapPlacement is kept.
+ * - Only the latest MoveCam StartAction is kept.
+ * - Only the first Jump StartAction is kept, since the rest would be ignored anyway.
+ * - Zoom StartActions are merged into one that zooms by the total amount.
+ *
+ * Every other event is passed through untouched and in its original order, and the
+ * kept events stay in the same order relative to them.
+ *
+ * @param events Events received from every client this tick, in the order received
+ * @param stats Counters to add this call's work to
+ * @returns Events to apply this tick
+ */
+EventList coalesceInputs(const EventList& events, InputCoalescingStats& stats);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <unordered_set>
+
+#include <glm/glm.hpp>
+
+#include "server/game/objectmanager.hpp"
+#include "shared/game/sharedgamestate.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+/**
+ * Keeps track of which objects a single client currently knows about, and filters
+ * SharedGameState updates down to the objects that are relevant to that client.
+ *
+ * For players, an object is relevant if any GridCell it occupies is within a square
+ * radius of the GridCell the player is standing in, or if it is one of the few objects
+ * every client needs no matter where it is (players, the Dungeon Master, exits and the
+ * orb). Objects that become relevant are spawned by sending their full current state,
+ * and objects that stop being relevant are despawned by sending boost::none, exactly as
+ * if they had been created or deleted.
+ *
+ * The Dungeon Master sees the whole map, so for it every object is relevant.
+ */
+class InterestManager {
+public:
+    InterestManager();
+
+    /**
+     * Converts an update containing every changed object into the update that should be
+     * sent to this client.
+     *
+     * - Changed objects are only kept if they are relevant to the client.
+     * - Objects that became relevant since the last update are added, even if unchanged.
+     * - Objects the client knows about that are no longer relevant, or were deleted,
+     *   are sent as boost::none.
+     *
+     * Relevance of unchanged objects only has to be rechecked when the viewer moves to a
+     * different GridCell, so most calls only look at the objects in the update.
+     *
+     * @param update Update generated by ServerGameState::generateSharedGameState
+     * @param objects ObjectManager the update was generated from
+     * @param viewer EntityID of the client's player / Dungeon Master object
+     * @param full_map Whether the client gets to see the whole map (e.g. the Dungeon Master)
+     * @param radius Radius in GridCells around the viewer that is relevant. If not
+     * positive, the whole map is relevant
+     * @returns Update to send to this client
+     */
+    SharedGameState filter(const SharedGameState& update, ObjectManager& objects,
+        EntityID viewer, bool full_map, int radius);
+
+    /**
+     * Forgets which objects the client knows about. Should be called whenever the client
+     * is about to be sent state that didn't go through this filter.
+     */
+    void reset();
+
+    /**
+     * @returns Number of objects the client currently knows about. Meaningless once the
+     * client has been switched over to seeing the whole map
+     */
+    std::size_t numKnown() const;
+
+    /**
+     * @returns Whether the client is currently being sent the whole map
+     */
+    bool isFullMap() const;
+
+    /**
+     * @param object Object to check
+     * @returns Whether every client needs to know about the object, no matter how far away it is
+     */
+    static bool isAlwaysRelevant(const Object* object);
+
+private:
+    /**
+     * @returns Whether the object is within radius GridCells of center, or always relevant
+     */
+    static bool _isRelevant(const Object* object, glm::ivec2 center, int radius);
+
+    /**
+     * Sends the client every object it doesn't know about yet. Used when switching a
+     * client over to seeing the whole map.
+     */
+    void _spawnEverything(SharedGameState& result, ObjectManager& objects);
+
+    /**
+     * Adds every object in range of center that the client doesn't know about to the
+     * result, and removes every object the client knows about that is out of range.
+     */
+    void _rescan(SharedGameState& result, ObjectManager& objects, glm::ivec2 center, int radius);
+
+    /// @brief Ids of every object the client currently has
+    std::unordered_set<EntityID> known;
+
+    /// @brief Whether the client has been sent the whole map, after which nothing is filtered
+    bool full_map;
+
+    /// @brief Whether last_center holds the viewer's GridCell from the previous call
+    bool has_center;
+
+    /// @brief GridCell the viewer was in during the previous call
+    glm::ivec2 last_center;
+};
@@ -5,21 +5,70 @@
 
 #include <thread>
 #include <atomic>
+#include <map>
 #include <unordered_map>
 #include <memory>
 #include <chrono>
+#include <deque>
+#include <optional>
+#include <vector>
 
 #include "server/lobbybroadcaster.hpp"
+#include "server/snapshottracker.hpp"
+#include "server/interestmanager.hpp"
+#include "server/inputcoalescer.hpp"
 #include "server/game/introcutscene.hpp"
 #include "shared/network/session.hpp"
+#include "shared/network/snapshotchannel.hpp"
+#include "shared/network/telemetry.hpp"
 #include "shared/utilities/config.hpp"
 #include "shared/utilities/typedefs.hpp"
 #include "server/game/servergamestate.hpp"
 
 using boost::asio::ip::tcp;
 
-/// Represents a list of events from a certain client with a specified ID
-using EventList = std::vector<std::pair<EntityID, Event>>;
+/**
+ * Counters describing the work done by sendUpdateToAllClients during a single tick.
+ * Each broadcast event is serialized exactly once, so packets_serialized should stay
+ * at the number of distinct broadcasts regardless of how many clients are connected,
+ * while packets_sent grows with the number of clients.
+ */
+struct BroadcastStats {
+    /// @brief Number of distinct packets that were serialized for broadcasting
+    std::size_t packets_serialized = 0;
+    /// @brief Number of packets handed to sessions (packets_serialized * clients)
+    std::size_t packets_sent = 0;
+    /// @brief Number of bytes that were serialized, counting each packet once
+    std::size_t bytes_serialized = 0;
+    /// @brief Number of bytes handed to sessions, counting each copy sent
+    std::size_t bytes_sent = 0;
+    /// @brief Total time spent serializing broadcast packets
+    std::chrono::nanoseconds serialize_time {0};
+    /// @brief Number of snapshots held back from clients whose send queue was backed up
+    std::size_t snapshots_deferred = 0;
+    /// @brief Number of objects put in snapshots after filtering by relevance, summed over clients
+    std::size_t objects_sent = 0;
+};
+
+/**
+ * The most recent InputFrame from a client whose events have been applied to the game state
+ */
+struct ProcessedInputFrame {
+    /// @brief Sequence number and client timestamp of the frame
+    InputFrameInfo frame;
+    /// @brief ServerGameState timestep during which the frame's events were applied
+    unsigned int timestep;
+};
+
+/**
+ * A full state resync that is still being sent to a client, see Server::_startResync
+ */
+struct PendingResync {
+    /// @brief Chunks of the resync that haven't been sent yet, in order
+    std::deque<SharedGameState> chunks;
+    /// @brief Packets to send once every chunk has been sent
+    std::vector<std::shared_ptr<PackagedPacket>> then_send;
+};
 
 class Server {
 public:
@@ -38,7 +87,64 @@ public:
 
     void updateGameState(const EventList& events);
 
-    void sendUpdateToAllClients(Event event);
+    /**
+     * Serializes the event once and sends the resulting packet to every connected client.
+     *
+     * @param event Event to broadcast
+     */
+    void sendUpdateToAllClients(const Event& event);
+
+    /**
+     * Sends a SharedGameState update to every connected client. Each client gets
+     * its own encoding of the update, containing only the objects relevant to that
+     * client, and only what changed relative to the last snapshot that client acknowledged.
+     *
+     * @param update Snapshot generated by ServerGameState::generateSharedGameState
+     */
+    void sendSnapshotToAllClients(const SharedGameState& update);
+
+    /**
+     * @returns Broadcast counters from the most recently completed tick
+     */
+    const BroadcastStats& getLastTickBroadcastStats() const;
+
+    /**
+     * @returns Input coalescing counters from the most recently completed tick
+     */
+    const InputCoalescingStats& getLastTickInputStats() const;
+
+    /**
+     * @returns Network telemetry from the most recently completed tick, added up over every
+     * session. This includes snapshots sent over UDP, and the time spent serializing
+     * packets that went to more than one session
+     */
+    const NetworkTelemetry& getLastTickTelemetry() const;
+
+    /**
+     * @param client EntityID of the client to check
+     * @returns The most recent InputFrame from the client that has been applied to the
+     * game state, or nullopt if none have been
+     */
+    std::optional<ProcessedInputFrame> getLastProcessedInput(EntityID client) const;
+
+    /**
+     * @param client EntityID of the client to check
+     * @returns Whether the client is still being sent the full state, during which it
+     * isn't sent any snapshots
+     */
+    bool isResyncing(EntityID client) const;
+
+    /**
+     * @returns Port the server is accepting connections on, which is useful when
+     * config.port is 0 and the operating system picked it
+     */
+    unsigned short getPort() const;
+
+    /**
+     * @returns Timestep of the game state, which is what the snapshot sent at the end of
+     * the last doTick was stamped with
+     */
+    unsigned int getTimestep() const;
 
     void sendLightSourceUpdates(EntityID playerID);
 
@@ -71,9 +177,61 @@ private:
      */
     std::shared_ptr<Session> _handleNewSession(boost::asio::ip::address addr);
 
+    /**
+     * Starts sending a client everything it can see, which it swaps over to once all of
+     * it has arrived. Only objects that exist are sent, split up into
+     * SNAPSHOT_DATAGRAM_BYTES sized chunks, and every chunk is only serialized once
+     * _sendResyncs gets to it. Until then, the client's snapshots are deferred.
+     *
+     * @param client EntityID of the client that (re)connected
+     * @param is_dm Whether the client is the Dungeon Master
+     * @param then_send Packets to send once the whole resync has been sent
+     */
+    void _startResync(EntityID client, bool is_dm, std::vector<std::shared_ptr<PackagedPacket>> then_send);
+
+    /**
+     * Sends each client that is being resynced its next RESYNC_BYTES_PER_TICK worth of
+     * chunks, unless its session is backed up
+     */
+    void _sendResyncs();
+
+    /**
+     * @returns UDP port of snapshot_channel to tell clients about, or 0 if there isn't one
+     */
+    uint16_t _getSnapshotPort() const;
+
+    /**
+     * Takes the telemetry from every session for the tick that just finished, and writes
+     * it out every config.server.telemetry.interval_ticks ticks
+     */
+    void _collectTelemetry();
+
+    /**
+     * Writes out the telemetry added up since it was last written, as a line of JSON
+     */
+    void _writeTelemetry();
+
     /// @brief Mapping from either player id or ip to session
     Sessions sessions;
 
+    /// @brief What each client has acknowledged of the game state, by client EntityID
+    std::unordered_map<EntityID, SnapshotTracker> snapshot_trackers;
+
+    /// @brief Unreliable channel that snapshots are sent over, if config.server.udp_snapshots
+    std::shared_ptr<SnapshotChannel> snapshot_channel;
+
+    /// @brief Which objects each client knows about, by client EntityID
+    std::unordered_map<EntityID, InterestManager> interest_managers;
+
+    /// @brief Full state resyncs that haven't been completely sent yet, by client EntityID
+    std::unordered_map<EntityID, PendingResync> resyncs;
+
+    /// @brief resync_id to give the next resync
+    uint32_t next_resync_id = 1;
+
+    /// @brief Most recent InputFrame applied from each client, by client EntityID
+    std::unordered_map<EntityID, ProcessedInputFrame> processed_inputs;
+
     /// @brief Master copy of the ServerGameState, living on the server
     ServerGameState state;
 
@@ -82,4 +240,31 @@ private:
 
     /// @brief game state used to render the intro cutscene
     IntroCutscene intro_cutscene;
+
+    /// @brief Broadcast counters for the tick currently being processed
+    BroadcastStats curr_tick_broadcast_stats;
+
+    /// @brief Broadcast counters for the last tick that finished
+    BroadcastStats last_tick_broadcast_stats;
+
+    /// @brief Input coalescing counters for the tick currently being processed
+    InputCoalescingStats curr_tick_input_stats;
+
+    /// @brief Input coalescing counters for the last tick that finished
+    InputCoalescingStats last_tick_input_stats;
+
+    /// @brief Snapshots sent over snapshot_channel during the current tick, by client EntityID
+    std::unordered_map<EntityID, NetworkTelemetry> datagram_telemetry;
+
+    /// @brief Telemetry for the last tick that finished, added up over every session
+    NetworkTelemetry last_tick_telemetry;
+
+    /// @brief Telemetry since it was last written out, by client EntityID
+    std::map<EntityID, NetworkTelemetry> interval_telemetry;
+
+    /// @brief Telemetry since it was last written out, added up over every session
+    NetworkTelemetry interval_total_telemetry;
+
+    /// @brief Number of ticks since telemetry was last written out
+    int interval_ticks = 0;
 };
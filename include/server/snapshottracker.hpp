@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "shared/game/sharedgamestate.hpp"
+#include "shared/game/sharedobject.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+/**
+ * Keeps track of what a single client knows about the game state, so that
+ * SharedGameState updates sent to that client only contain the fields that
+ * actually changed.
+ *
+ * Every update that goes through encode() is given a snapshot id. Once the client
+ * acknowledges a snapshot id, everything sent up to and including that snapshot
+ * becomes the baseline that future deltas are computed against. Fields that were
+ * sent in snapshots that haven't been acknowledged yet are always resent, so the
+ * client ends up with the correct value no matter which of those snapshots it has
+ * already applied.
+ */
+class SnapshotTracker {
+public:
+    SnapshotTracker();
+
+    /**
+     * Converts a SharedGameState update containing full objects into the smallest
+     * update that brings this client up to date.
+     *
+     * - Objects the client has no acknowledged copy of are sent in full.
+     * - Objects the client has are sent as a SharedObjectDelta containing only
+     *   the fields that differ from the baseline (or were sent in an unacknowledged
+     *   snapshot).
+     * - Objects with no such fields are left out of the update entirely.
+     * - Deleted objects (boost::none) are always sent.
+     *
+     * @param update Update generated by ServerGameState::generateSharedGameState
+     * @returns Update to send to this client, with snapshot_id set
+     */
+    SharedGameState encode(const SharedGameState& update);
+
+    /**
+     * Marks every snapshot up to and including snapshot_id as received by the client.
+     *
+     * @param snapshot_id Id of the most recent snapshot the client has applied
+     */
+    void acknowledge(uint32_t snapshot_id);
+
+    /**
+     * Records that an update was not sent to this client at all (e.g. because the client
+     * is falling behind), so the objects in it have to be included in a later update.
+     *
+     * @param update Update that was skipped
+     */
+    void defer(const SharedGameState& update);
+
+    /**
+     * Takes the ids of every object that was in a deferred update and hasn't been sent
+     * since. The caller is responsible for adding the current state of these objects
+     * to the next update passed to encode().
+     *
+     * @returns Ids of objects that have to be sent, which is cleared by this call
+     */
+    std::unordered_set<EntityID> takeDeferred();
+
+    /**
+     * Forgets the baseline, all unacknowledged snapshots and all deferred objects, so every
+     * object is sent in full again. Should be called whenever the client receives state that didn't
+     * go through this tracker, e.g. the full game state sent on (re)connection.
+     */
+    void reset();
+
+    /**
+     * Sets whether snapshots are sent over a channel that guarantees delivery (the TCP
+     * Session) or one that doesn't (the UDP SnapshotChannel). Over an unreliable channel
+     * every snapshot also repeats everything in the snapshots that haven't been
+     * acknowledged yet, so a client that only receives the newest snapshot still ends up
+     * with the full state, and acknowledging it acknowledges everything before it.
+     *
+     * @param reliable Whether every snapshot is guaranteed to arrive, in order. Defaults to true
+     */
+    void setReliable(bool reliable);
+
+    /**
+     * @returns Number of snapshots that have been sent but not acknowledged
+     */
+    std::size_t numUnacknowledged() const;
+
+private:
+    /**
+     * A snapshot that was sent to the client, but not acknowledged yet
+     */
+    struct PendingSnapshot {
+        uint32_t id;
+        /// @brief Full state of every object included in the snapshot
+        std::unordered_map<EntityID, boost::optional<SharedObject>> objects;
+        /// @brief Fields of each object that were actually sent in the snapshot
+        std::unordered_map<EntityID, SharedObjectFieldMask> sent_fields;
+    };
+
+    /**
+     * Adds whatever the client needs to know about a single object to the encoded update,
+     * and records it in the snapshot.
+     */
+    void _encodeObject(EntityID id, const boost::optional<SharedObject>& obj,
+        SharedGameState& encoded, PendingSnapshot& snapshot);
+
+    /**
+     * @param id Object to check
+     * @returns Every field of the object that was sent in an unacknowledged snapshot
+     */
+    SharedObjectFieldMask _unacknowledgedFields(EntityID id) const;
+
+    /// @brief Id to assign to the next snapshot. 0 is reserved for untracked updates
+    uint32_t next_snapshot_id;
+
+    /// @brief Last state of each object that the client has acknowledged
+    std::unordered_map<EntityID, SharedObject> baseline;
+
+    /// @brief Snapshots sent to the client that haven't been acknowledged, oldest first
+    std::deque<PendingSnapshot> pending;
+
+    /// @brief Objects from deferred updates that haven't been sent since
+    std::unordered_set<EntityID> deferred;
+
+    /// @brief Whether snapshots are guaranteed to arrive, see setReliable
+    bool reliable;
+};
@@ -5,6 +5,22 @@
 #define TIMESTEP_LEN			std::chrono::milliseconds(30)
 #define	MAX_PLAYERS				4
 
+/*	Movement (see shared/game/movement.hpp)	*/
+#define	GRAVITY					0.03f
+#define	PLAYER_SPEED 			1.65f
+#define JUMP_SPEED				0.59f
+#define SPRINT_MULTIPLIER		glm::vec3(1.5f, 1.1f, 1.5f)
+
+/*	Client side movement prediction (see MovementPredictor)	*/
+//	Width of the cells the static colliders are bucketed into
+#define PREDICTION_CELL_WIDTH		3.0f
+//	Number of predicted ticks to keep around for replaying
+#define PREDICTION_MAX_HISTORY		128
+//	Corrections bigger than this are snapped to instead of smoothed out
+#define PREDICTION_SNAP_DISTANCE	5.0f
+//	Fraction of the remaining correction to keep after every tick
+#define PREDICTION_CORRECTION_DECAY	0.8f
+
 /*	Game phase information	*/
 //	Time limit initially set to 5 minutes
 #define	TIME_LIMIT_S std::chrono::seconds(300)
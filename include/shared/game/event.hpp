@@ -1,7 +1,18 @@
 #pragma once
 
-#include <boost/variant/variant.hpp>
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/tracking.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 #include "shared/utilities/typedefs.hpp"
 #include "shared/utilities/serialize.hpp"
@@ -10,6 +21,7 @@
 #include "shared/game/celltype.hpp"
 #include "shared/audio/soundcommand.hpp"
 #include "shared/utilities/constants.hpp"
+#include "shared/network/constants.hpp"
 
 
 /****************************************************
@@ -20,13 +32,14 @@
  * 2. Make sure you define two constructors: one "dummy" default constructor which
  *    does nothing, and one constructor to actually make the Events. The dummy constructor
  *    is needed to make everything compile.
- * 3. Make sure you add the new struct you make to the EventData boost::variant typedef
- *    further down.
+ * 3. Make sure you add the new struct you make to the EventData std::variant typedef
+ *    further down, in the same position as its EventType, and REGISTER_EVENT it.
  *
  ***************************************************/
 
  /**
-  * Tag for the different kind of events there are
+  * Tag for the different kind of events there are. This is what identifies an event
+  * on the wire, so new ones should be added at the end
   */
 enum class EventType {
     ChangeFacing,
@@ -44,6 +57,8 @@ enum class EventType {
     UpdateLightSources,
     TrapPlacement,
     LoadIntroCutscene,
+    AckSnapshot,
+    ReconcileMovement,
 };
 
 enum class ActionType {
@@ -320,11 +335,56 @@ struct LoadIntroCutsceneEvent {
     }
 };
 
+/**
+ * Event sent by a client to the server, acknowledging that it has applied every
+ * SharedGameState update up to and including the given snapshot id
+ */
+struct AckSnapshotEvent {
+    AckSnapshotEvent() {}
+    explicit AckSnapshotEvent(uint32_t snapshot_id) : snapshot_id(snapshot_id) {}
+
+    uint32_t snapshot_id;
+
+    DEF_SERIALIZE(Archive& ar, const unsigned int version) {
+        ar & snapshot_id;
+    }
+};
+
+/**
+ * Event sent by the server to a client after every tick, saying where the client's own
+ * player ended up and which of its inputs had been applied by then, so that the client
+ * can correct its prediction of where it is (see MovementPredictor)
+ */
+struct ReconcileMovementEvent {
+    ReconcileMovementEvent() {}
+    ReconcileMovementEvent(uint32_t input_sequence, glm::vec3 corner, glm::vec3 velocity,
+        glm::vec3 velocity_multiplier):
+        input_sequence(input_sequence), corner(corner), velocity(velocity),
+        velocity_multiplier(velocity_multiplier) {}
+
+    /// @brief Sequence number of the last InputFrame applied before the tick
+    uint32_t input_sequence;
+    /// @brief Where the player's corner was at the end of the tick
+    glm::vec3 corner;
+    /// @brief Velocity of the player at the end of the tick
+    glm::vec3 velocity;
+    /// @brief Velocity multiplier of the player at the end of the tick
+    glm::vec3 velocity_multiplier;
+
+    DEF_SERIALIZE(Archive& ar, const unsigned int version) {
+        ar & input_sequence & corner & velocity & velocity_multiplier;
+    }
+};
+
 /**
  * All of the different kinds of events in a tagged union, so we can
- * easily pull out the actual data for a specific Event
+ * easily pull out the actual data for a specific Event.
+ *
+ * The index of every struct in here is its EventType, which is also what identifies it
+ * on the wire, so they have to be in the same order as EventType (which is checked by
+ * REGISTER_EVENT below).
  */
-using EventData = boost::variant<
+using EventData = std::variant<
     ChangeFacingEvent,
     LobbyActionEvent,
     LoadGameStateEvent,
@@ -336,35 +396,189 @@ using EventData = boost::variant<
     SpawnEntityEvent,
     SelectItemEvent,
     UseItemEvent,
-    UpdateLightSourcesEvent,
     DropItemEvent,
+    UpdateLightSourcesEvent,
     TrapPlacementEvent,
-    LoadIntroCutsceneEvent
+    LoadIntroCutsceneEvent,
+    AckSnapshotEvent,
+    ReconcileMovementEvent
 >;
 
+/**
+ * @returns The EventType that goes with the event data struct T, i.e. its index in EventData
+ */
+template <typename T, std::size_t I = 0>
+constexpr EventType eventTypeOf() {
+    if constexpr (I < std::variant_size_v<EventData>) {
+        if constexpr (std::is_same_v<T, std::variant_alternative_t<I, EventData>>) {
+            return static_cast<EventType>(I);
+        } else {
+            return eventTypeOf<T, I + 1>();
+        }
+    } else {
+        static_assert(I < std::variant_size_v<EventData>, "Not one of the EventData structs");
+        return EventType::ChangeFacing;
+    }
+}
+
+/**
+ * @returns Whether this build knows what data goes with the event type. Events received
+ * from a newer build can have types that don't
+ */
+constexpr bool isKnownEventType(EventType type) {
+    return static_cast<std::size_t>(type) < std::variant_size_v<EventData>;
+}
+
+/**
+ * Makes sure the event data struct for an EventType is where it should be in EventData,
+ * and serializes it without any boost class information (the EventType already says
+ * what it is, and none of them are versioned)
+ */
+#define REGISTER_EVENT(type) \
+    static_assert(eventTypeOf<type##Event>() == EventType::type, \
+        #type "Event has to be in the same place in EventData as in EventType"); \
+    BOOST_CLASS_IMPLEMENTATION(type##Event, boost::serialization::object_serializable) \
+    BOOST_CLASS_TRACKING(type##Event, boost::serialization::track_never)
+
+REGISTER_EVENT(ChangeFacing)
+REGISTER_EVENT(LobbyAction)
+REGISTER_EVENT(LoadGameState)
+REGISTER_EVENT(LoadSoundCommands)
+REGISTER_EVENT(StartAction)
+REGISTER_EVENT(StopAction)
+REGISTER_EVENT(MoveRelative)
+REGISTER_EVENT(MoveAbsolute)
+REGISTER_EVENT(SpawnEntity)
+REGISTER_EVENT(SelectItem)
+REGISTER_EVENT(UseItem)
+REGISTER_EVENT(DropItem)
+REGISTER_EVENT(UpdateLightSources)
+REGISTER_EVENT(TrapPlacement)
+REGISTER_EVENT(LoadIntroCutscene)
+REGISTER_EVENT(AckSnapshot)
+REGISTER_EVENT(ReconcileMovement)
+
+#undef REGISTER_EVENT
+
+/**
+ * Decodes the event data struct at index I of EventData, straight into the variant
+ */
+template <std::size_t I>
+void decodeEventData(std::streambuf& encoded, WireFormat format, EventData& data) {
+    deserializeInto(encoded, data.template emplace<I>(), format);
+}
+
+/**
+ * @returns Table of decodeEventData for every EventData struct, indexed by EventType
+ */
+template <std::size_t... Is>
+constexpr auto makeEventDecodeTable(std::index_sequence<Is...>) {
+    return std::array<void (*)(std::streambuf&, WireFormat, EventData&), sizeof...(Is)> {
+        &decodeEventData<Is>... };
+}
+
 /**
  * Struct to represent any possible event that could happen in our game.
  */
 struct Event {
     Event() {}
-    Event(EntityID evt_source, EventType type, EventData data)
-        :evt_source(evt_source), type(type), data(data) {}
+    Event(EntityID evt_source, EventType type, EventData data);
 
     /// @brief who is attempting to trigger this event (if client -> server) or who is
     /// triggering this event (if server -> client)
     EntityID evt_source;
-    /// @brief The type of event. This actually might not be needed because I think boost::variant
-    /// has a tag built in, but We're already using it everywhere...
+    /// @brief The type of event, which is always the index of data. This is the only
+    /// tag that is sent over the network
     EventType type;
     /// @brief All of the different kinds of event data that you might have. Depending on
     /// the value of type, you should look at the data associated with that type of event.
+    /// If isKnownEventType(type) is false, it doesn't hold anything meaningful
     EventData data;
 
-    DEF_SERIALIZE(Archive& ar, const unsigned int version) {
-        ar& evt_source& type& data;
+    /**
+     * Writes the source, the type as a single byte, and the length of the event data
+     * followed by the event data itself, without any boost::variant bookkeeping.
+     *
+     * The event data is encoded by an archive of its own, so that it doesn't depend on
+     * what else was written to ar before it (boost only writes the class information
+     * of a type the first time it comes up in an archive). That way its length can be
+     * worked out up front, and skipping it doesn't throw off how later events are read.
+     * For binary archives the nested archive writes straight to ar's streambuf.
+     */
+    template <class Archive>
+    void save(Archive& ar, const unsigned int version) const {
+        uint8_t tag = static_cast<uint8_t>(this->data.index());
+
+        if constexpr (ArchiveWireFormat<Archive>::value == WireFormat::Binary) {
+            uint32_t length = static_cast<uint32_t>(std::visit([](const auto& event_data) {
+                SerializedSizeCounter counter;
+                return counter.add(event_data);
+            }, this->data));
+            ar & evt_source & tag & length;
+
+            PortableBinaryOArchive nested(ar.getStreambuf());
+            std::visit([&nested](const auto& event_data) { nested << event_data; }, this->data);
+        } else {
+            // text archives write binary data as base64, so the event data has to be
+            // encoded before it can be written
+            std::string encoded = std::visit([](const auto& event_data) {
+                return ::serialize(event_data, ArchiveWireFormat<Archive>::value);
+            }, this->data);
+            uint32_t length = static_cast<uint32_t>(encoded.size());
+
+            ar & evt_source & tag & length;
+            ar.save_binary(encoded.data(), length);
+        }
     }
+
+    /**
+     * Reads what save wrote. If the type isn't one this build knows, its event data is
+     * skipped over, and whatever comes after it in the archive can still be read
+     */
+    template <class Archive>
+    void load(Archive& ar, const unsigned int version) {
+        static constexpr auto DECODE = makeEventDecodeTable(
+            std::make_index_sequence<std::variant_size_v<EventData>>());
+
+        uint8_t tag;
+        uint32_t length;
+        ar & evt_source & tag & length;
+        // an event can't be bigger than the packet it came in
+        if (length > MAX_PACKET_BYTES) {
+            throw boost::archive::archive_exception(boost::archive::archive_exception::input_stream_error);
+        }
+
+        this->type = static_cast<EventType>(tag);
+
+        if constexpr (ArchiveWireFormat<Archive>::value == WireFormat::Binary) {
+            // decode straight out of ar's streambuf, but no further than the event data
+            BoundedStreambuf encoded(ar.getStreambuf(), length);
+            if (isKnownEventType(this->type)) {
+                DECODE[tag](encoded, WireFormat::Binary, this->data);
+                if (encoded.getRemaining() != 0) {
+                    throw boost::archive::archive_exception(boost::archive::archive_exception::input_stream_error,
+                        "event data shorter than its length");
+                }
+            } else if (!encoded.skipRemaining()) {
+                throw boost::archive::archive_exception(boost::archive::archive_exception::input_stream_error);
+            }
+        } else {
+            std::string encoded(length, '\0');
+            ar.load_binary(encoded.data(), length);
+
+            if (isKnownEventType(this->type)) {
+                SpanStreambuf buffer(encoded);
+                DECODE[tag](buffer, ArchiveWireFormat<Archive>::value, this->data);
+            }
+        }
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
 
+BOOST_CLASS_IMPLEMENTATION(Event, boost::serialization::object_serializable)
+BOOST_CLASS_TRACKING(Event, boost::serialization::track_never)
+
 /**
  * Allow us to std::cout an Event
  *
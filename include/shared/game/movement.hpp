@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+
+#include <glm/glm.hpp>
+
+#include "shared/game/constants.hpp"
+
+/**
+ * Movement and collision code shared by the server, which simulates every object, and
+ * the client, which runs the same steps ahead of the server to predict where its own
+ * player is going to be (see MovementPredictor).
+ *
+ * Everything here works on plain positions and velocities, so that neither side needs
+ * the other's object representation.
+ */
+
+/**
+ * @brief Velocity of a player moving in the given direction (a MoveCam action). Only the
+ * horizontal components change, so jumping and falling carry on.
+ * @param velocity Current velocity
+ * @param movement Direction of movement, from the StartActionEvent
+ * @return New velocity
+ */
+glm::vec3 moveCamVelocity(glm::vec3 velocity, glm::vec3 movement);
+
+/**
+ * @brief Starts a jump (a Jump action), if the object is standing on something.
+ * @param velocity Velocity to add the jump to
+ * @param movement Direction of the jump, from the StartActionEvent
+ * @param feels_gravity Whether the object is affected by gravity; objects that
+ * aren't can't jump
+ * @return true if the jump started, false if the object is already in the air
+ */
+bool startJump(glm::vec3& velocity, glm::vec3 movement, bool feels_gravity);
+
+/**
+ * @brief Moves an object by a whole tick's movement, stopping it at anything it
+ * collides with along the way.
+ *
+ * Fast movement is split into smaller steps so that it can't skip through thin walls,
+ * and when a step collides the object slides along whichever axis is still free.
+ *
+ * @param corner Where the object's corner starts
+ * @param total_step How far the object would move this tick if nothing was in the way
+ * @param collides Returns whether the object collides with something when its corner
+ * is at the given position
+ * @param move Moves the object's corner to the given position, after each step
+ * @return Where the object's corner ended up
+ */
+glm::vec3 moveWithCollisions(glm::vec3 corner, glm::vec3 total_step,
+	const std::function<bool(glm::vec3)>& collides,
+	const std::function<void(glm::vec3)>& move);
+
+/**
+ * @brief Stops an object from falling through the floor.
+ * @param corner Corner of the object, which is moved up to the floor if it is below it
+ * @return true if the object was below the floor
+ */
+bool clampToFloor(glm::vec3& corner);
+
+/**
+ * @brief Updates an object's vertical velocity for gravity, after it has moved.
+ * @param velocity Velocity of the object
+ * @param corner_y Height of the object's corner
+ * @param feels_gravity Whether the object is affected by gravity
+ */
+void updateGravity(glm::vec3& velocity, float corner_y, bool feels_gravity);
+
+/**
+ * @brief Detects whether two axis aligned boxes overlap, including just touching.
+ * @return true if the boxes overlap
+ */
+bool boxesOverlap(glm::vec3 corner1, glm::vec3 dimensions1,
+	glm::vec3 corner2, glm::vec3 dimensions2);
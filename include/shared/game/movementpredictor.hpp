@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include "shared/game/constants.hpp"
+#include "shared/game/event.hpp"
+#include "shared/game/sharedgamestate.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+/**
+ * Counters describing how well MovementPredictor is doing
+ */
+struct MovementPredictionStats {
+	/// @brief Number of ticks predicted
+	std::size_t ticks_predicted = 0;
+	/// @brief Number of ticks simulated again after a correction from the server
+	std::size_t ticks_replayed = 0;
+	/// @brief Number of times the server disagreed with the prediction
+	std::size_t corrections = 0;
+	/// @brief How far off the prediction was at the last reconciliation
+	float last_error = 0.0f;
+};
+
+/**
+ * Predicts where the client's own player is going to be, so that it can move as soon
+ * as a key is pressed instead of a round trip later.
+ *
+ * Every tick the predictor runs the same movement code the server does (see
+ * shared/game/movement.hpp) against the walls the client knows about, with whatever
+ * input the client has sent, and remembers which InputFrame was the last one sent
+ * before it. When the server says where the player really is and which InputFrame it
+ * had applied by then, the predictor starts again from there and replays every tick
+ * the server hasn't seen the input for yet. Any difference from the old prediction is
+ * smoothed out over the next few ticks instead of jumping.
+ *
+ * Things the client can't know ahead of time, like being knocked back or slowed by a
+ * status, are left to the server and get corrected for.
+ */
+class MovementPredictor {
+public:
+	MovementPredictor();
+
+	/**
+	 * @brief Rebuilds the colliders the player can bump into from the walls in the
+	 * given state. Should be called whenever walls are added or removed.
+	 */
+	void setStaticColliders(const SharedGameState& state);
+
+	/**
+	 * @brief Starts predicting from the given position, forgetting anything predicted
+	 * so far.
+	 */
+	void reset(const SharedPhysics& physics);
+
+	/**
+	 * @brief Stops predicting until the next reset().
+	 */
+	void stop();
+
+	/**
+	 * @return Whether the predictor has been started with reset()
+	 */
+	bool isActive() const;
+
+	/**
+	 * @brief Applies an input event the client is sending to the server, if it is one
+	 * that affects movement.
+	 */
+	void applyInput(const Event& event);
+
+	/**
+	 * @brief Predicts one tick of movement using the current input.
+	 * @param input_sequence Sequence number of the last InputFrame sent, which holds
+	 * the input used for this tick
+	 */
+	void tick(uint32_t input_sequence);
+
+	/**
+	 * @brief Corrects the prediction from where the server says the player is.
+	 */
+	void reconcile(const ReconcileMovementEvent& authoritative);
+
+	/**
+	 * @return Where the player's corner is predicted to be, including any correction
+	 * still being smoothed out, for drawing
+	 */
+	glm::vec3 getCorner() const;
+
+	/**
+	 * @return Where the player's corner is predicted to be, without smoothing
+	 */
+	glm::vec3 getPredictedCorner() const;
+
+	/**
+	 * @return Number of predicted ticks the server hasn't confirmed yet
+	 */
+	std::size_t numUnconfirmed() const;
+
+	const MovementPredictionStats& getStats() const;
+
+private:
+	/**
+	 * What the player was asking to do during a single tick
+	 */
+	struct Input {
+		/// @brief Horizontal direction of movement from MoveCam, or 0 if not moving
+		glm::vec3 movement;
+		bool jump;
+		bool sprint;
+	};
+
+	/**
+	 * A tick that has been predicted but not confirmed by the server
+	 */
+	struct PredictedTick {
+		uint32_t input_sequence;
+		Input input;
+	};
+
+	/**
+	 * @brief Runs one tick of movement from the current position.
+	 */
+	void _step(const Input& input);
+
+	/**
+	 * @return Whether the player collides with a static collider with its corner at
+	 * the given position
+	 */
+	bool _collides(glm::vec3 corner) const;
+
+	/**
+	 * An axis aligned box the player can't move through
+	 */
+	struct Box {
+		glm::vec3 corner;
+		glm::vec3 dimensions;
+	};
+
+	/// @brief Static colliders, bucketed into every cell they cover
+	std::unordered_map<glm::ivec2, std::vector<Box>> colliders;
+
+	bool active;
+
+	glm::vec3 corner;
+	glm::vec3 dimensions;
+	glm::vec3 velocity;
+	glm::vec3 velocity_multiplier;
+
+	/// @brief Input to use for the next tick
+	Input input;
+
+	std::deque<PredictedTick> history;
+
+	/// @brief Offset from the predicted position to draw at, which shrinks every tick
+	glm::vec3 correction;
+
+	MovementPredictionStats stats;
+};
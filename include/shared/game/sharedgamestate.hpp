@@ -165,8 +165,41 @@ struct Lobby {
  * timestep. It is intended only for use by the client(s).
  */
 struct SharedGameState {
+	/**
+	 * @brief Objects that are sent in full. boost::none means the object was deleted.
+	 */
 	std::unordered_map<EntityID, boost::optional<SharedObject>> objects;
 
+	/**
+	 * @brief Field level updates to objects that the client already has a copy of.
+	 */
+	std::unordered_map<EntityID, SharedObjectDelta> object_deltas;
+
+	/**
+	 * @brief Id the client should acknowledge once it has applied this update, so
+	 * the server can compute future deltas against it. 0 if the update does not need
+	 * to be acknowledged.
+	 */
+	uint32_t snapshot_id;
+
+	/**
+	 * @brief Large snapshots are split up across multiple packets. This is the index of
+	 * the chunk this SharedGameState holds, out of num_chunks chunks for the snapshot.
+	 * Only the first chunk carries the timestep, lobby, phase, etc. fields.
+	 */
+	uint32_t chunk_index;
+	uint32_t num_chunks;
+
+	/**
+	 * @brief Nonzero if this is a chunk of a full state resync, which the server sends
+	 * when a client (re)connects. The client has to hold on to every chunk of a resync,
+	 * and only once all of them have arrived replace everything it had with the resync.
+	 * Every resync the server starts gets a new id, so that chunks of one that was
+	 * abandoned can be told apart from the one that replaced it.
+	 */
+	uint32_t resync_id;
+
+
 	unsigned int timestep;
 
 	Lobby lobby;
@@ -184,6 +217,10 @@ struct SharedGameState {
 	SharedGameState():
 		objects(std::unordered_map<EntityID, boost::optional<SharedObject>>())
 	{
+		this->snapshot_id = 0;
+		this->chunk_index = 0;
+		this->num_chunks = 1;
+		this->resync_id = 0;
 		this->phase = GamePhase::TITLE_SCREEN;
 		this->timestep = FIRST_TIMESTEP;
 		this->lobby.max_players = MAX_PLAYERS;
@@ -196,6 +233,10 @@ struct SharedGameState {
 	SharedGameState(GamePhase start_phase, const GameConfig& config):
 		objects(std::unordered_map<EntityID, boost::optional<SharedObject>>())
 	{
+		this->snapshot_id = 0;
+		this->chunk_index = 0;
+		this->num_chunks = 1;
+		this->resync_id = 0;
 		this->phase = start_phase;
 		this->timestep = FIRST_TIMESTEP;
 		this->lobby.max_players = config.server.max_players;
@@ -207,10 +248,28 @@ struct SharedGameState {
 	}
 
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
-		ar & objects & timestep & lobby & phase & matchPhase
-			& relay_finish_time & playerVictory & numPlayerDeaths;
+		ar & snapshot_id & chunk_index & num_chunks & resync_id & objects & object_deltas;
+
+		//	Everything else is the same for every chunk of a snapshot, so it is
+		//	only sent once
+		if (isFirstChunk()) {
+			ar & timestep & lobby & phase & matchPhase
+				& relay_finish_time & playerVictory & numPlayerDeaths;
+		}
 	}
 
+	/**
+	 * @returns true if this is the first chunk of a snapshot, which is the chunk that
+	 * carries the non-object fields
+	 */
+	bool isFirstChunk() const { return this->chunk_index == 0; }
+
+	/**
+	 * @returns true if this is the last chunk of a snapshot, at which point the whole
+	 * snapshot has been received
+	 */
+	bool isLastChunk() const { return this->chunk_index + 1 >= this->num_chunks; }
+
 	/**
 	 * Updates this SharedGameState with the changes from the incoming SharedGameState
 	 * 
@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <algorithm>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 #include "shared/utilities/serialize_macro.hpp"
@@ -60,6 +61,8 @@ struct SharedStats {
 	Stat<int> health;
 	Stat<int> speed;
 
+	bool operator==(const SharedStats&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & health & speed;
 	}
@@ -93,6 +96,8 @@ public:
 	 */
 	size_t getStatusLength(Status st) const;
 
+	bool operator==(const SharedStatuses&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & map;
 	}
@@ -117,6 +122,8 @@ struct SharedInventory {
 	 */
 	bool hasOrb;
 
+	bool operator==(const SharedInventory&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar& selected& inventory_size& inventory& usedItems & hasOrb& usesRemaining;
 	}
@@ -131,6 +138,8 @@ struct SharedTrapInventory {
 	std::unordered_map<CellType, int> trapsCooldown;
 	int trapsPlaced;
 
+	bool operator==(const SharedTrapInventory&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar& selected& inventory_size& inventory& trapsInCooldown& trapsPlaced & trapsCooldown;
 	}
@@ -141,6 +150,8 @@ struct SharedItemInfo {
 	bool used; // for rendering
 	double remaining_time;
 
+	bool operator==(const SharedItemInfo&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar& used& held& remaining_time;
 	}
@@ -150,6 +161,8 @@ struct SharedWeaponInfo {
 	bool attacked;
 	bool lightning;
 
+	bool operator==(const SharedWeaponInfo&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar& attacked& lightning;
 	}
@@ -171,6 +184,8 @@ struct SharedSolidSurface {
 
 	bool is_internal;
 
+	bool operator==(const SharedSolidSurface&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & surfaceType & is_internal;
 	}
@@ -202,6 +217,8 @@ struct SharedPhysics {
 	 */
 	glm::vec3 getCenterPosition() const;
 
+	bool operator==(const SharedPhysics&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar& corner& facing & dimensions;
 	}
@@ -211,6 +228,8 @@ struct SharedTrapInfo {
 	bool triggered;
 	bool dm_hover;
 
+	bool operator==(const SharedTrapInfo&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & triggered & dm_hover;
 	}
@@ -222,6 +241,8 @@ struct SharedPlayerInfo {
 	bool render; // for invis potion
 	bool used_mirror_to_reflect_lightning;	//	To tell the player that they successfully reflected lightning
 
+	bool operator==(const SharedPlayerInfo&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & is_alive & respawn_time & render & used_mirror_to_reflect_lightning;
 	}
@@ -241,6 +262,8 @@ struct SharedPointLightInfo {
 
 	bool is_cut = false;
 
+	bool operator==(const SharedPointLightInfo&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const int version) {
 		ar & intensity & ambient_color & diffuse_color & specular_color &
             attenuation_linear & attenuation_quadratic & is_cut;
@@ -253,6 +276,8 @@ struct SharedExit {
 	 */
 	bool open;
 
+	bool operator==(const SharedExit&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & open;
 	}
@@ -280,6 +305,8 @@ struct SharedDMInfo {
 
 	int mana_remaining;
 
+	bool operator==(const SharedDMInfo&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & paralyzed & mana_remaining;
 	}
@@ -290,11 +317,60 @@ struct SharedCompass {
 
 	float angle;
 
+	bool operator==(const SharedCompass&) const = default;
+
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar& angle;
 	}
 };
 
+/**
+ * @brief Every field of a SharedObject (other than its globalID) that can be sent
+ * individually inside of a SharedObjectDelta.
+ */
+enum class SharedObjectField : uint32_t {
+	Type,
+	Physics,
+	ModelType,
+	AnimState,
+	Stats,
+	ItemInfo,
+	SolidSurface,
+	TrapInfo,
+	PlayerInfo,
+	InventoryInfo,
+	TrapInventoryInfo,
+	PointLightInfo,
+	Statuses,
+	Exit,
+	WeaponInfo,
+	DMInfo,
+	Compass,
+	NUM_FIELDS
+};
+
+/**
+ * @brief Bitmask of SharedObjectFields, where bit i is set if the SharedObjectField
+ * with value i is included.
+ */
+using SharedObjectFieldMask = uint32_t;
+
+/**
+ * @param field SharedObjectField to get the bit for
+ * @returns SharedObjectFieldMask with only the bit for the given field set
+ */
+constexpr SharedObjectFieldMask fieldBit(SharedObjectField field) {
+	return SharedObjectFieldMask(1) << static_cast<uint32_t>(field);
+}
+
+/**
+ * @brief SharedObjectFieldMask with every field set
+ */
+constexpr SharedObjectFieldMask ALL_SHARED_OBJECT_FIELDS =
+	fieldBit(SharedObjectField::NUM_FIELDS) - 1;
+
+class SharedObjectDelta;
+
 /**
  * @brief Representation of the Object class used by ServerGameState, containing
  * exactly the subset of Object data required by the client.
@@ -323,6 +399,20 @@ public:
 
 	SharedObject() {} // cppcheck-suppress uninitMemberVar
 	~SharedObject() {}
+
+	/**
+	 * @brief Compares this SharedObject against another version of the same object.
+	 * @param other Other version of this object to compare against
+	 * @return Mask of every field whose value differs between the two objects
+	 */
+	SharedObjectFieldMask diff(const SharedObject& other) const;
+
+	/**
+	 * @brief Overwrites every field that is included in the delta with the delta's value,
+	 * leaving all other fields untouched.
+	 * @param delta Field level update for this object
+	 */
+	void applyDelta(const SharedObjectDelta& delta);
 	 
 	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
 		ar & globalID & type & physics & modelType & animState & stats & 
@@ -332,3 +422,56 @@ public:
 	}
 private:
 };
+
+/**
+ * @brief Field level update to a SharedObject that the receiver already has a copy of.
+ * Only the fields set in the mask are serialized, so a delta for an object that just
+ * moved only contains its SharedPhysics.
+ */
+class SharedObjectDelta {
+public:
+	SharedObjectDelta(): fields(0) {}
+
+	/**
+	 * @param obj Current version of the object
+	 * @param fields Which fields of obj to include in the delta
+	 */
+	SharedObjectDelta(const SharedObject& obj, SharedObjectFieldMask fields);
+
+	/**
+	 * @param field Field to check for
+	 * @return true if the delta contains a value for the given field
+	 */
+	bool has(SharedObjectField field) const {
+		return (this->fields & fieldBit(field)) != 0;
+	}
+
+	/// @brief Which fields of values are valid
+	SharedObjectFieldMask fields;
+	/// @brief Values of the fields in the mask. Fields outside of the mask are unspecified.
+	SharedObject values;
+
+	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
+		// fields is always read before anything else, so the same checks work
+		// for both saving and loading
+		ar & fields & values.globalID;
+
+		if (has(SharedObjectField::Type)) ar & values.type;
+		if (has(SharedObjectField::Physics)) ar & values.physics;
+		if (has(SharedObjectField::ModelType)) ar & values.modelType;
+		if (has(SharedObjectField::AnimState)) ar & values.animState;
+		if (has(SharedObjectField::Stats)) ar & values.stats;
+		if (has(SharedObjectField::ItemInfo)) ar & values.iteminfo;
+		if (has(SharedObjectField::SolidSurface)) ar & values.solidSurface;
+		if (has(SharedObjectField::TrapInfo)) ar & values.trapInfo;
+		if (has(SharedObjectField::PlayerInfo)) ar & values.playerInfo;
+		if (has(SharedObjectField::InventoryInfo)) ar & values.inventoryInfo;
+		if (has(SharedObjectField::TrapInventoryInfo)) ar & values.trapInventoryInfo;
+		if (has(SharedObjectField::PointLightInfo)) ar & values.pointLightInfo;
+		if (has(SharedObjectField::Statuses)) ar & values.statuses;
+		if (has(SharedObjectField::Exit)) ar & values.exit;
+		if (has(SharedObjectField::WeaponInfo)) ar & values.weaponInfo;
+		if (has(SharedObjectField::DMInfo)) ar & values.DMInfo;
+		if (has(SharedObjectField::Compass)) ar & values.compass;
+	}
+};
@@ -58,6 +58,8 @@ public:
     T mod() const { return _mod; }
     T mult() const { return _mult; }
 
+    bool operator==(const Stat&) const = default;
+
     DEF_SERIALIZE(Archive& ar, const unsigned int version) {
         ar & _min & _max & _base & _mod & _mult;
     }
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+
+/**
+ * How a simulated network link behaves in one direction
+ */
+struct LinkConditions {
+    /// @brief Time it takes anything to cross the link
+    std::chrono::microseconds latency {0};
+    /// @brief Each send is delayed by up to this much more or less than latency, uniformly at random
+    std::chrono::microseconds jitter {0};
+    /// @brief Bytes per second the link can carry, or 0 for no limit
+    std::size_t bandwidth = 0;
+    /// @brief Chance of each send being lost, from 0 to 1
+    double loss = 0.0;
+    /// @brief How much later a lost send on a reliable (TCP) link arrives, after being sent again
+    std::chrono::microseconds retransmit_timeout {std::chrono::milliseconds(200)};
+    /// @brief Bytes a reliable link holds in flight before it stops reading from the sender,
+    /// which is what makes a sender's own send queue back up
+    std::size_t window_bytes = 256 * 1024;
+    /// @brief Seed for the random numbers, so that runs can be repeated
+    uint32_t seed = 1;
+};
+
+/**
+ * Counters describing what has gone through a simulated link in one direction
+ */
+struct LinkStats {
+    /// @brief Number of bytes that have been sent, including ones lost on an unreliable link
+    std::size_t bytes_sent = 0;
+    /// @brief Number of reads (TCP) or datagrams (UDP) sent
+    std::size_t sends = 0;
+    /// @brief Number of sends that were lost, and either dropped or sent again
+    std::size_t sends_lost = 0;
+};
+
+enum class LinkDirection {
+    /// @brief From whoever connected to the link, to what the link connects to
+    ToTarget,
+    /// @brief Back from what the link connects to
+    FromTarget
+};
+
+/**
+ * Decides when each send on a simulated link arrives at the other end, using a model of
+ * the link's latency, jitter, bandwidth and loss. This doesn't touch the network itself,
+ * so it can be used by the simulated links with any kind of socket.
+ *
+ * A reliable DelayLine acts like TCP: nothing is ever dropped, a lost send arrives a
+ * retransmit_timeout later, and everything arrives in the order it was sent, so anything
+ * behind a lost send has to wait for it. An unreliable DelayLine acts like UDP: lost
+ * sends are dropped, and sends can overtake each other.
+ */
+class DelayLine {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    DelayLine(LinkConditions conditions, bool reliable);
+
+    /**
+     * @param bytes Number of bytes being sent
+     * @param now Time they are being sent at
+     * @returns Time the bytes arrive at the other end, or nullopt if they were lost and
+     * the link is unreliable
+     */
+    std::optional<Clock::time_point> schedule(std::size_t bytes, Clock::time_point now);
+
+    const LinkConditions& getConditions() const;
+
+    const LinkStats& getStats() const;
+
+private:
+    LinkConditions conditions;
+    bool reliable;
+
+    std::mt19937 rng;
+
+    /// @brief Time the link will have finished putting everything sent so far on the wire
+    Clock::time_point link_free_at;
+
+    /// @brief Time the last send arrives, which a reliable link can't deliver anything before
+    Clock::time_point last_arrival;
+
+    LinkStats stats;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "shared/netsim/delayline.hpp"
+#include "shared/netsim/scriptedclient.hpp"
+#include "shared/netsim/simulatedlink.hpp"
+#include "shared/network/session.hpp"
+
+/**
+ * Two Sessions connected to each other through a SimulatedLink
+ */
+struct SessionPair {
+    std::shared_ptr<Session> client;
+    std::shared_ptr<Session> server;
+    std::shared_ptr<SimulatedLink> link;
+};
+
+/**
+ * Runs networked code entirely inside one process, over loopback connections that go
+ * through SimulatedLinks, so that tests and benchmarks can measure how it behaves on a bad
+ * network without needing one.
+ *
+ * Everything made by the harness runs on its io_context, which only does anything while
+ * one of the poll functions is running. A Server under test should be made with
+ * getContext() and a port of 0, and then have its doTick called between polls instead of
+ * running the io_context itself.
+ */
+class NetHarness {
+public:
+    NetHarness();
+
+    boost::asio::io_context& getContext();
+
+    /**
+     * Makes a pair of Sessions which talk to each other through a SimulatedLink.
+     *
+     * @param to_server Conditions for everything the client Session sends
+     * @param to_client Conditions for everything the server Session sends
+     */
+    SessionPair connectSessions(const LinkConditions& to_server, const LinkConditions& to_client);
+
+    /**
+     * Makes a ScriptedClient that connects to a Server running on this harness' io_context.
+     * Each client connects from its own loopback address.
+     *
+     * @param server_port Port the Server is accepting connections on
+     * @param to_server Conditions for everything the client sends
+     * @param to_client Conditions for everything the Server sends the client
+     */
+    std::shared_ptr<ScriptedClient> addClient(unsigned short server_port,
+        const LinkConditions& to_server, const LinkConditions& to_client);
+
+    /**
+     * Runs the io_context for the given amount of time, and polls every ScriptedClient
+     * as it goes.
+     */
+    void pollFor(std::chrono::microseconds duration);
+
+    /**
+     * Runs the io_context, polling every ScriptedClient, until pred returns true or the
+     * timeout is hit.
+     *
+     * @returns true if pred returned true
+     */
+    template <typename Pred>
+    bool pollUntil(Pred pred, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+        auto deadline = DelayLine::Clock::now() + timeout;
+        while (!pred()) {
+            if (DelayLine::Clock::now() > deadline) {
+                return false;
+            }
+            this->pollFor(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+private:
+    boost::asio::io_context context;
+
+    std::vector<std::shared_ptr<ScriptedClient>> clients;
+};
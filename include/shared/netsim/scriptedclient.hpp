@@ -0,0 +1,129 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "shared/game/event.hpp"
+#include "shared/game/sharedgamestate.hpp"
+#include "shared/netsim/delayline.hpp"
+#include "shared/netsim/simulatedlink.hpp"
+#include "shared/network/resyncreceiver.hpp"
+#include "shared/network/session.hpp"
+#include "shared/network/snapshotchannel.hpp"
+#include "shared/network/snapshotreceiver.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+/**
+ * When a snapshot arrived at a ScriptedClient
+ */
+struct SnapshotArrival {
+    /// @brief ServerGameState timestep the snapshot was generated during
+    unsigned int timestep;
+    /// @brief Time the snapshot was applied
+    DelayLine::Clock::time_point time;
+};
+
+/**
+ * A client with no window, which connects to a real Server through a SimulatedLink (and a
+ * SimulatedDatagramLink for snapshots, if the Server uses UDP for them), and otherwise
+ * talks to it the same way Client does: it applies and acknowledges snapshots, and sends
+ * whatever input it is told to in InputFrames.
+ *
+ * Made by NetHarness::addClient.
+ */
+class ScriptedClient {
+public:
+    /**
+     * @param context io_context to run on, which the Server should be using too
+     * @param server Where the Server is accepting connections
+     * @param to_server Conditions for everything sent to the Server
+     * @param to_client Conditions for everything sent back
+     * @param bind_address Address to connect to the Server from, which must be unique
+     * among clients of the same Server
+     */
+    ScriptedClient(boost::asio::io_context& context, tcp::endpoint server,
+        LinkConditions to_server, LinkConditions to_client, boost::asio::ip::address bind_address);
+
+    /**
+     * Handles everything that has arrived from the Server, like Client::processServerInput,
+     * and sends anything added with addInput since the last call.
+     */
+    void poll();
+
+    /**
+     * Connects to the Server again through a new SimulatedLink from the same address,
+     * closing the current link if it is still open, the same way a Client that lost its
+     * connection would. The game state is kept until the Server has sent a new one.
+     */
+    void reconnect();
+
+    /**
+     * Adds an event to send to the Server in the next InputFrame.
+     */
+    void addInput(const Event& event);
+
+    /**
+     * @returns EntityID the Server has assigned us, or nullopt if it hasn't yet
+     */
+    std::optional<EntityID> getEID() const;
+
+    /**
+     * @returns The game state as the client currently sees it
+     */
+    const SharedGameState& getState() const;
+
+    /**
+     * @returns Every snapshot that has arrived so far, in the order they were applied
+     */
+    const std::vector<SnapshotArrival>& getArrivals() const;
+
+    /**
+     * @returns When the last full state resync was completely received and swapped
+     * in, or nullopt if none has been
+     */
+    std::optional<DelayLine::Clock::time_point> getLastResyncTime() const;
+
+    /**
+     * @returns Number of bytes the Server has sent this client since it last connected,
+     * over TCP and UDP
+     */
+    std::size_t getBytesReceived() const;
+
+    std::shared_ptr<Session> getSession() const;
+
+    std::shared_ptr<SimulatedLink> getLink() const;
+
+private:
+    /**
+     * Connects a new Session to the Server through a new SimulatedLink
+     */
+    void _connect();
+
+    /**
+     * Sets up the SnapshotChannel once the Server has told us its UDP port, like
+     * Client::_pollSnapshotChannel
+     */
+    void _pollSnapshotChannel(std::vector<Event>& events);
+
+    boost::asio::io_context& context;
+    tcp::endpoint server;
+    LinkConditions to_server;
+    LinkConditions to_client;
+    boost::asio::ip::address bind_address;
+
+    std::shared_ptr<SimulatedLink> link;
+    std::shared_ptr<Session> session;
+
+    std::shared_ptr<SimulatedDatagramLink> datagram_link;
+    std::shared_ptr<SnapshotChannel> snapshot_channel;
+
+    SnapshotReceiver snapshot_receiver;
+    ResyncReceiver resync_receiver;
+    SharedGameState state;
+    std::vector<SnapshotArrival> arrivals;
+    std::optional<DelayLine::Clock::time_point> last_resync_time;
+};
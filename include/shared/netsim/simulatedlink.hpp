@@ -0,0 +1,191 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "shared/netsim/delayline.hpp"
+
+using boost::asio::ip::tcp;
+using boost::asio::ip::udp;
+
+/// @brief Size of the buffer each direction of a simulated link reads into
+const std::size_t SIMULATED_LINK_READ_BYTES = 64 * 1024;
+
+/**
+ * A TCP relay running in the same process, which makes a loopback connection behave like
+ * a connection over a real network.
+ *
+ * The link listens on a loopback port. Once something connects to it, it connects to the
+ * target, and from then on passes bytes between the two connections, holding on to them
+ * for as long as the LinkConditions for that direction say (see DelayLine). Nothing in
+ * between has to know about the link, so it works with Sessions on either end, and with
+ * the real Server.
+ *
+ * The connection to the target comes from bind_address, which can be any 127.x.x.x
+ * address. Since the Server tells clients apart by address, giving each link its own
+ * lets several clients connect to one Server from the same process.
+ *
+ * Like Session, the link only does anything while the io_context is run.
+ */
+class SimulatedLink : public std::enable_shared_from_this<SimulatedLink> {
+public:
+    /**
+     * @param context io_context to run on
+     * @param target Where to connect to once something connects to the link
+     * @param to_target Conditions for bytes sent to the target
+     * @param from_target Conditions for bytes sent back from the target
+     * @param bind_address Address to connect to the target from
+     */
+    SimulatedLink(boost::asio::io_context& context, tcp::endpoint target,
+        LinkConditions to_target, LinkConditions from_target,
+        boost::asio::ip::address bind_address = boost::asio::ip::address_v4::loopback());
+
+    /**
+     * Starts waiting for a connection. Only the first connection is accepted.
+     */
+    void start();
+
+    /**
+     * @returns Where to connect to, to go through the link
+     */
+    tcp::endpoint getEndpoint() const;
+
+    /**
+     * @returns true once both connections are established, and until either is closed
+     */
+    bool isConnected() const;
+
+    /**
+     * Cuts both connections, as if the network had gone down.
+     */
+    void close();
+
+    const LinkStats& getStats(LinkDirection direction) const;
+
+    /**
+     * @returns Number of bytes held by the link in the given direction, which haven't
+     * arrived yet
+     */
+    std::size_t getBytesInFlight(LinkDirection direction) const;
+
+private:
+    /**
+     * A queue of bytes that arrive at a set time
+     */
+    struct Chunk {
+        DelayLine::Clock::time_point arrival;
+        std::vector<char> bytes;
+    };
+
+    /**
+     * One direction of the link
+     */
+    struct Pipe {
+        Pipe(boost::asio::io_context& context, tcp::socket& from, tcp::socket& to, LinkConditions conditions);
+
+        tcp::socket& from;
+        tcp::socket& to;
+        DelayLine line;
+        std::array<char, SIMULATED_LINK_READ_BYTES> buffer;
+        std::deque<Chunk> queue;
+        std::size_t queue_bytes;
+        boost::asio::steady_timer timer;
+        bool reading;
+        bool writing;
+    };
+
+    /**
+     * Starts reading from the pipe's sender, unless already reading or the window is full
+     */
+    void _doRead(Pipe& pipe);
+
+    /**
+     * Waits for the front chunk of the pipe to arrive and then writes it, unless already
+     * doing so
+     */
+    void _doWrite(Pipe& pipe);
+
+    tcp::acceptor acceptor;
+    tcp::endpoint target;
+    boost::asio::ip::address bind_address;
+
+    /// @brief Connection from whoever connected to the link
+    tcp::socket near_socket;
+    /// @brief Connection to the target
+    tcp::socket far_socket;
+
+    bool connected;
+
+    Pipe to_target;
+    Pipe from_target;
+};
+
+/**
+ * The UDP counterpart of SimulatedLink, which passes datagrams between whoever last sent
+ * one to the link, and the target. Datagrams that the LinkConditions say are lost are
+ * dropped, and datagrams can arrive out of order when there is jitter.
+ */
+class SimulatedDatagramLink : public std::enable_shared_from_this<SimulatedDatagramLink> {
+public:
+    /**
+     * @param context io_context to run on
+     * @param target Where to send datagrams to
+     * @param to_target Conditions for datagrams sent to the target
+     * @param from_target Conditions for datagrams sent back from the target
+     * @param bind_address Address to send to the target from
+     */
+    SimulatedDatagramLink(boost::asio::io_context& context, udp::endpoint target,
+        LinkConditions to_target, LinkConditions from_target,
+        boost::asio::ip::address bind_address = boost::asio::ip::address_v4::loopback());
+
+    /**
+     * Starts passing datagrams along.
+     */
+    void start();
+
+    /**
+     * @returns Where to send datagrams to, to go through the link
+     */
+    udp::endpoint getEndpoint() const;
+
+    const LinkStats& getStats(LinkDirection direction) const;
+
+private:
+    /**
+     * Receives datagrams on the given side of the link, and passes them to the other side
+     */
+    void _doReceive(LinkDirection direction);
+
+    /**
+     * Sends a datagram out of the given side of the link once it arrives
+     */
+    void _forward(LinkDirection direction, std::size_t bytes);
+
+    /// @brief Socket whoever uses the link sends to
+    udp::socket near_socket;
+    /// @brief Socket that talks to the target
+    udp::socket far_socket;
+
+    udp::endpoint target;
+
+    /// @brief Whoever last sent a datagram to the link, which replies are sent back to
+    std::optional<udp::endpoint> sender;
+
+    /// @brief Where the datagram being received on each side came from
+    udp::endpoint near_from;
+    udp::endpoint far_from;
+
+    DelayLine to_target;
+    DelayLine from_target;
+
+    std::array<char, SIMULATED_LINK_READ_BYTES> near_buffer;
+    std::array<char, SIMULATED_LINK_READ_BYTES> far_buffer;
+};
@@ -1,11 +1,52 @@
 #pragma once
 
-// How many bytes are in the buffer for incoming packets.
-// NOTE: We think the current size of the buffer will be less
-// than this due to some sort of size limit.
-#define NETWORK_BUFFER_SIZE 1'000'000
-
-// How many objects we send in one LoadGameState packet
-// If there are more objects that need to be sent, then
-// they are split up into multiple LoadGameState packets
-#define OBJECTS_PER_UPDATE 250
+// Largest data portion (not including the header) that a packet may say it
+// has. Sessions close the connection instead of taking in anything bigger, so
+// that a peer can't make them allocate an arbitrary amount of memory
+#define MAX_PACKET_BYTES 16'777'216
+
+// Initial size in bytes of each session's buffer for incoming packets.
+// It grows to fit larger packets (or more bytes arriving at once), and
+// shrinks back down once it has been emptied out
+#define RECEIVE_BUFFER_INITIAL_SIZE 65'536
+
+// Never read from a socket with less than this many bytes of free space
+// in the receive buffer
+#define RECEIVE_BUFFER_MIN_READ 16'384
+
+// Once the receive buffer is emptied out, it is shrunk back down to its
+// initial size if it has grown larger than this
+#define RECEIVE_BUFFER_SHRINK_SIZE 1'048'576
+
+// The receive buffer never grows past this, which is enough for the largest
+// packet allowed (plus its header) and a read after it
+#define RECEIVE_BUFFER_MAX_SIZE (MAX_PACKET_BYTES + RECEIVE_BUFFER_MIN_READ)
+
+// How many LoadGameState snapshots can be waiting for a client's
+// acknowledgement before the server stops sending deltas to that
+// client and starts over by sending full objects
+#define MAX_UNACKED_SNAPSHOTS 64
+
+// Once this many bytes are waiting to be written to a session's socket,
+// the session is considered backed up, and the server stops queueing
+// game state snapshots for it until it catches up
+#define SEND_QUEUE_HIGH_WATER_MARK 1'000'000
+
+// If this many bytes are waiting to be written to a session's socket, the
+// client is considered unresponsive and the session is closed
+#define SEND_QUEUE_MAX_BYTES 8'000'000
+
+// Byte budget for each game state snapshot chunk sent over the UDP
+// SnapshotChannel, chosen so datagrams don't get fragmented on typical
+// networks. A single object bigger than this still gets its own datagram
+#define SNAPSHOT_DATAGRAM_BYTES 1200
+
+// Largest payload a UDP datagram can carry over IPv4. Snapshot chunks that
+// don't fit are sent over the TCP session instead
+#define MAX_DATAGRAM_BYTES 65'507
+
+// Most bytes of a full state resync (sent to a client when it connects or
+// reconnects) that are sent to a client each tick. The resync is sent in
+// SNAPSHOT_DATAGRAM_BYTES sized chunks, a few at a time, so that serializing
+// a whole maze doesn't hold up the tick for everyone else
+#define RESYNC_BYTES_PER_TICK 256'000
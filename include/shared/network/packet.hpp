@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <utility>
 #include <ostream>
@@ -35,6 +38,7 @@ enum class PacketType: uint16_t {
 
     // Gameplay
     Event = 2000, ///< Client requesting server to perform specific input
+    InputFrame,   ///< Sent by the client once per frame, bundling all of that frame's events
 };
 
 /**
@@ -50,16 +54,19 @@ struct PacketHeader {
      * 
      * @param size Size in bytes of the data portion of the packet (not inc header)
      * @param type Type of the packet, according to the PacketType enum
+     * @param format Archive format the data portion of the packet is encoded with
      */
-    PacketHeader(uint16_t size, PacketType type): size{size}, type{type} {}
+    PacketHeader(uint32_t size, PacketType type, WireFormat format = DEFAULT_WIRE_FORMAT):
+        size{size}, type{type}, format{format} {}
 
     /**
      * Converts this packet to network byte order. This should be called before sending
      * over the network.
      */
     void to_network() {
-        this->size = htons(this->size);
+        this->size = htonl(this->size);
         this->type = static_cast<PacketType>(htons(static_cast<uint16_t>(this->type))); 
+        this->format = static_cast<WireFormat>(htons(static_cast<uint16_t>(this->format)));
     }
 
     /**
@@ -68,19 +75,22 @@ struct PacketHeader {
      * so this should not be used if the buffer contains a packet header not in network
      * byte order.
      * 
-     * @param buffer The buffer received over the network containing the 4 bytes
+     * @param buffer The buffer received over the network containing the 8 bytes
      * for the header.
      */
     explicit PacketHeader(void* buffer) {
         PacketHeader* buf_hdr = static_cast<PacketHeader*>(buffer);
-        this->size = ntohs(buf_hdr->size);
+        this->size = ntohl(buf_hdr->size);
         this->type = static_cast<PacketType>(ntohs(static_cast<uint16_t>(buf_hdr->type)));
+        this->format = static_cast<WireFormat>(ntohs(static_cast<uint16_t>(buf_hdr->format)));
     }
 
     /// @brief Size (in bytes) of the packet data (not including the header)
-    uint16_t size;
+    uint32_t size;
     /// @brief What kind of packet this is, according to the Type enum class
     PacketType type;
+    /// @brief Protocol version of the packet data, i.e. which archive format it was encoded with
+    WireFormat format;
 };
 
 /**
@@ -123,9 +133,11 @@ struct ServerAssignEIDPacket {
     /// @brief ID that the server is assigning to the client.
     EntityID eid;
     bool is_dungeon_master;
+    /// @brief UDP port of the server's SnapshotChannel, or 0 if snapshots only go over TCP
+    uint16_t snapshot_port = 0;
 
     DEF_SERIALIZE(Archive& ar, const unsigned int version) {
-        ar & eid & is_dungeon_master;
+        ar & eid & is_dungeon_master & snapshot_port;
     }
 };
 
@@ -137,6 +149,59 @@ struct EventPacket {
     }
 };
 
+BOOST_CLASS_IMPLEMENTATION(EventPacket, boost::serialization::object_serializable)
+BOOST_CLASS_TRACKING(EventPacket, boost::serialization::track_never)
+
+/**
+ * Packet sent by the client at the end of a frame, containing every event it generated
+ * during that frame, in order.
+ */
+struct InputFramePacket {
+    /// @brief Increases by one for every InputFrame a client sends, starting at 1
+    uint32_t sequence;
+    /// @brief Milliseconds on the client's steady clock when the frame was sent. Only
+    /// meaningful when compared against other timestamps from the same client
+    int64_t client_time_ms;
+    /// @brief Events generated during the frame
+    std::vector<Event> events;
+
+    template <class Archive>
+    void save(Archive& ar, const unsigned int version) const {
+        uint32_t num_events = this->events.size();
+        ar & sequence & client_time_ms & num_events;
+        for (const auto& event : this->events) {
+            ar & event;
+        }
+    }
+
+    /**
+     * Reads the events one at a time, leaving out any that this build doesn't know
+     * about
+     */
+    template <class Archive>
+    void load(Archive& ar, const unsigned int version) {
+        uint32_t num_events;
+        ar & sequence & client_time_ms & num_events;
+
+        this->events.clear();
+        for (uint32_t i = 0; i < num_events; i++) {
+            Event event;
+            ar & event;
+            if (!isKnownEventType(event.type)) {
+                std::cerr << "Skipping event of unknown type " << static_cast<int>(event.type)
+                    << " in InputFrame " << sequence << std::endl;
+                continue;
+            }
+            this->events.push_back(std::move(event));
+        }
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+};
+
+BOOST_CLASS_IMPLEMENTATION(InputFramePacket, boost::serialization::object_serializable)
+BOOST_CLASS_TRACKING(InputFramePacket, boost::serialization::track_never)
+
 /**
  * A class which wraps around a packet that has yet to be sent across the network.
  * Note: this class can only be instantiated as a shared_ptr using the provided friend
@@ -154,14 +219,24 @@ public:
      * 
      * @param type of packet to make
      * @param packet actual packet data
+     * @param format archive format to encode the packet data with
      */
     template <class Packet>
-    static std::shared_ptr<PackagedPacket> make_shared(PacketType type, Packet packet) {
-        std::string data = serialize<Packet>(packet);
+    static std::shared_ptr<PackagedPacket> make_shared(PacketType type, Packet packet,
+        WireFormat format = DEFAULT_WIRE_FORMAT) {
+        auto serialize_start = std::chrono::high_resolution_clock::now();
+        std::string data = serialize<Packet>(packet, format);
+        auto serialize_stop = std::chrono::high_resolution_clock::now();
 
-        PacketHeader hdr(data.size(), type);
+        PacketHeader hdr(data.size(), type, format);
 
-        return std::shared_ptr<PackagedPacket>(new PackagedPacket(hdr, data));
+        auto packaged = std::shared_ptr<PackagedPacket>(new PackagedPacket(hdr, data));
+        packaged->type = type;
+        packaged->serialize_time = serialize_stop - serialize_start;
+        if constexpr (std::is_same_v<Packet, EventPacket>) {
+            packaged->event_type = packet.event.type;
+        }
+        return packaged;
     }
 
     /**
@@ -170,13 +245,38 @@ public:
      * @return The packet in buffer format, which can easily be passed into boost::asio::write
      * or similar function.
      */
-    std::array<boost::asio::const_buffer, 2> toBuffer() {
+    std::array<boost::asio::const_buffer, 2> toBuffer() const {
         return {
             boost::asio::buffer(&this->hdr, sizeof(PacketHeader)),
             boost::asio::buffer(this->data)
         };
     }
 
+    /**
+     * @return Total number of bytes this packet takes up on the wire, including its header.
+     */
+    std::size_t size() const {
+        return sizeof(PacketHeader) + this->data.size();
+    }
+
+    PacketType getType() const {
+        return this->type;
+    }
+
+    /**
+     * @return Type of the event inside the packet, or nullopt if it isn't an Event packet
+     */
+    std::optional<EventType> getEventType() const {
+        return this->event_type;
+    }
+
+    /**
+     * @return How long it took to serialize the packet
+     */
+    std::chrono::nanoseconds getSerializeTime() const {
+        return this->serialize_time;
+    }
+
 private:
     /**
      * Constructs a PackagedPacket for sending across the network. Converts the header
@@ -211,4 +311,11 @@ private:
     PacketHeader hdr;
     /// @brief Data of the packet to send, in boost::serialize format
     std::string data;
+
+    /// @brief Type of the packet, in host byte order, for telemetry
+    PacketType type;
+    /// @brief Type of the event, for Event packets
+    std::optional<EventType> event_type;
+    /// @brief Time make_shared spent serializing the packet
+    std::chrono::nanoseconds serialize_time;
 };
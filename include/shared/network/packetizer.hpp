@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "shared/game/sharedgamestate.hpp"
+#include "shared/network/packet.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+/**
+ * Splits a SharedGameState snapshot into as few chunks as possible, while keeping the
+ * LoadGameState event packet for every chunk within a byte budget. This is what
+ * packetizeSnapshot does, without serializing the chunks into packets yet, so that
+ * large snapshots can be sent a few chunks at a time.
+ *
+ * @param evt_source Source that will be put on the LoadGameState events
+ * @param snapshot Snapshot to split up
+ * @param max_packet_bytes Budget for the total size of each packet, including PacketHeader
+ * @returns Chunks to send, in order
+ */
+std::vector<SharedGameState> splitSnapshot(EntityID evt_source,
+    const SharedGameState& snapshot, std::size_t max_packet_bytes);
+
+/**
+ * Splits a SharedGameState snapshot into as few LoadGameState event packets as possible,
+ * while keeping every packet within a byte budget.
+ *
+ * Every chunk carries the snapshot's snapshot_id along with its chunk_index and num_chunks,
+ * and only the first chunk carries the lobby, phase, etc. fields. Objects are packed
+ * greedily in the order they appear in the snapshot, based on their actual encoded size.
+ * An object that doesn't fit in a packet by itself gets a packet of its own, which will be
+ * over budget.
+ *
+ * @param evt_source Source to put on the LoadGameState events
+ * @param snapshot Snapshot to split up
+ * @param max_packet_bytes Budget for the total size of each packet, including PacketHeader
+ * @returns Packets to send, in order
+ */
+std::vector<std::shared_ptr<PackagedPacket>> packetizeSnapshot(EntityID evt_source,
+    const SharedGameState& snapshot, std::size_t max_packet_bytes);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "shared/game/sharedgamestate.hpp"
+
+/**
+ * Puts together the chunks of a full state resync (see SharedGameState::resync_id), so
+ * that the client can keep showing what it had until the whole resync has arrived, and
+ * then swap over to it all at once.
+ *
+ * If the server starts a new resync before the previous one has finished (e.g. because
+ * the client reconnected again), the unfinished one is thrown away.
+ */
+class ResyncReceiver {
+public:
+    ResyncReceiver();
+
+    /**
+     * Records that a resync chunk has arrived.
+     *
+     * @param chunk Chunk received from the server, with a nonzero resync_id
+     * @returns true if that was the last chunk missing from the newest resync, in which
+     * case it can be collected with take()
+     */
+    bool accept(const SharedGameState& chunk);
+
+    /**
+     * @returns true if some, but not all, chunks of a resync have arrived
+     */
+    bool isResyncing() const;
+
+    /**
+     * Takes the completely received resync, after which this is ready for the next one.
+     *
+     * @returns The full state the server sent
+     */
+    SharedGameState take();
+
+private:
+    /// @brief Id of the newest resync seen
+    uint32_t resync_id;
+
+    /// @brief Everything received so far of the newest resync
+    SharedGameState state;
+
+    /// @brief Which chunks of the newest resync have arrived
+    std::vector<bool> chunks_received;
+
+    /// @brief Number of chunks of the newest resync that haven't arrived yet
+    uint32_t chunks_missing;
+};
@@ -9,13 +9,16 @@
 #include <memory>
 #include <array>
 #include <queue>
+#include <deque>
 #include <vector>
 #include <mutex>
 #include <thread>
 #include <string>
 #include <optional>
+#include <span>
 
 #include "shared/network/packet.hpp"
+#include "shared/network/telemetry.hpp"
 #include "shared/utilities/typedefs.hpp"
 
 using namespace boost::asio::ip;
@@ -51,14 +54,32 @@ struct SessionInfo {
     std::optional<std::string> client_name;
     std::optional<EntityID> client_eid;
     std::optional<bool> is_dungeon_master;
+    /// @brief UDP port of the server's SnapshotChannel, if it has one
+    std::optional<uint16_t> snapshot_port;
 };
 
 
+/**
+ * Identifies the most recent InputFrame received on a session
+ */
+struct InputFrameInfo {
+    /// @brief InputFramePacket::sequence of the frame
+    uint32_t sequence;
+    /// @brief InputFramePacket::client_time_ms of the frame
+    int64_t client_time_ms;
+};
+
 /**
  * A class which wraps around the concept of a Client <-> Server relationship. This
  * works from both the client perpsective and the Server perspective. It essentially
  * provides a wrapper around a tcp::socket and lets us easily send and receive
  * our packet types.
+ *
+ * All socket operations are asynchronous, so nothing in here ever blocks on the network.
+ * Incoming packets are parsed into a queue of events as they arrive, and outgoing packets
+ * are put into a queue which is written out in the background. For any of this to happen,
+ * the io_context that owns the socket must be run/polled regularly, from the same thread
+ * that uses the Session.
  */
 class Session : public std::enable_shared_from_this<Session> {
 public:
@@ -78,8 +99,8 @@ public:
     bool isOkay() const;
 
     /**
-     * handles all of the incoming packets and puts the events in the event queue, which you
-     * can get by calling getEvents
+     * Takes all of the events that have been received since the last call. This never
+     * touches the socket, it only drains the queue which is filled in the background.
      * 
      * @returns list of all received events
      */
@@ -94,7 +115,11 @@ public:
         bool connectTo(basic_resolver_results<class boost::asio::ip::tcp> endpoints);
 
     /**
-     * Puts a packet in the queue of packets to send
+     * Puts a packet in the queue of packets to send. This returns immediately, and
+     * the packet is written out the next time the io_context is run.
+     * 
+     * If more than SEND_QUEUE_MAX_BYTES end up waiting to be sent, the other side is
+     * considered unresponsive and the session is closed.
      * 
      * @param packet The packet to send.
      */
@@ -108,6 +133,67 @@ public:
      */
     void sendEvent(Event evt);
 
+    /**
+     * Adds an event to the InputFrame for the current frame. Nothing is sent until
+     * sendInputFrame is called.
+     * 
+     * @param evt The event object to send
+     */
+    void addInput(Event evt);
+
+    /**
+     * Sends every event passed to addInput since the last call as a single InputFrame
+     * packet. Does nothing if there weren't any.
+     */
+    void sendInputFrame();
+
+    /**
+     * @returns Sequence number of the most recent InputFrame sent, or 0 if there
+     * hasn't been one
+     */
+    uint32_t getLastSentInputSequence() const;
+
+    /**
+     * @returns Sequence number and timestamp of the most recent InputFrame received, or
+     * nullopt if there hasn't been one
+     */
+    const std::optional<InputFrameInfo>& getLastInputFrame() const;
+
+    /**
+     * @returns Number of bytes queued up to be sent, but not yet written to the socket
+     */
+    std::size_t getSendQueueBytes() const;
+
+    /**
+     * @returns Size in bytes of the buffer that incoming packets are read into, which
+     * is never more than RECEIVE_BUFFER_MAX_SIZE
+     */
+    std::size_t getReceiveBufferSize() const;
+
+    /**
+     * @returns true if the send queue is past SEND_QUEUE_HIGH_WATER_MARK, in which case
+     * callers should hold off on sending anything that will be superseded later anyway
+     * (e.g. game state snapshots)
+     */
+    bool isBackedUp() const;
+
+    /**
+     * @returns Address of the other end of the connection, or an unspecified address
+     * if the socket isn't connected
+     */
+    boost::asio::ip::address getRemoteAddress() const;
+
+    /**
+     * @returns What has been sent and received since the last call to takeTelemetry
+     */
+    const NetworkTelemetry& getTelemetry() const;
+
+    /**
+     * Takes what has been sent and received since the last call, and starts counting
+     * from zero again.
+     */
+    NetworkTelemetry takeTelemetry();
+
     /**
      * Get the information associated with this session.
      */
@@ -119,26 +205,82 @@ private:
     /// @brief true until there is a fatal error on the socket
     bool okay;
 
-    std::optional<PacketHeader> prev_hdr;
-
     tcp::socket socket;
 
-    std::vector<std::shared_ptr<PackagedPacket>> packets_to_send;
+    /// @brief true while an async_read_some is outstanding
+    bool reading;
+
+    /**
+     * @brief Buffer that async_read_some reads into, and that packets are deserialized
+     * from in place. Bytes in [recv_read_pos, recv_write_pos) have been received but not
+     * parsed yet, and everything after recv_write_pos is free space for the next read.
+     */
+    std::vector<char> recv_buffer;
+    std::size_t recv_read_pos;
+    std::size_t recv_write_pos;
+
+    /// @brief Events that have been received, but not taken by handleAllReceivedPackets
+    std::vector<Event> received_events;
+
+    /// @brief true while an async_write is outstanding
+    bool writing;
+
+    /// @brief Packets waiting to be sent. The front packet is the one being written
+    std::deque<std::shared_ptr<PackagedPacket>> send_queue;
 
-    std::array<char, NETWORK_BUFFER_SIZE> buffer;
+    /// @brief Total size of every packet in send_queue
+    std::size_t send_queue_bytes;
 
     SessionInfo info;
 
+    /// @brief Events added for the frame currently being built
+    std::vector<Event> input_frame_events;
+
+    /// @brief Sequence number to give the next InputFrame sent
+    uint32_t next_input_sequence;
+
+    /// @brief Most recent InputFrame received
+    std::optional<InputFrameInfo> last_input_frame;
+
+    /// @brief What has been sent and received since the last takeTelemetry
+    NetworkTelemetry telemetry;
+
     /**
-     * Stores the received packet inside of the internal received_events
-     * vector, so it can be retrieved later by the getEvents()
-     * function.
+     * Starts an async_read_some on the socket, if there isn't already one outstanding.
+     * Every completed read parses as many packets as it can and starts the next read.
+     */
+    void _doRead();
+
+    /**
+     * Starts an async_write of the packet at the front of the send queue, if there isn't
+     * already one outstanding. Every completed write starts the next one.
+     */
+    void _doWrite();
+
+    /**
+     * Parses every complete packet in the receive buffer, and marks them as read.
+     */
+    void _parseReceivedBytes();
+
+    /**
+     * Makes sure there are at least the given number of free bytes after recv_write_pos,
+     * by first moving the unparsed bytes to the front of the buffer, and then growing it.
+     * The buffer never grows past RECEIVE_BUFFER_MAX_SIZE, so there may be fewer free
+     * bytes than asked for, but always enough for the rest of a packet whose size was
+     * allowed by _parseReceivedBytes.
+     */
+    void _reserveReceiveSpace(std::size_t bytes);
+
+    /**
+     * Stores any events in the received packet inside of the internal received_events
+     * vector, so they can be retrieved later by handleAllReceivedPackets. InputFrames
+     * are unpacked into the events they contain.
      * 
      * @param type Type of the packet received
+     * @param format Archive format the packet data was encoded with
      * @param data Serialized format of the data received on the network.
-     * @returns Event if the packet was an event, nullopt otherwise
      */
-    std::optional<Event> _handleReceivedPacket(PacketType type, const std::string& data);
+    void _handleReceivedPacket(PacketType type, WireFormat format, std::span<const char> data);
 
     /**
      * Classifies the error reported by boost::asio based on how we should respond to it.
@@ -148,12 +290,6 @@ private:
      * be displayed in an error message.
      */
     SocketError _classifySocketError(boost::system::error_code ec, const char* where);
-
-    /**
-     * @param bytes number of bytes to check for
-     * @returns true if the socket has received enough bytes, false otherwise
-     */
-    bool socketHasEnoughBytes(std::size_t bytes);
 };
 
 /**
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/buffer.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "shared/game/event.hpp"
+#include "shared/network/constants.hpp"
+#include "shared/network/packet.hpp"
+#include "shared/utilities/typedefs.hpp"
+
+using namespace boost::asio::ip;
+
+/**
+ * The different kinds of datagrams sent on a SnapshotChannel
+ */
+enum class DatagramType: uint16_t {
+    /// @brief Sent by the client to tell the server which endpoint to send its snapshots to
+    Hello = 1,
+    /// @brief Sent by the server, containing a packaged LoadGameState event packet
+    Snapshot = 2,
+};
+
+/**
+ * Header at the front of every datagram sent on a SnapshotChannel. Like PacketHeader,
+ * this is sent as POD in network byte order.
+ */
+struct DatagramHeader {
+    /**
+     * @param type What kind of datagram this is
+     * @param sequence Sequence number of the datagram
+     * @param eid EntityID of the client the datagram is from / to
+     */
+    DatagramHeader(DatagramType type, uint32_t sequence, EntityID eid):
+        type{type}, reserved{0}, sequence{sequence}, eid{eid} {}
+
+    /**
+     * Constructs a header from a buffer received over the network, which is
+     * assumed to be in network byte order.
+     *
+     * @param buffer Buffer containing at least sizeof(DatagramHeader) bytes
+     */
+    explicit DatagramHeader(const void* buffer) {
+        const DatagramHeader* buf_hdr = static_cast<const DatagramHeader*>(buffer);
+        this->type = static_cast<DatagramType>(ntohs(static_cast<uint16_t>(buf_hdr->type)));
+        this->reserved = 0;
+        this->sequence = ntohl(buf_hdr->sequence);
+        this->eid = ntohl(buf_hdr->eid);
+    }
+
+    /**
+     * Converts this header to network byte order. This should be called before sending
+     * over the network.
+     */
+    void to_network() {
+        this->type = static_cast<DatagramType>(htons(static_cast<uint16_t>(this->type)));
+        this->sequence = htonl(this->sequence);
+        this->eid = htonl(this->eid);
+    }
+
+    DatagramType type;
+    uint16_t reserved;
+    /// @brief Increases by one for every datagram sent to the same peer, starting at 1
+    uint32_t sequence;
+    EntityID eid;
+};
+
+/**
+ * Counters describing everything a SnapshotChannel has done
+ */
+struct SnapshotChannelStats {
+    /// @brief Number of datagrams handed to the socket
+    std::size_t datagrams_sent = 0;
+    /// @brief Number of datagrams that the loss shim threw away instead of sending
+    std::size_t datagrams_dropped = 0;
+    /// @brief Number of snapshot datagrams received and passed on
+    std::size_t datagrams_received = 0;
+    /// @brief Number of snapshot datagrams thrown away for arriving after a newer one
+    std::size_t datagrams_stale = 0;
+    /// @brief Number of snapshot datagrams that were skipped over in the sequence
+    std::size_t datagrams_missing = 0;
+    /// @brief Number of snapshot datagrams thrown away for being truncated or undecodable
+    std::size_t datagrams_malformed = 0;
+};
+
+/**
+ * Unreliable channel for game state snapshots, sent over UDP next to the TCP Session.
+ *
+ * Snapshots sent over TCP have to arrive in order, so a single lost segment holds up
+ * every snapshot after it. Snapshots sent over this channel can be lost or arrive out
+ * of order instead, and any datagram that arrives after a newer one is dropped since the
+ * newer one supersedes it (see SnapshotTracker::setReliable).
+ *
+ * The server has one channel that all clients share. Each client has its own channel,
+ * which sends Hello datagrams to the server until the first snapshot arrives, so the
+ * server knows where to send that client's snapshots.
+ *
+ * Like Session, everything here is asynchronous, and the io_context that owns the socket
+ * must be run/polled regularly, from the same thread that uses the channel.
+ */
+class SnapshotChannel : public std::enable_shared_from_this<SnapshotChannel> {
+public:
+    /**
+     * @param socket UDP socket which is already open and bound to a local port
+     */
+    explicit SnapshotChannel(udp::socket socket);
+    ~SnapshotChannel();
+
+    /**
+     * Starts receiving datagrams in the background, if it isn't already.
+     */
+    void listen();
+
+    /**
+     * @returns Local UDP port the channel is bound to
+     */
+    unsigned short getPort() const;
+
+    /**
+     * Client side: sets where the server's channel is, and which client we are.
+     *
+     * @param server Endpoint of the server's SnapshotChannel
+     * @param eid EntityID the server assigned to this client
+     */
+    void connectTo(udp::endpoint server, EntityID eid);
+
+    /**
+     * Client side: tells the server to send snapshots to this channel.
+     * Should be called repeatedly until isEstablished, since Hellos can be lost too.
+     */
+    void sendHello();
+
+    /**
+     * Client side: @returns whether a snapshot has been received from the server
+     */
+    bool isEstablished() const;
+
+    /**
+     * Server side: @returns whether the client has said hello from the given address
+     */
+    bool hasPeer(EntityID eid, const boost::asio::ip::address& addr) const;
+
+    /**
+     * Server side: forgets where to send a client's snapshots, e.g. because it reconnected
+     */
+    void removePeer(EntityID eid);
+
+    /**
+     * Server side: sends one packaged snapshot chunk to a client.
+     *
+     * @param eid Client to send to
+     * @param packet Packaged LoadGameState event packet
+     * @returns false if the client hasn't said hello, or the packet is too big for a
+     * datagram, in which case it has to be sent some other way
+     */
+    bool sendSnapshot(EntityID eid, std::shared_ptr<PackagedPacket> packet);
+
+    /**
+     * Client side: takes every event received since the last call, in the order received.
+     */
+    std::vector<Event> takeReceivedEvents();
+
+    /**
+     * Installs a function that is asked about every datagram before it is sent, and
+     * throws it away instead of sending it if the function returns true. Used to
+     * simulate packet loss.
+     *
+     * @param should_drop Function of the datagram's type and sequence number
+     */
+    void setLossShim(std::function<bool(DatagramType, uint32_t)> should_drop);
+
+    /**
+     * @returns Counters of everything this channel has done
+     */
+    const SnapshotChannelStats& getStats() const;
+
+private:
+    /**
+     * Starts an async_receive_from on the socket, if there isn't already one outstanding.
+     */
+    void _doReceive();
+
+    /**
+     * Handles a single datagram sitting in recv_buffer.
+     */
+    void _handleDatagram(std::size_t bytes);
+
+    /**
+     * Sends a datagram made up of the header, followed by the packet if there is one.
+     */
+    void _send(const udp::endpoint& to, DatagramHeader hdr, std::shared_ptr<PackagedPacket> packet);
+
+    /**
+     * Where the server sends a single client's snapshots
+     */
+    struct Peer {
+        udp::endpoint endpoint;
+        uint32_t next_sequence;
+    };
+
+    udp::socket socket;
+
+    /// @brief true while an async_receive_from is outstanding
+    bool receiving;
+
+    /// @brief Buffer that async_receive_from reads into
+    std::array<char, MAX_DATAGRAM_BYTES> recv_buffer;
+
+    /// @brief Endpoint that the datagram in recv_buffer came from
+    udp::endpoint recv_endpoint;
+
+    /// @brief Server side: where to send each client's snapshots, by client EntityID
+    std::unordered_map<EntityID, Peer> peers;
+
+    /// @brief Client side: where the server's channel is
+    std::optional<udp::endpoint> server;
+
+    /// @brief Client side: which client we are
+    EntityID eid;
+
+    /// @brief Client side: sequence number to give the next Hello
+    uint32_t next_hello_sequence;
+
+    /// @brief Client side: sequence number of the newest snapshot datagram received,
+    /// or 0 if none have been
+    uint32_t newest_sequence;
+
+    /// @brief Client side: events received but not taken by takeReceivedEvents
+    std::vector<Event> received_events;
+
+    std::function<bool(DatagramType, uint32_t)> loss_shim;
+
+    SnapshotChannelStats stats;
+};
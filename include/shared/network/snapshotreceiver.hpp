@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "shared/game/sharedgamestate.hpp"
+
+/**
+ * Keeps track of which snapshot chunks a client has received, so that it knows which
+ * chunks are out of date and which snapshot it can acknowledge.
+ *
+ * Snapshot chunks can arrive out of order and some may never arrive at all when they are
+ * sent over the SnapshotChannel. Every snapshot sent that way repeats whatever was in the
+ * unacknowledged snapshots before it (see SnapshotTracker::setReliable), so:
+ * - Chunks of a snapshot older than the newest one seen are out of date, and must not be
+ *   applied on top of the newer state.
+ * - Once every chunk of a snapshot has arrived, it can be acknowledged, and doing so
+ *   acknowledges everything before it too.
+ */
+class SnapshotReceiver {
+public:
+    SnapshotReceiver();
+
+    /**
+     * Records that a snapshot chunk has arrived.
+     *
+     * @param chunk Chunk received from the server
+     * @returns true if the chunk should be applied, or false if it is out of date
+     */
+    bool accept(const SharedGameState& chunk);
+
+    /**
+     * @returns Id of the newest snapshot that has been completely received since the
+     * last call, or 0 if there isn't one
+     */
+    uint32_t takeAck();
+
+private:
+    /// @brief Newest snapshot id seen
+    uint32_t newest_id;
+
+    /// @brief Which chunks of the newest snapshot have arrived
+    std::vector<bool> chunks_received;
+
+    /// @brief Number of chunks of the newest snapshot that haven't arrived yet
+    uint32_t chunks_missing;
+
+    /// @brief Newest snapshot id that has completely arrived
+    uint32_t complete_id;
+
+    /// @brief Snapshot id last returned by takeAck
+    uint32_t acked_id;
+};
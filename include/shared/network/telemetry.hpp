@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+
+#include <nlohmann/json.hpp>
+
+#include "shared/game/event.hpp"
+#include "shared/network/packet.hpp"
+
+/**
+ * Number of things of one kind that went over the network, and how big they were
+ */
+struct TrafficCounter {
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+
+    void add(std::size_t bytes);
+    void merge(const TrafficCounter& other);
+};
+
+/**
+ * What a Session (or a whole Server, when added up) has sent and received, broken down by
+ * PacketType and EventType, so that it is clear what is using up bandwidth.
+ *
+ * Packets are counted as sent when they are handed to the Session, not when they are
+ * written out. Events bundled into an InputFrame are counted by type, but their bytes
+ * are only counted towards the InputFrame that carried them.
+ */
+struct NetworkTelemetry {
+    std::map<PacketType, TrafficCounter> sent_by_packet;
+    std::map<PacketType, TrafficCounter> received_by_packet;
+    std::map<EventType, TrafficCounter> sent_by_event;
+    std::map<EventType, TrafficCounter> received_by_event;
+
+    /// @brief Time spent serializing packets sent. Packets shared between sessions are
+    /// only counted by whoever serialized them (see Server::getLastTickTelemetry)
+    std::chrono::nanoseconds serialize_time {0};
+    /// @brief Time spent deserializing packets received
+    std::chrono::nanoseconds deserialize_time {0};
+
+    /// @brief Most bytes that were waiting in the send queue at once
+    std::size_t max_send_queue_bytes = 0;
+    std::size_t largest_packet_sent = 0;
+    std::size_t largest_packet_received = 0;
+
+    /**
+     * Counts a packet that is being sent
+     */
+    void recordSent(const PackagedPacket& packet);
+
+    /**
+     * Counts a packet that has been received
+     *
+     * @param type Type of the packet
+     * @param bytes Size of the packet, including its header
+     */
+    void recordReceived(PacketType type, std::size_t bytes);
+
+    /**
+     * Adds another set of counters to these, e.g. to add up every session or several ticks
+     */
+    void merge(const NetworkTelemetry& other);
+
+    std::size_t totalBytesSent() const;
+    std::size_t totalBytesReceived() const;
+
+    /**
+     * @returns The counters as a JSON object, with types given by name and times in
+     * milliseconds
+     */
+    nlohmann::json toJson() const;
+};
+
+std::ostream& operator<<(std::ostream& os, const PacketType& type);
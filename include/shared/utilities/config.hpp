@@ -45,6 +45,35 @@ struct GameConfig {
         } maze;
         /// @brief whether or not to disable enemy spawns
         bool disable_enemies;
+        /**
+         * @brief Byte budget for each game state packet sent to clients. Game state
+         * snapshots larger than this are split up across multiple packets.
+         */
+        std::size_t max_packet_bytes;
+        /**
+         * @brief Radius, in GridCells, around each player within which objects are sent
+         * to that player. The Dungeon Master always gets the whole map. If not positive,
+         * every player gets the whole map.
+         */
+        int interest_radius;
+        /**
+         * @brief Whether to send game state snapshots over UDP, so that a lost packet
+         * doesn't hold up every snapshot after it. Everything else still goes over TCP.
+         */
+        bool udp_snapshots;
+        struct {
+            /**
+             * @brief How many ticks of network telemetry to add up before writing it
+             * out. If not positive, no telemetry is written.
+             */
+            int interval_ticks;
+
+            /**
+             * @brief File to append telemetry to, one JSON object per line. If empty,
+             * it is written to stdout instead.
+             */
+            std::string file;
+        } telemetry;
     } server;
     /// @brief Config settings for the client
     struct {
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "shared/utilities/typedefs.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief Set of EntityIDs stored as a bitset indexed by EntityID.
+ *
+ * EntityIDs are handed out densely by ObjectManager, so this takes one bit per
+ * object in the game, and inserting, looking up and erasing are a single bit
+ * operation with no hashing or allocation (once the bitset is big enough).
+ * Iterating visits the EntityIDs in increasing order, skipping empty runs 64
+ * at a time.
+ */
+class EntitySet {
+public:
+	/**
+	 * @brief Marks the end of iteration over an EntitySet.
+	 */
+	struct Sentinel {};
+
+	/**
+	 * @brief Iterates over the EntityIDs in an EntitySet in increasing order.
+	 * The set must not be changed while iterating.
+	 */
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = EntityID;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = EntityID;
+
+		explicit Iterator(const EntitySet* set) :
+			set(set), word(0), bits(0), current(0)
+		{
+			if (!set->words.empty()) {
+				bits = set->words[0];
+			}
+			findNext();
+		}
+
+		EntityID operator*() const {
+			return static_cast<EntityID>(current);
+		}
+
+		Iterator& operator++() {
+			bits &= bits - 1;
+			findNext();
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator previous = *this;
+			++(*this);
+			return previous;
+		}
+
+		bool operator==(Sentinel) const {
+			return word >= set->words.size();
+		}
+
+	private:
+		/**
+		 * @brief Moves current to the lowest EntityID left in bits, reading in
+		 * the following words if there aren't any.
+		 */
+		void findNext() {
+			while (bits == 0) {
+				if (++word >= set->words.size()) {
+					return;
+				}
+				bits = set->words[word];
+			}
+			current = word * BITS_PER_WORD + std::countr_zero(bits);
+		}
+
+		const EntitySet* set;
+		std::size_t word;
+		//	EntityIDs in the current word that are still to be visited
+		uint64_t bits;
+		std::size_t current;
+	};
+
+	/**
+	 * @brief Adds the given EntityID to the set.
+	 * @return true if it wasn't in the set already.
+	 */
+	bool insert(EntityID id) {
+		std::size_t word = id / BITS_PER_WORD;
+		if (word >= this->words.size()) {
+			this->words.resize(word + 1, 0);
+		}
+
+		uint64_t bit = uint64_t(1) << (id % BITS_PER_WORD);
+		if ((this->words[word] & bit) != 0) {
+			return false;
+		}
+
+		this->words[word] |= bit;
+		this->count++;
+		return true;
+	}
+
+	/**
+	 * @brief Removes the given EntityID from the set.
+	 * @return true if it was in the set.
+	 */
+	bool erase(EntityID id) {
+		if (!this->contains(id)) {
+			return false;
+		}
+
+		this->words[id / BITS_PER_WORD] &= ~(uint64_t(1) << (id % BITS_PER_WORD));
+		this->count--;
+		return true;
+	}
+
+	bool contains(EntityID id) const {
+		std::size_t word = id / BITS_PER_WORD;
+		return word < this->words.size() &&
+			(this->words[word] & (uint64_t(1) << (id % BITS_PER_WORD))) != 0;
+	}
+
+	/**
+	 * @brief Empties the set, keeping its memory for the next time it is filled.
+	 */
+	void clear() {
+		std::fill(this->words.begin(), this->words.end(), 0);
+		this->count = 0;
+	}
+
+	bool empty() const {
+		return this->count == 0;
+	}
+
+	std::size_t size() const {
+		return this->count;
+	}
+
+	Iterator begin() const {
+		return Iterator(this);
+	}
+
+	Sentinel end() const {
+		return Sentinel();
+	}
+
+private:
+	static constexpr std::size_t BITS_PER_WORD = 64;
+
+	//	Bit i of word w is set if EntityID w * 64 + i is in the set
+	std::vector<uint64_t> words;
+	std::size_t count = 0;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Set of 64-bit keys kept in a single open-addressed array.
+ *
+ * Meant for sets that are filled and cleared over and over (e.g. once a tick):
+ * clearing keeps the array, so once it is big enough inserting never allocates,
+ * unlike std::unordered_set which allocates a node for every key. The largest
+ * uint64_t is used to mark empty slots, so it can't be put in the set.
+ */
+class KeySet {
+public:
+	/**
+	 * @brief Adds the given key to the set.
+	 * @return true if it wasn't in the set already.
+	 */
+	bool insert(uint64_t key) {
+		//	Keep at most half of the slots full, so that probing stays short
+		if ((this->count + 1) * 2 > this->slots.size()) {
+			this->grow();
+		}
+
+		std::size_t slot = this->find(key);
+		if (this->slots[slot] == key) {
+			return false;
+		}
+
+		this->slots[slot] = key;
+		this->count++;
+		return true;
+	}
+
+	bool contains(uint64_t key) const {
+		return !this->slots.empty() && this->slots[this->find(key)] == key;
+	}
+
+	/**
+	 * @brief Empties the set, keeping its memory for the next time it is filled.
+	 */
+	void clear() {
+		if (this->count > 0) {
+			std::fill(this->slots.begin(), this->slots.end(), EMPTY);
+			this->count = 0;
+		}
+	}
+
+	bool empty() const {
+		return this->count == 0;
+	}
+
+	std::size_t size() const {
+		return this->count;
+	}
+
+private:
+	static constexpr uint64_t EMPTY = ~uint64_t(0);
+	static constexpr std::size_t MIN_SLOTS = 64;
+
+	/**
+	 * @brief Returns the slot that holds the given key, or the empty slot where
+	 * it would go.
+	 */
+	std::size_t find(uint64_t key) const {
+		std::size_t mask = this->slots.size() - 1;
+		//	Fibonacci hashing, so that keys that only differ in their low bits
+		//	(like consecutive EntityIDs) still spread out
+		std::size_t slot = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+		while (this->slots[slot] != key && this->slots[slot] != EMPTY) {
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	/**
+	 * @brief Doubles the number of slots (which is always a power of 2) and
+	 * puts the keys back in.
+	 */
+	void grow() {
+		std::vector<uint64_t> old = std::move(this->slots);
+		this->slots.assign(std::max(old.size() * 2, MIN_SLOTS), EMPTY);
+
+		for (uint64_t key : old) {
+			if (key != EMPTY) {
+				this->slots[this->find(key)] = key;
+			}
+		}
+	}
+
+	std::vector<uint64_t> slots;
+	std::size_t count = 0;
+};
@@ -0,0 +1,164 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/archive/basic_archive.hpp>
+#include <boost/archive/binary_iarchive_impl.hpp>
+#include <boost/archive/binary_oarchive_impl.hpp>
+#include <boost/archive/detail/register_archive.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+
+/**
+ * Width that an arithmetic value is written with by the portable binary archives.
+ *
+ * The plain boost binary archives write every value with its native width, so a
+ * std::size_t or long written by a 64-bit Linux build is 8 bytes while a Windows
+ * build reads it back as 4. Every type whose width differs between the platforms
+ * we build for is widened to a fixed-width type instead. The rest already have
+ * the same width everywhere and are written as they are.
+ */
+template <class T>
+using PortableWireType =
+    std::conditional_t<std::is_same_v<T, wchar_t>, uint32_t,
+    std::conditional_t<std::is_same_v<T, long> || std::is_same_v<T, long long>, int64_t,
+    std::conditional_t<std::is_same_v<T, unsigned long> || std::is_same_v<T, unsigned long long>, uint64_t,
+    T>>>;
+
+/**
+ * Reverses the bytes of a value if the host is big-endian, so that the bytes
+ * on the wire are always little-endian.
+ */
+inline void toLittleEndian(void* value, std::size_t size) {
+    if constexpr (std::endian::native == std::endian::big) {
+        auto bytes = static_cast<unsigned char*>(value);
+        for (std::size_t i = 0; i < size / 2; i++) {
+            std::swap(bytes[i], bytes[size - 1 - i]);
+        }
+    }
+}
+
+/**
+ * boost binary archive that writes arithmetic values (and the sizes of strings and
+ * collections) in little-endian with the same width on every platform, so that
+ * clients and servers built for different platforms can read each other's packets.
+ * Never writes the archive header, as the WireFormat of a packet is already in
+ * its PacketHeader.
+ */
+class PortableBinaryOArchive :
+    public boost::archive::binary_oarchive_impl<PortableBinaryOArchive, char, std::char_traits<char>> {
+public:
+    explicit PortableBinaryOArchive(std::ostream& os):
+        binary_oarchive_impl(os, boost::archive::no_header)
+    {
+        this->init(boost::archive::no_header);
+    }
+
+    explicit PortableBinaryOArchive(std::streambuf& buffer):
+        binary_oarchive_impl(buffer, boost::archive::no_header)
+    {
+        this->init(boost::archive::no_header);
+    }
+
+    /**
+     * @returns The streambuf that the archive writes to, so that another archive can
+     * write to the same place
+     */
+    std::streambuf& getStreambuf() {
+        return this->m_sb;
+    }
+
+protected:
+    friend class boost::archive::detail::interface_oarchive<PortableBinaryOArchive>;
+    friend class boost::archive::basic_binary_oarchive<PortableBinaryOArchive>;
+    friend class boost::archive::basic_binary_oprimitive<PortableBinaryOArchive, char, std::char_traits<char>>;
+    friend class boost::archive::save_access;
+
+    using Primitive = boost::archive::basic_binary_oprimitive<PortableBinaryOArchive, char, std::char_traits<char>>;
+
+    template <class T>
+    void save(const T& t) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            auto wire = static_cast<PortableWireType<T>>(t);
+            toLittleEndian(&wire, sizeof(wire));
+            this->save_binary(&wire, sizeof(wire));
+        } else {
+            this->Primitive::save(t);
+        }
+    }
+
+    void save(const boost::serialization::collection_size_type& t) {
+        this->save(static_cast<uint64_t>(static_cast<std::size_t>(t)));
+    }
+};
+
+/**
+ * Reads what PortableBinaryOArchive writes. Throws a boost::archive::archive_exception
+ * if a value doesn't fit in the type it is read into on this platform.
+ */
+class PortableBinaryIArchive :
+    public boost::archive::binary_iarchive_impl<PortableBinaryIArchive, char, std::char_traits<char>> {
+public:
+    explicit PortableBinaryIArchive(std::istream& is):
+        binary_iarchive_impl(is, boost::archive::no_header)
+    {
+        this->init(boost::archive::no_header);
+    }
+
+    explicit PortableBinaryIArchive(std::streambuf& buffer):
+        binary_iarchive_impl(buffer, boost::archive::no_header)
+    {
+        this->init(boost::archive::no_header);
+    }
+
+    /**
+     * @returns The streambuf that the archive reads from, so that another archive can
+     * read from the same place
+     */
+    std::streambuf& getStreambuf() {
+        return this->m_sb;
+    }
+
+protected:
+    friend class boost::archive::detail::interface_iarchive<PortableBinaryIArchive>;
+    friend class boost::archive::basic_binary_iarchive<PortableBinaryIArchive>;
+    friend class boost::archive::basic_binary_iprimitive<PortableBinaryIArchive, char, std::char_traits<char>>;
+    friend class boost::archive::load_access;
+
+    using Primitive = boost::archive::basic_binary_iprimitive<PortableBinaryIArchive, char, std::char_traits<char>>;
+
+    template <class T>
+    void load(T& t) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            PortableWireType<T> wire;
+            this->load_binary(&wire, sizeof(wire));
+            toLittleEndian(&wire, sizeof(wire));
+
+            t = static_cast<T>(wire);
+            // only integers can be narrowed (and NaN never compares equal to itself)
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<PortableWireType<T>, T>) {
+                if (static_cast<PortableWireType<T>>(t) != wire) {
+                    throw boost::archive::archive_exception(
+                        boost::archive::archive_exception::incompatible_native_format, "value out of range");
+                }
+            }
+        } else {
+            this->Primitive::load(t);
+        }
+    }
+
+    void load(boost::serialization::collection_size_type& t) {
+        std::size_t size;
+        this->load(size);
+        t = boost::serialization::collection_size_type(size);
+    }
+};
+
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(PortableBinaryOArchive)
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(PortableBinaryIArchive)
@@ -1,47 +1,282 @@
 #pragma once
+#include <algorithm>
 #include <string>
 #include <sstream>
+#include <locale>
+#include <streambuf>
+#include <span>
+#include <cstdint>
+#include <stdexcept>
 
 #include <glm/glm.hpp>
 
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
+#include <boost/math/special_functions/nonfinite_num_facets.hpp>
+
+#include "shared/utilities/portablearchive.hpp"
+
+/**
+ * The different archive formats that serialize / deserialize know how to speak.
+ * The format a packet was encoded with is sent along in its PacketHeader, so the
+ * receiving side always knows which archive to use to decode it.
+ */
+enum class WireFormat: uint16_t {
+    /// @brief boost text archive. Human readable, but every number is turned into
+    /// decimal text, so it is slow and several times larger than it needs to be.
+    Text = 1,
+    /// @brief boost binary archive without the archive header. Values are written in
+    /// little-endian with the same width on every platform (see PortableBinaryOArchive).
+    Binary = 2,
+};
+
+/// @brief Format used when no format is explicitly requested
+#define DEFAULT_WIRE_FORMAT WireFormat::Binary
+
+/**
+ * The WireFormat that an archive class reads or writes, for serialize functions
+ * that encode part of an object in an archive of its own (e.g. Event)
+ */
+template <class Archive>
+struct ArchiveWireFormat;
+
+template <>
+struct ArchiveWireFormat<PortableBinaryOArchive> {
+    static constexpr WireFormat value = WireFormat::Binary;
+};
+
+template <>
+struct ArchiveWireFormat<PortableBinaryIArchive> {
+    static constexpr WireFormat value = WireFormat::Binary;
+};
+
+template <>
+struct ArchiveWireFormat<boost::archive::text_oarchive> {
+    static constexpr WireFormat value = WireFormat::Text;
+};
+
+template <>
+struct ArchiveWireFormat<boost::archive::text_iarchive> {
+    static constexpr WireFormat value = WireFormat::Text;
+};
 
 /**
  * Helper function to easily serialize a packet/events's data into a string
  * to send over the network.
- * 
+ *
  * @param obj object that you want to serialize to send across the network.
  * This should not include any header information, it should strictly be a struct
  * for packet data.
+ * @param format Archive format to encode obj with.
+ * @throws std::invalid_argument if format isn't one of the WireFormats
  */
 template<class Type>
-std::string serialize(const Type& obj) {
+std::string serialize(const Type& obj, WireFormat format = DEFAULT_WIRE_FORMAT) {
     std::ostringstream archive_stream;
-    {
+    if (format == WireFormat::Binary) {
+        PortableBinaryOArchive archive(archive_stream);
+        archive << obj;
+    } else if (format == WireFormat::Text) {
+        // plain streams write NaN and infinity in a way they can't read back
+        archive_stream.imbue(std::locale(archive_stream.getloc(), new boost::math::nonfinite_num_put<char>));
         boost::archive::text_oarchive archive(archive_stream);
         archive << obj;
+    } else {
+        throw std::invalid_argument("Unknown WireFormat " + std::to_string(static_cast<int>(format)));
     }
     return archive_stream.str();
 }
 
 /**
- * Helper function to easily deserialize a string received over the network into
- * a obj.
- * 
- * @param data String representation of a serialized obj recieved across the network.
+ * Read-only std::streambuf over memory that is owned by someone else, so that archives
+ * can read straight out of a network buffer without copying it anywhere first.
+ */
+class SpanStreambuf : public std::streambuf {
+public:
+    explicit SpanStreambuf(std::span<const char> data) {
+        // std::streambuf wants non-const pointers, but the get area is never written to
+        char* begin = const_cast<char*>(data.data());
+        this->setg(begin, begin, begin + data.size());
+    }
+};
+
+/**
+ * Read-only std::streambuf that reads at most a given number of bytes from another
+ * streambuf, so that an archive reading part of another archive's data can't read
+ * past the end of its part.
+ */
+class BoundedStreambuf : public std::streambuf {
+public:
+    BoundedStreambuf(std::streambuf& source, std::size_t limit):
+        source(source), remaining(limit) {}
+
+    /**
+     * @returns How many of the bytes this was limited to haven't been read yet
+     */
+    std::size_t getRemaining() const {
+        return this->remaining;
+    }
+
+    /**
+     * Reads and throws away the bytes that haven't been read yet
+     * @returns false if the source ran out before all of them were read
+     */
+    bool skipRemaining() {
+        char discard[256];
+        while (this->remaining > 0) {
+            auto chunk = static_cast<std::streamsize>(std::min(this->remaining, sizeof(discard)));
+            if (this->sgetn(discard, chunk) != chunk) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+protected:
+    std::streamsize xsgetn(char* data, std::streamsize n) override {
+        n = std::min(n, static_cast<std::streamsize>(this->remaining));
+        std::streamsize read = this->source.sgetn(data, n);
+        this->remaining -= static_cast<std::size_t>(read);
+        return read;
+    }
+
+    int_type underflow() override {
+        return this->remaining == 0 ? traits_type::eof() : this->source.sgetc();
+    }
+
+    int_type uflow() override {
+        if (this->remaining == 0) {
+            return traits_type::eof();
+        }
+        int_type ch = this->source.sbumpc();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            this->remaining--;
+        }
+        return ch;
+    }
+
+private:
+    std::streambuf& source;
+    std::size_t remaining;
+};
+
+/**
+ * Deserializes an obj out of a streambuf, reading only as much as it needs.
+ *
+ * @param buffer Where to read the serialized obj from
+ * @param obj Where to put what was read
+ * @param format Archive format that the obj was encoded with.
+ * @throws std::invalid_argument if format isn't one of the WireFormats, and
+ * boost::archive::archive_exception if the obj can't be decoded
  */
 template <class Type>
-Type deserialize(std::string data) {
-    Type parsed_info;
-    {
-        std::istringstream stream(data);
+void deserializeInto(std::streambuf& buffer, Type& obj, WireFormat format = DEFAULT_WIRE_FORMAT) {
+    if (format == WireFormat::Binary) {
+        PortableBinaryIArchive archive(buffer);
+        archive >> obj;
+    } else if (format == WireFormat::Text) {
+        std::istream stream(&buffer);
+        stream.imbue(std::locale(stream.getloc(), new boost::math::nonfinite_num_get<char>));
         boost::archive::text_iarchive archive(stream);
-        archive >> parsed_info;
+        archive >> obj;
+    } else {
+        throw std::invalid_argument("Unknown WireFormat " + std::to_string(static_cast<int>(format)));
     }
+}
+
+/**
+ * Deserializes bytes into an existing obj, reading them in place.
+ *
+ * @param data Serialized obj. Must stay alive for the duration of the call.
+ * @param obj Where to put what was read
+ * @param format Archive format that data was encoded with.
+ * @throws std::invalid_argument if format isn't one of the WireFormats, and
+ * boost::archive::archive_exception if data can't be decoded
+ */
+template <class Type>
+void deserializeInto(std::span<const char> data, Type& obj, WireFormat format = DEFAULT_WIRE_FORMAT) {
+    SpanStreambuf buffer(data);
+    deserializeInto(buffer, obj, format);
+}
+
+/**
+ * Helper function to easily deserialize bytes received over the network into
+ * a obj, reading them in place.
+ *
+ * @param data Serialized obj recieved across the network. Must stay alive for
+ * the duration of the call.
+ * @param format Archive format that data was encoded with.
+ */
+template <class Type>
+Type deserialize(std::span<const char> data, WireFormat format = DEFAULT_WIRE_FORMAT) {
+    Type parsed_info;
+    deserializeInto(data, parsed_info, format);
     return parsed_info; // cppcheck-suppress uninitStructMember
 }
 
+/**
+ * Helper function to easily deserialize a string received over the network into
+ * a obj.
+ *
+ * @param data String representation of a serialized obj recieved across the network.
+ * @param format Archive format that data was encoded with.
+ */
+template <class Type>
+Type deserialize(const std::string& data, WireFormat format = DEFAULT_WIRE_FORMAT) {
+    return deserialize<Type>(std::span<const char>(data.data(), data.size()), format);
+}
+
+/**
+ * Measures how many bytes values take up when serialized with WireFormat::Binary,
+ * without actually storing the bytes anywhere.
+ *
+ * Values are measured as if they were all written one after another into the same
+ * archive, so the first value of each class also counts the class information the
+ * archive writes for it, and later values of that class do not.
+ */
+class SerializedSizeCounter {
+public:
+    SerializedSizeCounter(): archive(counter) {}
+
+    /**
+     * @param obj Value to write into the archive
+     * @returns How many bytes writing obj added to the archive
+     */
+    template<class Type>
+    std::size_t add(const Type& obj) {
+        std::size_t before = this->counter.count;
+        this->archive << obj;
+        return this->counter.count - before;
+    }
+
+    /**
+     * @returns Total number of bytes written to the archive so far
+     */
+    std::size_t total() const {
+        return this->counter.count;
+    }
+
+private:
+    /// @brief streambuf that throws away everything written to it, only counting the bytes
+    struct CountingStreambuf : public std::streambuf {
+        std::size_t count = 0;
+
+    protected:
+        std::streamsize xsputn(const char* data, std::streamsize n) override {
+            count += n;
+            return n;
+        }
+
+        int_type overflow(int_type ch) override {
+            count++;
+            return traits_type::not_eof(ch);
+        }
+    };
+
+    CountingStreambuf counter;
+    PortableBinaryOArchive archive;
+};
+
 namespace  boost {
     namespace serialization {
         /**
@@ -53,4 +288,4 @@ namespace  boost {
             ar & vec.x & vec.y & vec.z;
         }
     }
-}
\ No newline at end of file
+}
@@ -2,6 +2,12 @@
 
 #include "shared/utilities/serialize_macro.hpp"
 
+#include <boost/serialization/split_member.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <vector>
 #include <unordered_set>
 
@@ -10,11 +16,105 @@
  * either to the end of the wrapped vector if it is full or places them in gaps.
  * @tparam T Type that the wrapped vector will store.
  * 
+ * Which indices are in use is kept in a bitset, so that iterating over a
+ * SmartVector can skip over whole runs of gaps at once, and the gaps are kept
+ * in a stack, so that pushing into one doesn't have to search for it.
+ *
  * NOTE: T must be a pointer type currently!
  */
 template<typename T>
 class SmartVector {
 public:
+	/**
+	 * @brief Marks the end of iteration over a SmartVector.
+	 */
+	struct Sentinel {};
+
+	/**
+	 * @brief Iterates over the objects in a SmartVector in index order,
+	 * skipping over any gaps 64 indices at a time.
+	 *
+	 * Objects removed while iterating are skipped if they haven't been reached
+	 * yet. Objects pushed while iterating are visited if they land past the
+	 * 64 indices the iterator is currently in.
+	 */
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = T;
+
+		Iterator(const SmartVector* vector, size_t index) :
+			vector(vector), word(index / BITS_PER_WORD), bits(0), current(END)
+		{
+			if (word < vector->in_use.size()) {
+				bits = vector->in_use[word] & (~uint64_t(0) << (index % BITS_PER_WORD));
+			}
+			findNext();
+		}
+
+		T operator*() const {
+			return vector->wrapped_vector[current];
+		}
+
+		Iterator& operator++() {
+			//	Drop the current index, and anything removed since this word was
+			//	read
+			bits &= bits - 1;
+			bits &= vector->in_use[word];
+			findNext();
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator previous = *this;
+			++(*this);
+			return previous;
+		}
+
+		bool operator==(const Iterator& other) const {
+			return current == other.current;
+		}
+
+		bool operator==(Sentinel) const {
+			return current == END;
+		}
+
+		/**
+		 * @brief Returns the index in the SmartVector of the object this
+		 * iterator is on.
+		 */
+		size_t index() const {
+			return current;
+		}
+
+	private:
+		static constexpr size_t END = SIZE_MAX;
+
+		/**
+		 * @brief Moves current to the lowest index left in bits, reading in
+		 * the following words of the bitset if there aren't any.
+		 */
+		void findNext() {
+			while (bits == 0) {
+				if (++word >= vector->in_use.size()) {
+					current = END;
+					return;
+				}
+				bits = vector->in_use[word];
+			}
+			current = word * BITS_PER_WORD + std::countr_zero(bits);
+		}
+
+		const SmartVector* vector;
+		size_t word;
+		//	Indices in the current word that are still to be visited
+		uint64_t bits;
+		size_t current;
+	};
+
 	/**
 	 * @brief Creates a SmartVector instance with a maximum wrapped vector size
 	 * of the given value.
@@ -22,6 +122,7 @@ public:
 	explicit SmartVector(size_t max_size) {
 		//this->max_size = max_size;
 		this->wrapped_vector.reserve(max_size);
+		this->in_use.reserve(numWords(max_size));
 	}
 
 	SmartVector() : SmartVector(1) {}
@@ -34,24 +135,29 @@ public:
 	 */
 	size_t push(T object) {
 
-		//	See if there's an empty index
-		size_t index;
-		auto it = freelist.begin();
-		if (it != freelist.end()) {
-			index = *it;
-			freelist.erase(index);
+		//	See if there's an empty index (skipping any that have since been
+		//	filled by set())
+		while (!free_stack.empty()) {
+			size_t index = free_stack.back();
+			free_stack.pop_back();
 
-			wrapped_vector[index] = object;
+			if (!isInUse(index)) {
+				markInUse(index);
+				num_free--;
+				wrapped_vector[index] = object;
+				return index;
+			}
 		}
-		else {
-			index = wrapped_vector.size();
 
-			//	Check that the wrapped vector can be safely pushed to (without 
-			//	causing reallocation)
-			//assert(this->max_size > index);
+		size_t index = wrapped_vector.size();
 
-			wrapped_vector.push_back(object);
-		}
+		//	Check that the wrapped vector can be safely pushed to (without 
+		//	causing reallocation)
+		//assert(this->max_size > index);
+
+		wrapped_vector.push_back(object);
+		growBitset();
+		markInUse(index);
 
 		return index;
 	}
@@ -68,12 +174,11 @@ public:
 		if (index >= wrapped_vector.size())
 			return false;
 
-		//	Remove index from free list if the specified index is currently
-		//	empty
-		auto it = freelist.find(index);
-
-		if (it != freelist.end()) {
-			freelist.erase(*it);
+		//	If the index is currently empty, it stays on the free stack and is
+		//	skipped over when popped
+		if (!isInUse(index)) {
+			markInUse(index);
+			num_free--;
 		}
 
 		wrapped_vector[index] = object;
@@ -94,8 +199,10 @@ public:
 		//	causing reallocation)
 		//assert(this->max_size > index);
 
-		freelist.insert(index);
 		wrapped_vector.push_back({});
+		growBitset();
+		free_stack.push_back(index);
+		num_free++;
 
 		return index;
 	}
@@ -108,8 +215,13 @@ public:
 	bool remove(size_t index) {
 		//	Check that index is in bounds
 		if (index < wrapped_vector.size()) {
-			//	Add index to freelist
-			freelist.insert(index);
+			//	Add index to freelist (unless it is already there)
+			if (isInUse(index)) {
+				in_use[index / BITS_PER_WORD] &= ~bit(index);
+				free_stack.push_back(index);
+				num_free++;
+				wrapped_vector[index] = {};
+			}
 
 			return true;
 		}
@@ -124,33 +236,18 @@ public:
 	 * nullptr otherwise.
 	 */
 	const T get(size_t index) const {
-		//	Check that the index is in bounds
-		if (index >= wrapped_vector.size())
-		{
-			//	Index is out of bounds
-			return nullptr;
-		}
-		//	Check that index isn't free
-		if (freelist.find(index) != freelist.end()) {
-			//	Index is free
+		//	Check that the index is in bounds and isn't free
+		if (index >= wrapped_vector.size() || !isInUse(index)) {
 			return nullptr;
 		}
 
-		//	Return pointer to object stored at the given index
-		return &wrapped_vector[index];
+		return wrapped_vector[index];
 	}
 
 	// https://stackoverflow.com/questions/38790352/how-can-you-return-a-non-const-reference-to-an-element-in-a-stdvector-data-mem
 	T get(size_t index) {
-		//	Check that the index is in bounds
-		if (index >= wrapped_vector.size())
-		{
-			//	Index is out of bounds
-			return nullptr;
-		}
-		//	Check that index isn't free
-		if (freelist.find(index) != freelist.end()) {
-			//	Index is free
+		//	Check that the index is in bounds and isn't free
+		if (index >= wrapped_vector.size() || !isInUse(index)) {
 			return nullptr;
 		}
 
@@ -158,6 +255,18 @@ public:
 		return wrapped_vector[index];
 	}
 
+	/**
+	 * @brief Returns an iterator over the objects in the wrapped vector (not
+	 * including gaps), e.g. for (T object : smart_vector).
+	 */
+	Iterator begin() const {
+		return Iterator(this, 0);
+	}
+
+	Sentinel end() const {
+		return Sentinel {};
+	}
+
 	/**
 	 * @brief Returns the number of elements allocated in the wrapped vector
 	 * (including gaps)
@@ -173,14 +282,71 @@ public:
 	 * @return Number of elements in the wrapped vector not including gaps.
 	 */
 	size_t numElements() const {
-		return wrapped_vector.size() - freelist.size();
+		return wrapped_vector.size() - num_free;
+	}
+
+	/**
+	 * @brief Serialized as the wrapped vector and the set of gaps in it, same
+	 * as before the bitset and free stack existed.
+	 */
+	template<class Archive>
+	void save(Archive& ar, const unsigned int version) const {
+		std::unordered_set<size_t> freelist;
+		for (size_t index = 0; index < wrapped_vector.size(); index++) {
+			if (!isInUse(index)) {
+				freelist.insert(index);
+			}
+		}
+
+		ar& wrapped_vector& freelist;
 	}
 
-	DEF_SERIALIZE(Archive& ar, const unsigned int version) {
+	template<class Archive>
+	void load(Archive& ar, const unsigned int version) {
+		std::unordered_set<size_t> freelist;
 		ar& wrapped_vector& freelist;
+
+		in_use.assign(numWords(wrapped_vector.size()), 0);
+		for (size_t index = 0; index < wrapped_vector.size(); index++) {
+			if (!freelist.contains(index)) {
+				markInUse(index);
+			}
+		}
+		free_stack.assign(freelist.begin(), freelist.end());
+		num_free = freelist.size();
 	}
 
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+
 private:
+	static constexpr size_t BITS_PER_WORD = 64;
+
+	static size_t numWords(size_t num_bits) {
+		return (num_bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+	}
+
+	static uint64_t bit(size_t index) {
+		return uint64_t(1) << (index % BITS_PER_WORD);
+	}
+
+	bool isInUse(size_t index) const {
+		return (in_use[index / BITS_PER_WORD] & bit(index)) != 0;
+	}
+
+	void markInUse(size_t index) {
+		in_use[index / BITS_PER_WORD] |= bit(index);
+	}
+
+	/**
+	 * @brief Adds a word to the bitset if the wrapped vector has just grown
+	 * past the end of it.
+	 */
+	void growBitset() {
+		if (in_use.size() < numWords(wrapped_vector.size())) {
+			in_use.push_back(0);
+		}
+	}
+
 	/**
 	 * @brief Maximum size of the wrapped_vector (this is the capacity that its
 	 * underlying container will hold. Never push more than this amount as then 
@@ -189,5 +355,18 @@ private:
 	 */
 	//size_t max_size;
 	std::vector<T> wrapped_vector;
-	std::unordered_set<size_t> freelist;
-};
\ No newline at end of file
+
+	/**
+	 * @brief One bit per index of the wrapped vector, set if the index is in
+	 * use and clear if it is a gap.
+	 */
+	std::vector<uint64_t> in_use;
+
+	/**
+	 * @brief Gaps to push into, most recently freed on top. An index can be
+	 * filled by set() while still on the stack, so push() checks in_use before
+	 * reusing one.
+	 */
+	std::vector<size_t> free_stack;
+	size_t num_free = 0;
+};
@@ -19,4 +19,10 @@ using SpecificID = uint32_t;
  * @brief Object ID within an movable SmartVector (used by
  * ServerGameState's ObjectManager)
  */
-using MovableID = uint32_t;
\ No newline at end of file
+using MovableID = uint32_t;
+
+/**
+ * @brief Object ID within the creatures SmartVector (used by
+ * ServerGameState's ObjectManager)
+ */
+using CreatureID = uint32_t;
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 
 #include <GLFW/glfw3.h>
 #include <boost/asio/ip/tcp.hpp>
@@ -373,49 +374,49 @@ void Client::sendTrapEvent(bool hover, bool place, ModelType trapType) {
 
     switch (trapType) {
     case ModelType::FloorSpikeFull:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FloorSpikeFull, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FloorSpikeFull, hover, place)));
         break;
     case ModelType::FloorSpikeVertical:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FloorSpikeVertical, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FloorSpikeVertical, hover, place)));
         break;
     case ModelType::FloorSpikeHorizontal:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FloorSpikeHorizontal, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FloorSpikeHorizontal, hover, place)));
         break;
     case ModelType::FireballTrapUp:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapUp, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapUp, hover, place)));
         break;
     case ModelType::FireballTrapDown:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapDown, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapDown, hover, place)));
         break;
     case ModelType::FireballTrapLeft:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapLeft, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapLeft, hover, place)));
         break; 
     case ModelType::FireballTrapRight:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapRight, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::FireballTrapRight, hover, place)));
         break;
     case ModelType::ArrowTrapUp:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapUp, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapUp, hover, place)));
         break;
     case ModelType::ArrowTrapDown:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapDown, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapDown, hover, place)));
         break;
     case ModelType::ArrowTrapLeft:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapLeft, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapLeft, hover, place)));
         break;
     case ModelType::ArrowTrapRight:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapRight, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::ArrowTrapRight, hover, place)));
         break;
     case ModelType::SpikeTrap:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::SpikeTrap, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::SpikeTrap, hover, place)));
         break;
     case ModelType::TeleporterTrap:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::TeleporterTrap, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::TeleporterTrap, hover, place)));
         break;
     case ModelType::Lightning:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::Lightning, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::Lightning, hover, place)));
         break;
     case ModelType::LightCut:
-        this->session->sendEvent(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::LightCut, hover, place)));
+        this->session->addInput(Event(eid, EventType::TrapPlacement, TrapPlacementEvent(eid, this->world_pos, CellType::LightCut, hover, place)));
         break;
     }
 
@@ -482,23 +483,23 @@ void Client::idleCallback() {
     if (this->session != nullptr && this->session->getInfo().client_eid.has_value()) {
         auto eid = this->session->getInfo().client_eid.value();
 
-        this->session->sendEvent(Event(eid, EventType::ChangeFacing, ChangeFacingEvent(eid, cam->getFacing())));
+        this->session->addInput(Event(eid, EventType::ChangeFacing, ChangeFacingEvent(eid, cam->getFacing())));
 
         // Send jump action
         if (is_held_space) {
-            this->session->sendEvent(Event(eid, EventType::StartAction, StartActionEvent(eid, glm::vec3(0.0f, 1.0f, 0.0f), ActionType::Jump)));
+            this->_addMovementInput(Event(eid, EventType::StartAction, StartActionEvent(eid, glm::vec3(0.0f, 1.0f, 0.0f), ActionType::Jump)));
         }
 
         // DM not placing
         if (this->session->getInfo().is_dungeon_master.value() && !is_left_mouse_down) {
             // zoom in
             if (is_held_i) {
-                this->session->sendEvent(Event(eid, EventType::StartAction, StartActionEvent(eid, glm::vec3(0.0f, -1.0f, 0.0f), ActionType::Zoom)));
+                this->session->addInput(Event(eid, EventType::StartAction, StartActionEvent(eid, glm::vec3(0.0f, -1.0f, 0.0f), ActionType::Zoom)));
             }
 
             // zoom out
             if (is_held_o) {
-                this->session->sendEvent(Event(eid, EventType::StartAction, StartActionEvent(eid, glm::vec3(0.0f, 1.0f, 0.0f), ActionType::Zoom)));
+                this->session->addInput(Event(eid, EventType::StartAction, StartActionEvent(eid, glm::vec3(0.0f, 1.0f, 0.0f), ActionType::Zoom)));
             }
         
             auto obj = this->gameState.objects.at(eid);
@@ -549,19 +550,103 @@ void Client::idleCallback() {
 
         // If movement 0, send stopevent
         if ((sentCamMovement != cam_movement) && cam_movement == glm::vec3(0.0f)) {
-            this->session->sendEvent(Event(eid, EventType::StopAction, StopActionEvent(eid, cam_movement, ActionType::MoveCam)));
+            this->_addMovementInput(Event(eid, EventType::StopAction, StopActionEvent(eid, cam_movement, ActionType::MoveCam)));
             sentCamMovement = cam_movement;
         }
 
         // If movement detected, different from previous, send start event
         else if (sentCamMovement != cam_movement) {
-            this->session->sendEvent(Event(eid, EventType::StartAction, StartActionEvent(eid, cam_movement, ActionType::MoveCam)));
+            this->_addMovementInput(Event(eid, EventType::StartAction, StartActionEvent(eid, cam_movement, ActionType::MoveCam)));
             sentCamMovement = cam_movement;
         }
     }
 }
 
 
+void Client::sendPacketsToServer() {
+    if (this->session != nullptr) {
+        this->session->sendInputFrame();
+        this->_updatePrediction();
+    }
+}
+
+void Client::_addMovementInput(const Event& event) {
+    this->session->addInput(event);
+    this->predictor.applyInput(event);
+}
+
+void Client::_updatePrediction() {
+    double now = glfwGetTime();
+
+    // Only living players move by themselves; everything else waits for the server
+    const SessionInfo& info = this->session->getInfo();
+    boost::optional<SharedObject> self;
+    if (info.client_eid.has_value() && !info.is_dungeon_master.value_or(true) &&
+        this->gameState.phase == GamePhase::GAME) {
+        auto obj = this->gameState.objects.find(info.client_eid.value());
+        if (obj != this->gameState.objects.end() && obj->second.has_value() &&
+            obj->second->playerInfo.has_value() && obj->second->playerInfo->is_alive) {
+            self = obj->second;
+        }
+    }
+
+    if (!self.has_value()) {
+        this->predictor.stop();
+        return;
+    }
+
+    if (!this->predictor.isActive()) {
+        this->predictor.setStaticColliders(this->gameState);
+        this->predictor.reset(self->physics);
+        this->prediction_time = now;
+    }
+
+    // run as many ticks as the server would have in the time that has passed
+    const double TICK_SECONDS = std::chrono::duration<double>(TIMESTEP_LEN).count();
+    const int MAX_TICKS_PER_FRAME = 10;
+    int ticks = 0;
+    while (now - this->prediction_time >= TICK_SECONDS && ticks < MAX_TICKS_PER_FRAME) {
+        this->predictor.tick(this->session->getLastSentInputSequence());
+        this->prediction_time += TICK_SECONDS;
+        ticks++;
+    }
+    if (ticks == MAX_TICKS_PER_FRAME) {
+        // the game must have been stalled, so don't try to catch up
+        this->prediction_time = now;
+    }
+}
+
+void Client::_pollSnapshotChannel() {
+    const SessionInfo& info = this->session->getInfo();
+    if (!info.client_eid.has_value() || !info.snapshot_port.has_value()) {
+        return;
+    }
+
+    EntityID eid = info.client_eid.value();
+    if (this->snapshot_channel == nullptr) {
+        this->snapshot_channel = std::make_shared<SnapshotChannel>(
+            udp::socket(this->resolver.get_executor(), udp::endpoint(udp::v4(), 0)));
+        this->snapshot_channel->connectTo(
+            udp::endpoint(this->session->getRemoteAddress(), info.snapshot_port.value()), eid);
+        this->snapshot_channel->listen();
+        this->snapshot_channel_eid = eid;
+    } else if (this->snapshot_channel_eid != eid) {
+        // we became the DM, so the server knows us by a different id now
+        this->snapshot_channel->connectTo(
+            udp::endpoint(this->session->getRemoteAddress(), info.snapshot_port.value()), eid);
+        this->snapshot_channel_eid = eid;
+    }
+
+    // Hellos can get lost too, so keep saying hello until snapshots start arriving
+    if (!this->snapshot_channel->isEstablished()) {
+        this->snapshot_channel->sendHello();
+    }
+
+    for (const auto& event : this->snapshot_channel->takeReceivedEvents()) {
+        this->events_received.push_back(event);
+    }
+}
+
 void Client::processServerInput(bool allow_defer) {
     // probably want to put rendering logic inside of client, so that this main function
     // mimics the server one where all of the important logic is done inside of a run command
@@ -580,12 +665,58 @@ void Client::processServerInput(bool allow_defer) {
         this->events_received.push_back(event);
     }
 
+    this->_pollSnapshotChannel();
+
+    // objects that moved in the snapshots applied in this call, to be interpolated
+    std::unordered_set<EntityID> moved;
+    bool applied_snapshot = false;
+    bool walls_changed = false;
+
     while (!this->events_received.empty()) {
         const Event& event = this->events_received.front();            
 
         if (event.type == EventType::LoadGameState) {
             GamePhase old_phase = this->gameState.phase;
-            this->gameState.update(boost::get<LoadGameStateEvent>(event.data).state);
+            const SharedGameState& chunk = std::get<LoadGameStateEvent>(event.data).state;
+
+            // Keep showing what we have until the whole resync is here, and then
+            // start over from it
+            std::optional<SharedGameState> resync;
+            if (chunk.resync_id != 0) {
+                if (!this->resync_receiver.accept(chunk)) {
+                    this->events_received.pop_front();
+                    continue;
+                }
+                resync = this->resync_receiver.take();
+                this->gameState.objects.clear();
+                walls_changed = true;
+            } else if (!this->snapshot_receiver.accept(chunk)) {
+                // a chunk that was overtaken by a newer snapshot would undo it
+                this->events_received.pop_front();
+                continue;
+            }
+            const SharedGameState& update = resync.has_value() ? resync.value() : chunk;
+
+            for (const auto& [id, delta] : update.object_deltas) {
+                if (delta.has(SharedObjectField::Physics)) {
+                    moved.insert(id);
+                }
+            }
+            for (const auto& [id, obj] : update.objects) {
+                auto old_obj = this->gameState.objects.find(id);
+                if ((obj.has_value() && obj->type == ObjectType::SolidSurface) ||
+                    (old_obj != this->gameState.objects.end() && old_obj->second.has_value() &&
+                     old_obj->second->type == ObjectType::SolidSurface)) {
+                    walls_changed = true;
+                }
+                if (obj.has_value() && old_obj != this->gameState.objects.end() && old_obj->second.has_value() &&
+                    !(old_obj->second->physics == obj->physics)) {
+                    moved.insert(id);
+                }
+            }
+
+            this->gameState.update(update);
+            applied_snapshot = true;
 
             if (!this->session->getInfo().is_dungeon_master.has_value()) {
                 if (old_phase != GamePhase::GAME && this->gameState.phase == GamePhase::GAME) {
@@ -682,31 +813,37 @@ void Client::processServerInput(bool allow_defer) {
             if (self_eid.has_value()) {
                 auto self = this->gameState.objects.at(*self_eid);
                 this->audioManager->doTick(self->physics.getCenterPosition(),
-                    boost::get<LoadSoundCommandsEvent>(event.data),
+                    std::get<LoadSoundCommandsEvent>(event.data),
                     this->closest_light_sources);
             }
         } else if (event.type == EventType::UpdateLightSources) {
-            const auto& updated_light_source = boost::get<UpdateLightSourcesEvent>(event.data);
+            const auto& updated_light_source = std::get<UpdateLightSourcesEvent>(event.data);
             for (int i = 0; i < closest_light_sources.size(); i++) {
 
                 if (!updated_light_source.lightSources[i].has_value()) {
                     continue;
                 }
                 EntityID light_id = updated_light_source.lightSources[i].value().eid;
-                this->closest_light_sources[i] = this->gameState.objects[light_id];
-                if (!this->closest_light_sources[i].has_value()) {
+
+                // the light might be outside of what the server is sending us
+                auto light = this->gameState.objects.find(light_id);
+                if (light == this->gameState.objects.end() || !light->second.has_value()) {
+                    this->closest_light_sources[i] = boost::none;
                     continue;
                 }
+                this->closest_light_sources[i] = light->second;
                 // update intensity with incoming intensity 
                 this->closest_light_sources[i]->pointLightInfo->intensity = updated_light_source.lightSources[i]->intensity;
                 this->closest_light_sources[i]->pointLightInfo->is_cut = updated_light_source.lightSources[i]->is_cut;
                 this->gameState.objects.at(light_id)->pointLightInfo->is_cut = updated_light_source.lightSources[i]->is_cut;
             }
         } else if (event.type == EventType::LoadIntroCutscene) {
-            const auto& data = boost::get<LoadIntroCutsceneEvent>(event.data);
+            const auto& data = std::get<LoadIntroCutsceneEvent>(event.data);
             this->intro_cutscene = data;
             this->gui_state = GUIState::INTRO_CUTSCENE;
             this->audioManager->stopMusic(ClientMusic::MenuTheme);
+        } else if (event.type == EventType::ReconcileMovement) {
+            this->predictor.reconcile(std::get<ReconcileMovementEvent>(event.data));
         }
 
         this->events_received.pop_front();
@@ -718,6 +855,23 @@ void Client::processServerInput(bool allow_defer) {
             break;
         }
     }
+
+    if (applied_snapshot) {
+        this->interpolator.addSnapshot(this->gameState, moved, glfwGetTime());
+    }
+
+    if (walls_changed && this->predictor.isActive()) {
+        this->predictor.setStaticColliders(this->gameState);
+    }
+
+    // Let the server know what we have, so it can send us deltas against it. This is
+    // only once every chunk of a snapshot has been applied
+    uint32_t snapshot_to_ack = this->snapshot_receiver.takeAck();
+    if (snapshot_to_ack != 0) {
+        auto eid = this->session->getInfo().client_eid.value_or(0);
+        this->session->addInput(Event(eid, EventType::AckSnapshot, AckSnapshotEvent(snapshot_to_ack)));
+    }
+
     if (allow_defer && !had_to_defer) {
         defer_time -= 1ms;
         if (defer_time < MIN_DEFER_TIME) {
@@ -820,12 +974,30 @@ void Client::geometryPass() {
         objects = &this->intro_cutscene->state.objects;
     }
 
-    glm::vec3 my_pos = (*objects)[self_eid]->physics.corner;
-
     double currentTime = glfwGetTime();
     double timeElapsed = currentTime - lastTime;
     lastTime = currentTime;
 
+    // draw moving objects where they were a moment ago, smoothly between snapshots,
+    // instead of jumping to wherever the newest snapshot put them
+    bool interpolate = objects == &this->gameState.objects;
+    if (interpolate) {
+        this->interpolator.update(currentTime);
+        this->interpolator.apply(*objects);
+    }
+
+    // and draw ourselves where we are going to be, instead of a round trip ago
+    boost::optional<SharedPhysics> real_self_physics;
+    if (interpolate && this->predictor.isActive()) {
+        auto self = objects->find(self_eid);
+        if (self != objects->end() && self->second.has_value()) {
+            real_self_physics = self->second->physics;
+            self->second->physics.corner = this->predictor.getCorner();
+        }
+    }
+
+    glm::vec3 my_pos = (*objects)[self_eid]->physics.corner;
+
     // draw all objects to g-buffer
     for (auto& [id, sharedObject] : *objects) {
         if (!sharedObject.has_value()) {
@@ -1285,6 +1457,15 @@ void Client::geometryPass() {
                 break;
         }
     }
+
+    // put the real poses back so the next snapshot applies on top of them
+    if (real_self_physics.has_value()) {
+        (*objects)[self_eid]->physics = real_self_physics.value();
+    }
+    if (interpolate) {
+        this->interpolator.restore(*objects);
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glUseProgram(0);
 }
@@ -1592,7 +1773,7 @@ void Client::keyCallback(GLFWwindow *window, int key, int scancode, int action,
         case GLFW_KEY_E:
             if (eid.has_value()) {
                 if (is_dm.has_value() && !is_dm.value()) {
-                    this->session->sendEvent(Event(eid.value(), EventType::UseItem, UseItemEvent(eid.value())));
+                    this->session->addInput(Event(eid.value(), EventType::UseItem, UseItemEvent(eid.value())));
                 }
             }
             break;
@@ -1600,7 +1781,7 @@ void Client::keyCallback(GLFWwindow *window, int key, int scancode, int action,
         case GLFW_KEY_Q:
             if (eid.has_value()) {
                 if (is_dm.has_value() && !is_dm.value()) {
-                    this->session->sendEvent(Event(eid.value(), EventType::DropItem, DropItemEvent(eid.value())));
+                    this->session->addInput(Event(eid.value(), EventType::DropItem, DropItemEvent(eid.value())));
                 }
             }
             break;
@@ -1614,14 +1795,14 @@ void Client::keyCallback(GLFWwindow *window, int key, int scancode, int action,
         case GLFW_KEY_RIGHT:
             if (eid.has_value()) {
                 if (is_dm.has_value() && is_dm.value()) {
-                    this->session->sendEvent(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), 1)));
+                    this->session->addInput(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), 1)));
                 }
             }
             break;
         case GLFW_KEY_LEFT:
             if (eid.has_value()) {
                 if (is_dm.has_value() && is_dm.value()) {
-                    this->session->sendEvent(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), -1)));
+                    this->session->addInput(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), -1)));
                 }
             }
             break;
@@ -1663,7 +1844,7 @@ void Client::keyCallback(GLFWwindow *window, int key, int scancode, int action,
         /* Send an event to start 'shift' movement (i.e. sprint) */
         case GLFW_KEY_LEFT_SHIFT:
             if (eid.has_value()) {
-                this->session->sendEvent(Event(eid.value(), EventType::StartAction, StartActionEvent(eid.value(), glm::vec3(0.0f), ActionType::Sprint)));
+                this->_addMovementInput(Event(eid.value(), EventType::StartAction, StartActionEvent(eid.value(), glm::vec3(0.0f), ActionType::Sprint)));
             }
 
             break;
@@ -1713,7 +1894,7 @@ void Client::keyCallback(GLFWwindow *window, int key, int scancode, int action,
 
         case GLFW_KEY_LEFT_SHIFT:
             if (eid.has_value()) {
-                this->session->sendEvent(Event(eid.value(), EventType::StopAction, StopActionEvent(eid.value(), glm::vec3(0.0f), ActionType::Sprint)));
+                this->_addMovementInput(Event(eid.value(), EventType::StopAction, StopActionEvent(eid.value(), glm::vec3(0.0f), ActionType::Sprint)));
             }
             break;
 
@@ -1761,7 +1942,7 @@ void Client::scrollCallback(GLFWwindow* window, double xoffset, double yoffset)
     auto self = this->gameState.objects.at(eid.value());
 
     if (yoffset >= 1) {
-        this->session->sendEvent(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), -1)));
+        this->session->addInput(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), -1)));
 
         if (is_dm.has_value() && is_dm.value()) {
             // optimistic update on scroll, otherwise might lag
@@ -1778,7 +1959,7 @@ void Client::scrollCallback(GLFWwindow* window, double xoffset, double yoffset)
     }
 
     if (yoffset <= -1) {
-        this->session->sendEvent(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), 1)));
+        this->session->addInput(Event(eid.value(), EventType::SelectItem, SelectItemEvent(eid.value(), 1)));
 
         if (is_dm.has_value() && is_dm.value()) {
             // optimistic update on scroll, otherwise might lag
@@ -1857,7 +2038,7 @@ void Client::mouseButtonCallback(GLFWwindow* window, int button, int action, int
             case GLFW_MOUSE_BUTTON_LEFT:
                 if (eid.has_value() && this->session->getInfo().is_dungeon_master.has_value() &&
                     !this->session->getInfo().is_dungeon_master.value()) {
-                    this->session->sendEvent(Event(eid.value(), EventType::UseItem, UseItemEvent(eid.value())));
+                    this->session->addInput(Event(eid.value(), EventType::UseItem, UseItemEvent(eid.value())));
                 }
                 break;
             }
@@ -446,7 +446,7 @@ void GUI::_layoutLobby() {
             auto widget = this->borrowWidget<widget::StaticImg>(handle);
 
             //  Send StartGame event to the server
-            this->client->session->sendEvent(Event(
+            this->client->session->addInput(Event(
                 this->client->session->getInfo().client_eid.value(),
                 EventType::LobbyAction,
                 LobbyActionEvent(
@@ -1023,7 +1023,7 @@ gui::widget::Flexbox::Ptr GUI::_createPlayerStatusRow(
                         role = PlayerRole::DungeonMaster;
                         break;
                     }
-                    this->client->session->sendEvent(Event(
+                    this->client->session->addInput(Event(
                         this->client->session->getInfo().client_eid.value(),
                         EventType::LobbyAction,
                         LobbyActionEvent(
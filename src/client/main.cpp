@@ -108,8 +108,18 @@ int main(int argc, char* argv[])
         // Main render display callback. Rendering of objects is done here.
         client->displayCallback();
 
+        // Let the session send and receive whatever is ready, without blocking.
+        // poll() leaves the context stopped if it ran out of work, so restart it first
+        if (context.stopped()) {
+            context.restart();
+        }
+        context.poll();
+
         // Idle callback. Updating objects, etc. can be done here.
         client->idleCallback();
+
+        // Everything this frame's input produced goes out together
+        client->sendPacketsToServer();
     }
 
     client->cleanup();
@@ -0,0 +1,241 @@
+#include "client/snapshotinterpolator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "shared/game/constants.hpp"
+
+/// @brief Length of a server tick, in seconds
+static const double TICK_SECONDS = std::chrono::duration<double>(TIMESTEP_LEN).count();
+
+SnapshotInterpolator::SnapshotInterpolator(std::size_t capacity):
+    frames(std::max<std::size_t>(capacity, 2)),
+    newest_index(0),
+    count(0),
+    clock_offset(0.0),
+    has_clock_offset(false),
+    last_transit(0.0),
+    jitter(0.0),
+    render_delay(INTERP_MIN_DELAY_TICKS * TICK_SECONDS),
+    from_age(0),
+    to_age(0),
+    alpha(1.0),
+    extrapolating(false)
+{
+}
+
+void SnapshotInterpolator::addSnapshot(const SharedGameState& state,
+    const std::unordered_set<EntityID>& moved, double arrival_time) {
+    if (this->count > 0 && state.timestep < this->_frame(0).timestep) {
+        // the server started over, e.g. a new game
+        this->clear();
+    }
+
+    for (EntityID id : moved) {
+        this->moving.insert(id);
+    }
+
+    // forget about anything that has been deleted
+    for (auto it = this->moving.begin(); it != this->moving.end();) {
+        auto obj = state.objects.find(*it);
+        if (obj == state.objects.end() || !obj->second.has_value()) {
+            it = this->moving.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    if (this->count > 0 && state.timestep == this->_frame(0).timestep) {
+        // more of the same tick, which doesn't move time along
+        Frame& newest = this->frames[this->newest_index];
+        for (EntityID id : this->moving) {
+            newest.poses.insert_or_assign(id, state.objects.at(id)->physics);
+        }
+        return;
+    }
+
+    double server_time = state.timestep * TICK_SECONDS;
+    this->_measureArrival(server_time, arrival_time);
+
+    this->newest_index = (this->newest_index + 1) % this->frames.size();
+    this->count = std::min(this->count + 1, this->frames.size());
+
+    // reuse the memory of whichever frame is falling off the end
+    Frame& frame = this->frames[this->newest_index];
+    frame.timestep = state.timestep;
+    frame.server_time = server_time;
+    frame.poses.clear();
+    for (EntityID id : this->moving) {
+        frame.poses.insert({id, state.objects.at(id)->physics});
+    }
+}
+
+void SnapshotInterpolator::update(double now) {
+    this->from_age = 0;
+    this->to_age = 0;
+    this->alpha = 1.0;
+    this->extrapolating = false;
+
+    if (this->count == 0) {
+        return;
+    }
+
+    double render_time = now - this->clock_offset - this->render_delay;
+
+    const Frame& newest = this->_frame(0);
+    if (render_time >= newest.server_time) {
+        if (this->count < 2 || render_time == newest.server_time) {
+            return;
+        }
+
+        // we ran out of snapshots, so keep going the way things were going, for a bit
+        const Frame& previous = this->_frame(1);
+        double ahead = std::min(render_time - newest.server_time, static_cast<double>(INTERP_MAX_EXTRAPOLATION));
+        this->from_age = 1;
+        this->alpha = 1.0 + ahead / (newest.server_time - previous.server_time);
+        this->extrapolating = true;
+        return;
+    }
+
+    for (std::size_t age = 1; age < this->count; age++) {
+        const Frame& from = this->_frame(age);
+        if (from.server_time <= render_time) {
+            const Frame& to = this->_frame(age - 1);
+            this->from_age = age;
+            this->to_age = age - 1;
+            this->alpha = (render_time - from.server_time) / (to.server_time - from.server_time);
+            return;
+        }
+    }
+
+    // further back than we have, so use the oldest we have
+    this->from_age = this->count - 1;
+    this->to_age = this->count - 1;
+}
+
+void SnapshotInterpolator::apply(ObjectMap& objects) {
+    this->saved_poses.clear();
+
+    for (EntityID id : this->moving) {
+        auto obj = objects.find(id);
+        if (obj == objects.end() || !obj->second.has_value()) {
+            continue;
+        }
+
+        auto pose = this->getPose(id, obj->second->physics);
+        if (pose.has_value()) {
+            this->saved_poses.push_back({id, obj->second->physics});
+            obj->second->physics = pose.value();
+        }
+    }
+}
+
+void SnapshotInterpolator::restore(ObjectMap& objects) {
+    for (const auto& [id, physics] : this->saved_poses) {
+        auto obj = objects.find(id);
+        if (obj != objects.end() && obj->second.has_value()) {
+            obj->second->physics = physics;
+        }
+    }
+    this->saved_poses.clear();
+}
+
+boost::optional<SharedPhysics> SnapshotInterpolator::getPose(EntityID id, const SharedPhysics& current) const {
+    if (this->count == 0 || !this->moving.contains(id)) {
+        return boost::none;
+    }
+
+    const auto& from_poses = this->_frame(this->from_age).poses;
+    const auto& to_poses = this->_frame(this->to_age).poses;
+
+    auto to = to_poses.find(id);
+    if (to == to_poses.end()) {
+        return boost::none;
+    }
+
+    auto from = from_poses.find(id);
+    if (from == from_poses.end() || this->from_age == this->to_age) {
+        // only just started moving, so there is nothing to come from
+        return to->second;
+    }
+
+    const SharedPhysics& a = from->second;
+    const SharedPhysics& b = to->second;
+
+    // don't slide across the map after respawning or teleporting
+    if (glm::distance(a.corner, b.corner) > INTERP_SNAP_DISTANCE) {
+        return this->alpha < 1.0 ? a : b;
+    }
+
+    float t = static_cast<float>(this->alpha);
+    SharedPhysics pose = current;
+    pose.corner = glm::mix(a.corner, b.corner, t);
+    pose.facing = glm::mix(a.facing, b.facing, t);
+    if (glm::length(pose.facing) > 0.0f) {
+        pose.facing = glm::normalize(pose.facing);
+    } else {
+        pose.facing = b.facing;
+    }
+
+    return pose;
+}
+
+void SnapshotInterpolator::clear() {
+    this->count = 0;
+    this->moving.clear();
+    this->has_clock_offset = false;
+    this->jitter = 0.0;
+    this->render_delay = INTERP_MIN_DELAY_TICKS * TICK_SECONDS;
+    this->from_age = 0;
+    this->to_age = 0;
+    this->alpha = 1.0;
+    this->extrapolating = false;
+}
+
+double SnapshotInterpolator::getRenderDelay() const {
+    return this->render_delay;
+}
+
+double SnapshotInterpolator::getJitter() const {
+    return this->jitter;
+}
+
+std::size_t SnapshotInterpolator::size() const {
+    return this->count;
+}
+
+bool SnapshotInterpolator::isExtrapolating() const {
+    return this->extrapolating;
+}
+
+const SnapshotInterpolator::Frame& SnapshotInterpolator::_frame(std::size_t age) const {
+    return this->frames[(this->newest_index + this->frames.size() - age) % this->frames.size()];
+}
+
+void SnapshotInterpolator::_measureArrival(double server_time, double arrival_time) {
+    double transit = arrival_time - server_time;
+
+    if (!this->has_clock_offset) {
+        this->clock_offset = transit;
+        this->last_transit = transit;
+        this->has_clock_offset = true;
+        return;
+    }
+
+    // Same jitter estimate as RTP (RFC 3550): a running average of how much the
+    // transit time changes from one snapshot to the next
+    this->jitter += (std::abs(transit - this->last_transit) - this->jitter) / 16.0;
+    this->last_transit = transit;
+
+    // Time is measured against the fastest snapshot, since every other one was held up
+    // by something. Let it drift up slowly in case the route or either clock changes
+    this->clock_offset = std::min(this->clock_offset + INTERP_CLOCK_RELAX, transit);
+
+    // Render far enough behind that late snapshots are usually there in time, without
+    // running off the end of the buffer. Ease towards it so time doesn't jump backwards
+    double max_delay = (this->frames.size() - 2) * TICK_SECONDS;
+    double target = std::clamp(INTERP_MIN_DELAY_TICKS * TICK_SECONDS + INTERP_JITTER_MULTIPLIER * this->jitter,
+        INTERP_MIN_DELAY_TICKS * TICK_SECONDS, std::max(max_delay, INTERP_MIN_DELAY_TICKS * TICK_SECONDS));
+    this->render_delay += (target - this->render_delay) * 0.1;
+}
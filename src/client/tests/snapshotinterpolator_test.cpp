@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "client/snapshotinterpolator.hpp"
+#include "shared/game/constants.hpp"
+
+static const double TICK = std::chrono::duration<double>(TIMESTEP_LEN).count();
+static const EntityID MOVER = 1;
+static const EntityID WALL = 2;
+
+/**
+ * Feeds made up snapshots of one object moving one unit along x per tick, and
+ * one that never moves
+ */
+class SnapshotInterpolatorTest : public ::testing::Test {
+protected:
+    SnapshotInterpolatorTest() {
+        SharedObject mover;
+        mover.globalID = MOVER;
+        mover.physics.corner = glm::vec3(0.0f);
+        mover.physics.facing = glm::vec3(1.0f, 0.0f, 0.0f);
+        mover.physics.dimensions = glm::vec3(1.0f);
+        state.objects.insert({MOVER, mover});
+
+        SharedObject wall = mover;
+        wall.globalID = WALL;
+        wall.physics.corner = glm::vec3(100.0f);
+        state.objects.insert({WALL, wall});
+    }
+
+    /**
+     * Moves to the given tick and passes the snapshot on, as if it arrived at the given time
+     */
+    void receive(unsigned int timestep, double arrival_time, float x = -1.0f) {
+        state.timestep = timestep;
+        state.objects.at(MOVER)->physics.corner.x = x < 0.0f ? static_cast<float>(timestep) : x;
+        interpolator.addSnapshot(state, {MOVER}, arrival_time);
+    }
+
+    /**
+     * @returns Where the mover is drawn at the given time
+     */
+    float drawnX(double now) {
+        interpolator.update(now);
+        auto pose = interpolator.getPose(MOVER, state.objects.at(MOVER)->physics);
+        EXPECT_TRUE(pose.has_value());
+        return pose.has_value() ? pose->corner.x : -1.0f;
+    }
+
+    SharedGameState state;
+    SnapshotInterpolator interpolator;
+};
+
+TEST_F(SnapshotInterpolatorTest, InterpolatesBetweenSnapshots) {
+    // arriving 50ms after they were sent, like clockwork
+    for (unsigned int t = 1; t <= 10; t++) {
+        receive(t, t * TICK + 0.05);
+    }
+
+    // render one tick in the past, halfway between ticks
+    EXPECT_NEAR(drawnX(10 * TICK + 0.05), 9.0f, 0.01f);
+    EXPECT_NEAR(drawnX(10.5 * TICK + 0.05), 9.5f, 0.01f);
+    EXPECT_FALSE(interpolator.isExtrapolating());
+
+    // objects that don't move are left alone
+    EXPECT_FALSE(interpolator.getPose(WALL, state.objects.at(WALL)->physics).has_value());
+}
+
+TEST_F(SnapshotInterpolatorTest, ExtrapolatesForAWhile) {
+    for (unsigned int t = 1; t <= 10; t++) {
+        receive(t, t * TICK);
+    }
+
+    // snapshots stop arriving, so keep going for a bit and then stop
+    EXPECT_NEAR(drawnX(11.5 * TICK), 10.5f, 0.01f);
+    EXPECT_TRUE(interpolator.isExtrapolating());
+
+    float limit = 10.0f + INTERP_MAX_EXTRAPOLATION / TICK;
+    EXPECT_NEAR(drawnX(100 * TICK), limit, 0.01f);
+}
+
+TEST_F(SnapshotInterpolatorTest, JitterIncreasesDelay) {
+    SnapshotInterpolator steady;
+    for (unsigned int t = 1; t <= 50; t++) {
+        receive(t, t * TICK);
+        steady.addSnapshot(state, {MOVER}, t * TICK);
+    }
+    interpolator.clear();
+
+    // every other snapshot is 20ms late
+    for (unsigned int t = 1; t <= 50; t++) {
+        receive(t, t * TICK + (t % 2 == 0 ? 0.02 : 0.0));
+    }
+
+    EXPECT_NEAR(steady.getRenderDelay(), TICK, 0.001);
+    EXPECT_GT(interpolator.getJitter(), 0.01);
+    EXPECT_GT(interpolator.getRenderDelay(), steady.getRenderDelay() + 0.01);
+
+    // and late snapshots are still there in time to be interpolated between
+    for (double now = 50 * TICK; now < 51 * TICK; now += 0.005) {
+        drawnX(now);
+        EXPECT_FALSE(interpolator.isExtrapolating());
+    }
+}
+
+TEST_F(SnapshotInterpolatorTest, SnapsAcrossTeleports) {
+    for (unsigned int t = 1; t <= 5; t++) {
+        receive(t, t * TICK);
+    }
+    receive(6, 6 * TICK, 500.0f);
+
+    // halfway between the last two snapshots, but not halfway across the map
+    EXPECT_EQ(drawnX(6.5 * TICK), 5.0f);
+    EXPECT_EQ(drawnX(6.9 * TICK), 5.0f);
+}
+
+TEST_F(SnapshotInterpolatorTest, RestoreUndoesApply) {
+    for (unsigned int t = 1; t <= 5; t++) {
+        receive(t, t * TICK);
+    }
+
+    interpolator.update(4.5 * TICK);
+    interpolator.apply(state.objects);
+    EXPECT_NEAR(state.objects.at(MOVER)->physics.corner.x, 3.5f, 0.01f);
+    EXPECT_EQ(state.objects.at(WALL)->physics.corner.x, 100.0f);
+
+    interpolator.restore(state.objects);
+    EXPECT_EQ(state.objects.at(MOVER)->physics.corner.x, 5.0f);
+}
+
+TEST_F(SnapshotInterpolatorTest, StartsOverWhenServerDoes) {
+    for (unsigned int t = 100; t <= 110; t++) {
+        receive(t, t * TICK);
+    }
+    receive(1, 200 * TICK);
+    EXPECT_EQ(interpolator.size(), 1);
+}
@@ -31,14 +31,14 @@ int main(int argc, char* argv[]) {
 	/*unsigned int globalID1 = state.objects.createObject(ObjectType::Object);
 	Object* obj1 = state.objects.getObject(globalID1);
 	obj1->physics.shared.position = glm::vec3(0.f, 0.f, 0.f);
-	obj1->physics.velocity = glm::vec3(0.f, 0.f, 10.f);
-	obj1->physics.velocityMultiplier = glm::vec3(0.f, 0.f, -1.f);
+	obj1->physics.velocity() = glm::vec3(0.f, 0.f, 10.f);
+	obj1->physics.velocityMultiplier() = glm::vec3(0.f, 0.f, -1.f);
 
 	unsigned int globalID2 = state.objects.createObject(ObjectType::Object);
 	Object* obj2 = state.objects.getObject(globalID2);
 	obj2->physics.shared.position = glm::vec3(0.f, 0.f, 0.f);
-	obj2->physics.velocity = glm::vec3(1.f, 1.f, 10.f);
-	obj2->physics.velocityMultiplier = glm::vec3(1.f, -1.f, 0.f); */
+	obj2->physics.velocity() = glm::vec3(1.f, 1.f, 10.f);
+	obj2->physics.velocityMultiplier() = glm::vec3(1.f, -1.f, 0.f); */
 
 	//	3.	Start debugger shell
 
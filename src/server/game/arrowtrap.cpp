@@ -38,9 +38,7 @@ bool ArrowTrap::shouldTrigger(ServerGameState& state) {
     }
 
     std::vector<glm::ivec2> player_grid_positions;
-    for (int i = 0; i < state.objects.getPlayers().size(); i++) {
-        Player* player = state.objects.getPlayers().get(i);
-        if (player == nullptr) continue;
+    for (Player* player : state.objects.getPlayers()) {
         if (!player->canBeTargetted()) continue;
         player_grid_positions.push_back(state.getGrid().getGridCellFromPosition(player->physics.shared.getCenterPosition()));
     }
@@ -1,5 +1,6 @@
 #include "server/game/collider.hpp"
 #include "server/game/object.hpp"
+#include "shared/game/movement.hpp"
 
 bool detectCollision(const Physics& obj1, const Physics& obj2) {
 	switch (obj1.collider) {
@@ -89,15 +90,8 @@ bool detectCollisionBox(const Physics& box, const Physics& obj) {
 			return distance < objRadius;
 		}
 		case Collider::Box: {
-			glm::vec3 objMinPos = obj.shared.corner;
-			glm::vec3 objMaxPos = obj.shared.corner + obj.shared.dimensions;
-
-			return (maxPos.x >= objMinPos.x &&
-				minPos.x <= objMaxPos.x &&
-				maxPos.y >= objMinPos.y &&
-				minPos.y <= objMaxPos.y &&
-				maxPos.z >= objMinPos.z &&
-				minPos.z <= objMaxPos.z);
+			return boxesOverlap(box.shared.corner, box.shared.dimensions,
+				obj.shared.corner, obj.shared.dimensions);
 		}
 		//	If the object doesn't have a collider, the collision detection
 		//	always returns false
@@ -19,8 +19,7 @@ DungeonMaster::DungeonMaster(glm::vec3 corner, glm::vec3 facing) :
     dmInfo(SharedDMInfo{ .paralyzed = false, .mana_remaining = 15  })
 {
     this->physics.feels_gravity = false;
-    this->physics.velocityMultiplier = glm::vec3(3.0f, 1.0f, 3.0f);
-    this->lightning = nullptr;
+    this->physics.velocityMultiplier() = glm::vec3(3.0f, 1.0f, 3.0f);
     this->mana_used = std::chrono::system_clock::now();
     this->placedTraps = 0;
 
@@ -28,7 +28,7 @@ bool FireballTrap::shouldTrigger(ServerGameState& state) {
 
     glm::vec3 this_pos = this->physics.shared.getCenterPosition();
 
-    auto players = state.objects.getPlayers();
+    const auto& players = state.objects.getPlayers();
     Player* player_to_shoot_at = nullptr;
     float closest_dist = std::numeric_limits<float>::max();
     for (int p = 0; p < players.size(); p++) {
@@ -112,7 +112,7 @@ float FireballTrap::canSee(Object* other, ServerGameState* state) {
     glm::vec3 curr_pos = this_pos;
     for (int i = 1; i < NUM_STEPS; i++) {
         curr_pos -= step;
-        auto walls = state->objects.getSolidSurfaces();
+        const auto& walls = state->objects.getSolidSurfaces();
         // TODO: optimized collision detection
         for (int w = 0; w < walls.size(); w++) {
             auto wall = walls.get(w);
@@ -21,7 +21,7 @@ void FloorSpike::doCollision(Object* obj, ServerGameState& state) {
         return;
     }
 
-    auto creature = dynamic_cast<Creature*>(obj);
+    auto creature = obj->as<Creature>();
     if (creature == nullptr) return;
 
     creature->stats.health.decrease(DAMAGE);
@@ -129,26 +129,14 @@ glm::ivec2 Grid::getGridCellFromPosition(glm::vec3 position) {
 		glm::floor(position.z / grid_cell_width));
 }
 
-std::vector<glm::ivec2> Grid::getCellsFromPositionRange(glm::vec3 p1, glm::vec3 p2) {
-	std::vector<glm::ivec2> cellPositions;
-
+CellRange Grid::getCellsFromPositionRange(glm::vec3 p1, glm::vec3 p2) {
 	//	Get GridCell positions for p1 and p2
 	glm::ivec2 gridCellStart = Grid::getGridCellFromPosition(p1);
 	glm::ivec2 gridCellEnd = Grid::getGridCellFromPosition(p2);
 
 	if (gridCellStart.x > gridCellEnd.x || gridCellStart.y > gridCellEnd.y) {
-		return std::vector<glm::ivec2>();
-	}
-
-	if (gridCellStart == gridCellEnd) {
-		return std::vector<glm::ivec2> { gridCellStart };
-	}
-
-	for (int x = gridCellStart.x; x <= gridCellEnd.x; x++) {
-		for (int y = gridCellStart.y; y <= gridCellEnd.y; y++) {
-			cellPositions.push_back(glm::ivec2(x, y));
-		}
+		return CellRange();
 	}
 
-	return cellPositions;
+	return CellRange(gridCellStart, gridCellEnd);
 }
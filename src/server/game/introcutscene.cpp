@@ -38,9 +38,9 @@ IntroCutscene::IntroCutscene():
 
     const glm::vec3 VELOCITY = glm::normalize(player->physics.shared.facing) * 0.10f;
 
-    player->physics.velocity = VELOCITY;
-    player_left->physics.velocity = VELOCITY;
-    player_right->physics.velocity = VELOCITY;
+    player->physics.velocity() = VELOCITY;
+    player_left->physics.velocity() = VELOCITY;
+    player_right->physics.velocity() = VELOCITY;
 
     player->animState = AnimState::WalkAnim;
     player_left->animState = AnimState::WalkAnim;
@@ -60,12 +60,12 @@ IntroCutscene::IntroCutscene():
     player_right->physics.shared.corner.x += Grid::grid_cell_width;
 
     DungeonMaster* dm = new DungeonMaster(player->physics.shared.corner + glm::vec3(-20.0f, 10.0f, 0), directionToFacing(Direction::RIGHT));
-    dm->physics.velocity = player->physics.velocity;
-    dm->physics.velocityMultiplier = player->physics.velocityMultiplier;
+    dm->physics.velocity() = player->physics.velocity();
+    dm->physics.velocityMultiplier() = player->physics.velocityMultiplier();
     this->state.objects.createObject(dm);
     this->dm_eid = dm->globalID;
 
-    auto exits = this->state.objects.getExits();
+    const auto& exits = this->state.objects.getExits();
     for (int i = 0; i < exits.size(); i++) {
         auto exit = exits.get(i);
         if (exit == nullptr) continue;
@@ -108,10 +108,10 @@ bool IntroCutscene::update() {
     }
 
     if (ticks == STOP_MOVING_TICK) {
-        player->physics.velocity = glm::vec3(0.0f);
-        player_left->physics.velocity = glm::vec3(0.0f);
-        player_right->physics.velocity = glm::vec3(0.0f);
-        dm->physics.velocity = glm::vec3(0.0f);
+        player->physics.velocity() = glm::vec3(0.0f);
+        player_left->physics.velocity() = glm::vec3(0.0f);
+        player_right->physics.velocity() = glm::vec3(0.0f);
+        dm->physics.velocity() = glm::vec3(0.0f);
 
         player->animState = AnimState::IdleAnim;
         player_left->animState = AnimState::IdleAnim;
@@ -123,7 +123,7 @@ bool IntroCutscene::update() {
         float intensity = static_cast<float>(ticks - GATE_RAISE_TICK) / RAISE_TICK_DUR;
 
         // make exits slowly brighter as it opens
-        auto exits = this->state.objects.getExits();
+        const auto& exits = this->state.objects.getExits();
         for (int i = 0; i < exits.size(); i++) {
             auto exit = exits.get(i);
             if (exit == nullptr) continue;
@@ -133,7 +133,7 @@ bool IntroCutscene::update() {
 
         bool played_sound = false;
 
-        auto walls = this->state.objects.getSolidSurfaces();
+        const auto& walls = this->state.objects.getSolidSurfaces();
         for (int i = 0; i < walls.size(); i++) {
             auto wall = walls.get(i);
             if (wall == nullptr || wall->shared.surfaceType != SurfaceType::Pillar) continue;
@@ -171,7 +171,7 @@ bool IntroCutscene::update() {
     if (ticks < LIGHTNING_1_TICK - TORCH_DECAY_NUM_TICKS) {
         this->state.doTorchlightTicks();
     } else if (ticks < LIGHTNING_1_TICK) {
-        auto torches = this->state.objects.getTorchlights();
+        const auto& torches = this->state.objects.getTorchlights();
         for (int i = 0; i < torches.size(); i++) {
             auto torch = torches.get(i);
             if (torch == nullptr) continue;
@@ -218,14 +218,14 @@ bool IntroCutscene::update() {
 
     if (ticks == EXIT_CUTSCENE_TICK) {
         player->animState = AnimState::SprintAnim;
-        player->physics.velocity = glm::normalize(player->physics.shared.facing) * 0.20f;
+        player->physics.velocity() = glm::normalize(player->physics.shared.facing) * 0.20f;
     }
 
     if (ticks == EXIT_CUTSCENE_TICK + 20) {
         player_left->animState = AnimState::SprintAnim;
-        player_left->physics.velocity = glm::normalize(player->physics.shared.facing) * 0.20f;
+        player_left->physics.velocity() = glm::normalize(player->physics.shared.facing) * 0.20f;
         player_right->animState = AnimState::SprintAnim;
-        player_right->physics.velocity = glm::normalize(player->physics.shared.facing) * 0.20f;
+        player_right->physics.velocity() = glm::normalize(player->physics.shared.facing) * 0.20f;
     }
 
     if (ticks == EXIT_CUTSCENE_TICK + 100) {
@@ -245,24 +245,13 @@ bool IntroCutscene::update() {
 }
 
 LoadIntroCutsceneEvent IntroCutscene::toNetwork() {
-    std::vector<SharedGameState> updates = this->state.generateSharedGameState(true);
-    if (updates.size() != 1) {
-        // just put them all in one packet and pray it works...
-        SharedGameState& main = updates.at(0);
-        for (int i = 1; i < updates.size(); i++) {
-            for (const auto& [eid, obj] : updates.at(i).objects) {
-                main.objects.insert({eid, obj});
-            }
-        }
-    }
+    SharedGameState update = this->state.generateSharedGameState(true);
 
     std::array<boost::optional<SharedObject>, MAX_POINT_LIGHTS> empty; 
     std::swap(this->lights, empty);
 
     std::size_t lights_idx = 0;
-    for (int i = 0; i < this->state.objects.getObjects().size(); i++) {
-        auto object = this->state.objects.getObject(i);
-        if (object == nullptr) continue;
+    for (Object* object : this->state.objects.getObjects()) {
 
         if (lights_idx < MAX_POINT_LIGHTS && 
             (object->type == ObjectType::Torchlight ||
@@ -283,7 +272,7 @@ LoadIntroCutsceneEvent IntroCutscene::toNetwork() {
         // because i dont trust c++ to do anything ever
     }
 
-    auto evt = LoadIntroCutsceneEvent(updates.at(0), this->pov_eid, this->dm_eid, this->lights);
+    auto evt = LoadIntroCutsceneEvent(update, this->pov_eid, this->dm_eid, this->lights);
 
     return evt;
 }
@@ -24,7 +24,7 @@ void Lava::doCollision(Object* obj, ServerGameState& state) {
         return;
     }
 
-    auto creature = dynamic_cast<Creature*>(obj);
+    auto creature = obj->as<Creature>();
     if (creature == nullptr) return;
 
     creature->stats.health.decrease(DAMAGE);
@@ -16,9 +16,9 @@ Minotaur::Minotaur(glm::vec3 corner, glm::vec3 facing) :
     this->chargeDuration = 3;
     this->stopped = false;
 
-    this->physics.velocityMultiplier.y = 0.2;
-    this->physics.velocityMultiplier.x = 0.3;
-    this->physics.velocityMultiplier.z = 0.3;
+    this->physics.velocityMultiplier().y = 0.2;
+    this->physics.velocityMultiplier().x = 0.3;
+    this->physics.velocityMultiplier().z = 0.3;
 }
 
 bool Minotaur::doBehavior(ServerGameState& state) {
@@ -26,7 +26,7 @@ bool Minotaur::doBehavior(ServerGameState& state) {
     std::chrono::duration<double> elapsed_seconds{ now - this->last_charge_time };
 
     if (elapsed_seconds > std::chrono::seconds(this->chargeDelay)) {
-        auto players = state.objects.getPlayers();
+        const auto& players = state.objects.getPlayers();
         float closest_dist = std::numeric_limits<float>::max();
         Player* target = nullptr;
         for (int p = 0; p < players.size(); p++) {
@@ -52,8 +52,8 @@ bool Minotaur::doBehavior(ServerGameState& state) {
             ));
         }
 
-        this->physics.velocity.x = 1.5f * this->physics.shared.facing.x;
-        this->physics.velocity.z = 1.5f * this->physics.shared.facing.z;
+        this->physics.velocity().x = 1.5f * this->physics.shared.facing.x;
+        this->physics.velocity().z = 1.5f * this->physics.shared.facing.z;
         this->last_charge_time = now;
         this->stopped = false;
 
@@ -68,8 +68,8 @@ bool Minotaur::doBehavior(ServerGameState& state) {
         return true;
     } 
     else if (elapsed_seconds > std::chrono::seconds(this->chargeDuration) && !this->stopped) {
-        this->physics.velocity.x = 0;
-        this->physics.velocity.z = 0;
+        this->physics.velocity().x = 0;
+        this->physics.velocity().z = 0;
         this->stopped = true;
         return true;
     }
@@ -78,7 +78,7 @@ bool Minotaur::doBehavior(ServerGameState& state) {
 }
 
 void Minotaur::doCollision(Object* other, ServerGameState& state) {
-    Creature* creature = dynamic_cast<Creature*>(other);
+    Creature* creature = other->as<Creature>();
     if (creature == nullptr) return;
 
     if (creature->type == ObjectType::Player) {
@@ -86,7 +86,7 @@ void Minotaur::doCollision(Object* other, ServerGameState& state) {
         auto knockback = glm::normalize(
             other->physics.shared.getCenterPosition() - this->physics.shared.getCenterPosition());
         knockback.y = 0;
-        creature->physics.currTickVelocity = 0.7f * knockback;
+        creature->physics.currTickVelocity() = 0.7f * knockback;
     }
 }
 
@@ -76,6 +76,38 @@ SharedObject Object::toShared() {
 	return shared;
 }
 
+/*	SharedObject caching	*/
+
+const SharedObject& Object::getShared() {
+	this->rebuildShared();
+	return this->sharedCache.get();
+}
+
+void Object::markDirty() {
+	this->sharedDirty = true;
+}
+
+SharedObjectFieldMask Object::takeSharedChanges() {
+	this->rebuildShared();
+
+	SharedObjectFieldMask changed = this->unbroadcastChanges;
+	this->unbroadcastChanges = 0;
+	return changed;
+}
+
+void Object::rebuildShared() {
+	if (!this->sharedDirty && this->sharedCache.has_value()) {
+		return;
+	}
+	this->sharedDirty = false;
+
+	SharedObject shared = this->toShared();
+	if (this->sharedCache.has_value()) {
+		this->unbroadcastChanges |= this->sharedCache->diff(shared);
+	}
+	this->sharedCache = std::move(shared);
+}
+
 /*	Debugger Methods	*/
 
 std::string Object::to_string(unsigned int tab_offset) {
@@ -96,6 +128,54 @@ std::string Object::to_string(unsigned int tab_offset) {
 	return representation;
 }
 
+/*	Physics	*/
+
+Physics::Physics(const Physics& other):
+	shared(other.shared), movable(other.movable), feels_gravity(other.feels_gravity),
+	collider(other.collider), own_velocity(other.velocity()),
+	own_velocity_multiplier(other.velocityMultiplier()),
+	own_curr_tick_velocity(other.currTickVelocity()), own_nauseous(other.nauseous())
+{}
+
+Physics& Physics::operator=(const Physics& other) {
+	this->shared = other.shared;
+	this->movable = other.movable;
+	this->feels_gravity = other.feels_gravity;
+	this->collider = other.collider;
+	this->velocity() = other.velocity();
+	this->velocityMultiplier() = other.velocityMultiplier();
+	this->currTickVelocity() = other.currTickVelocity();
+	this->nauseous() = other.nauseous();
+
+	return *this;
+}
+
+void Physics::attach(PhysicsStore& store, MovableID slot) {
+	this->detach();
+
+	store.reserve(slot);
+	store.velocity(slot) = this->own_velocity;
+	store.velocityMultiplier(slot) = this->own_velocity_multiplier;
+	store.currTickVelocity(slot) = this->own_curr_tick_velocity;
+	store.nauseous(slot) = this->own_nauseous;
+
+	this->store = &store;
+	this->slot = slot;
+}
+
+void Physics::detach() {
+	if (this->store == nullptr) {
+		return;
+	}
+
+	this->own_velocity = this->velocity();
+	this->own_velocity_multiplier = this->velocityMultiplier();
+	this->own_curr_tick_velocity = this->currTickVelocity();
+	this->own_nauseous = this->nauseous();
+
+	this->store = nullptr;
+}
+
 std::string Physics::to_string(unsigned int tab_offset) {
 	//	Return a string representation of this Physics struct
 
@@ -107,8 +187,8 @@ std::string Physics::to_string(unsigned int tab_offset) {
 	std::string representation = tabs + "{\n";
 	representation += tabs + "\tmovable:\t\t" + (this->movable ? "true" : "false") + '\n';
 	representation += tabs + "\feels_gravity:\t\t" + (this->feels_gravity ? "true" : "false") + '\n';
-	representation += tabs + "\tvelocity:\t\t" + glm::to_string(this->velocity) + '\n';
-	representation += tabs + "\velocityMultiplier:\t\t" + glm::to_string(this->velocityMultiplier) + '\n';
+	representation += tabs + "\tvelocity:\t\t" + glm::to_string(this->velocity()) + '\n';
+	representation += tabs + "\velocityMultiplier:\t\t" + glm::to_string(this->velocityMultiplier()) + '\n';
 	representation += tabs + "\tfacing:\t\t\t" + glm::to_string(this->shared.facing) + '\n';
 	representation += tabs + "\tdimensions:\t\t\t" + glm::to_string(this->shared.dimensions) + '\n';
 	representation += tabs + "}";
@@ -28,7 +28,11 @@ ObjectManager::ObjectManager() { // cppcheck-suppress uninitMemberVar
 }
 
 ObjectManager::~ObjectManager() {
-	//	TODO: Delete all allocated objects
+	//	Delete all allocated objects, which hands them back to their
+	//	ObjectPools for the next game to reuse
+	for (Object* object : this->objects) {
+		delete object;
+	}
 }
 
 /*	Object CRUD methods	*/
@@ -50,15 +54,13 @@ SpecificID ObjectManager::_createObject(Object* object, boost::optional<EntityID
 	}
 
 	object->globalID = globalID;
-
-	object->gridCellPositions = this->objectGridCells(object);
-
-	for (auto pos : object->gridCellPositions) {
-		if (!this->cellToObjects.contains(pos)) {
-			this->cellToObjects.insert({pos, std::vector<Object*>()});
-		}
+	if (globalID >= this->generations.size()) {
+		this->generations.resize(globalID + 1, 1);
 	}
 
+	//	Not in the spatial grid until moveObject() below puts it there
+	object->gridCellPositions = CellRange();
+
 	switch (object->type) {
 		case ObjectType::Projectile:
 			object->typeID = this->projectiles.push(dynamic_cast<Projectile*>(object));
@@ -123,6 +125,11 @@ SpecificID ObjectManager::_createObject(Object* object, boost::optional<EntityID
 	if (object->physics.movable) {
 		auto movableID = movableObjects.push(object);
 		object->movableID = movableID;
+		object->physics.attach(this->physicsStore, movableID);
+	}
+
+	if (Creature* creature = object->as<Creature>()) {
+		creature->creatureID = this->creatures.push(creature);
 	}
 
 	//	Move object to its given position
@@ -149,6 +156,13 @@ bool ObjectManager::removeObject(EntityID globalID) {
 	//	type-specific Object vector it's in
 	this->objects.remove(globalID);
 
+	//	Make handles to the object stale before its EntityID can be reused
+	//	(generation 0 means an unset handle, so skip it when wrapping around)
+	Generation& generation = this->generations.at(globalID);
+	if (++generation == 0) {
+		generation = 1;
+	}
+
 	switch (object->type) {
 	case ObjectType::Object:
 		//	Remove object pointer from the base_objects type-specific 
@@ -202,20 +216,16 @@ bool ObjectManager::removeObject(EntityID globalID) {
 
 	if (object->physics.movable) {
 		movableObjects.remove(object->movableID);
+		object->physics.detach();
 	}
 
-	//	Remove object from cellToObjects hashmap
-	for (glm::vec2 cellPosition : object->gridCellPositions) {
-		std::vector<Object*>& objectsInCell =
-			this->cellToObjects[cellPosition];
-
-		//	Remove object from Object * vector of objects in this cell
-		for (int i = 0; i < objectsInCell.size(); i++) {
-			if (objectsInCell.at(i)->globalID == object->globalID) {
-				objectsInCell.erase(objectsInCell.begin() + i);
-				break;
-			}
-		}
+	if (Creature* creature = object->as<Creature>()) {
+		this->creatures.remove(creature->creatureID);
+	}
+
+	//	Remove object from the spatial grid
+	for (glm::ivec2 cellPosition : object->gridCellPositions) {
+		this->spatialGrid.at(cellPosition).remove(object);
 	}
 
 	//	Delete object
@@ -268,14 +278,26 @@ Object* ObjectManager::getObject(EntityID globalID) {
 	return this->objects.get(globalID);
 }
 
-SmartVector<Object*> ObjectManager::getObjects() {
+std::size_t ObjectManager::getStaleResolutions() const {
+#ifndef NDEBUG
+	return this->stale_resolutions;
+#else
+	return 0;
+#endif
+}
+
+const SmartVector<Object*>& ObjectManager::getObjects() const {
 	return this->objects;
 }
 
-SmartVector<Object*> ObjectManager::getMovableObjects() {
+const SmartVector<Object*>& ObjectManager::getMovableObjects() const {
 	return this->movableObjects;
 }
 
+const SmartVector<Creature*>& ObjectManager::getCreatures() const {
+	return this->creatures;
+}
+
 /*	SpecificID object getters by type	*/
 Object* ObjectManager::getBaseObject(SpecificID base_objectID) {
 	return this->base_objects.get(base_objectID);
@@ -309,39 +331,39 @@ Trap* ObjectManager::getTrap(SpecificID trapID) {
 	return this->traps.get(trapID);
 }
 
-SmartVector<Item*> ObjectManager::getItems() {
+const SmartVector<Item*>& ObjectManager::getItems() const {
 	return this->items;
 }
 
-SmartVector<SolidSurface*> ObjectManager::getSolidSurfaces() {
+const SmartVector<SolidSurface*>& ObjectManager::getSolidSurfaces() const {
 	return this->solid_surfaces;
 }
 
-SmartVector<Player*> ObjectManager::getPlayers() {
+const SmartVector<Player*>& ObjectManager::getPlayers() const {
 	return this->players;
 }
 
-SmartVector<Enemy*> ObjectManager::getEnemies() {
+const SmartVector<Enemy*>& ObjectManager::getEnemies() const {
 	return this->enemies;
 }
 
-SmartVector<Trap*> ObjectManager::getTraps() {
+const SmartVector<Trap*>& ObjectManager::getTraps() const {
 	return this->traps;
 }
 
-SmartVector<Projectile*> ObjectManager::getProjectiles() {
+const SmartVector<Projectile*>& ObjectManager::getProjectiles() const {
 	return this->projectiles;
 }
 
-SmartVector<WeaponCollider*> ObjectManager::getWeaponColliders() {
+const SmartVector<WeaponCollider*>& ObjectManager::getWeaponColliders() const {
 	return this->weaponColliders;
 }
 
-SmartVector<Torchlight*> ObjectManager::getTorchlights() {
+const SmartVector<Torchlight*>& ObjectManager::getTorchlights() const {
 	return this->torchlights;
 }
 
-SmartVector<Exit*> ObjectManager::getExits() {
+const SmartVector<Exit*>& ObjectManager::getExits() const {
 	return this->exits;
 }
 
@@ -353,50 +375,59 @@ bool ObjectManager::moveObject(Object* object, glm::vec3 newCornerPosition) {
 
 	object->distance_moved += glm::distance(object->physics.shared.corner, newCornerPosition);
 
-	//	Remove the object from the cellToObjects hashmap
-	for (auto cellPosition : object->gridCellPositions) {
-		std::vector<Object*>& objectsInCell = this->cellToObjects.at(cellPosition);
-
-		//	Remove object from Object * vector of objects in this cell
-		for (int i = 0; i < objectsInCell.size(); i++) {
-			if (objectsInCell.at(i)->globalID == object->globalID) {
-				objectsInCell.erase(objectsInCell.begin() + i);
-				break;
-			}
-		}
-	}
-
 	//	Update object's corner position
 	object->physics.shared.corner = newCornerPosition;
 
-	//	Get the object's new occupied GridCell position vector
-	object->gridCellPositions = objectGridCells(object);
+	//	Get the object's new occupied GridCell range. Most moves stay within
+	//	the same GridCells, in which case the spatial grid is already right
+	CellRange oldCells = object->gridCellPositions;
+	CellRange newCells = objectGridCells(object);
+	if (newCells == oldCells) {
+		return true;
+	}
 
-	for (int i = 0; i < object->gridCellPositions.size(); i++) {
-		this->cellToObjects[object->gridCellPositions[i]].push_back(object);
+	//	Only touch the GridCells that the object left or entered
+	for (glm::ivec2 cellPosition : oldCells) {
+		if (!newCells.contains(cellPosition)) {
+			this->spatialGrid.at(cellPosition).remove(object);
+		}
+	}
+
+	for (glm::ivec2 cellPosition : newCells) {
+		if (!oldCells.contains(cellPosition)) {
+			this->spatialGrid.at(cellPosition).push(object);
+		}
 	}
 
+	object->gridCellPositions = newCells;
+
     return true;
 }
 
-std::vector<glm::ivec2> ObjectManager::objectGridCells(Object* object) {
+void ObjectManager::setGridSize(int columns, int rows) {
+	this->spatialGrid.resize(columns, rows);
+
+	//	Put back any objects that were already in the (now emptied) grid
+	for (Object* object : this->objects) {
+		for (glm::ivec2 cellPosition : object->gridCellPositions) {
+			this->spatialGrid.at(cellPosition).push(object);
+		}
+	}
+}
+
+CellRange ObjectManager::objectGridCells(Object* object) {
 	return Grid::getCellsFromPositionRange(object->physics.shared.corner,
 		object->physics.shared.corner + object->physics.shared.dimensions);
 }
 
 /*	SharedGameState generation	*/
 
-std::vector<boost::optional<SharedObject>> ObjectManager::toShared() {
-	std::vector<boost::optional<SharedObject>> shared;
+std::vector<SharedObject> ObjectManager::toShared() {
+	std::vector<SharedObject> shared;
+	shared.reserve(this->objects.numElements());
 
-	for (int i = 0; i < this->objects.size(); i++) {
-		Object* object = this->objects.get(i);
-
-		if (object == nullptr) {
-			shared.push_back({});
-		} else {
-			shared.push_back(object->toShared());
-		}
+	for (Object* object : this->objects) {
+		shared.push_back(object->getShared());
 	}
 
 	return shared;
@@ -0,0 +1,21 @@
+#include "server/game/objectpool.hpp"
+
+/**
+ * @brief Stats of every pool, by type name. Never destroyed, like the pools.
+ */
+static std::map<std::string, const ObjectPoolStats*>& registry() {
+	static auto* pools = new std::map<std::string, const ObjectPoolStats*>();
+	return *pools;
+}
+
+void registerObjectPool(const std::string& name, const ObjectPoolStats* stats) {
+	registry()[name] = stats;
+}
+
+std::map<std::string, ObjectPoolStats> getObjectPoolStats() {
+	std::map<std::string, ObjectPoolStats> stats;
+	for (const auto& [name, pool_stats] : registry()) {
+		stats[name] = *pool_stats;
+	}
+	return stats;
+}
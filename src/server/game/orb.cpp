@@ -51,14 +51,14 @@ void Orb::useItem(Object* other, ServerGameState& state, int itemSelected) {
 	auto player = dynamic_cast<Player*>(other);
 	player->sharedInventory.hasOrb = false;
 	Item::dropItem(other, state, itemSelected, 3.0f);
-	this->physics.velocity = 0.8f * glm::normalize(other->physics.shared.facing);
+	this->physics.velocity() = 0.8f * glm::normalize(other->physics.shared.facing);
 	state.objects.moveObject(this, this->physics.shared.corner + glm::vec3(0.0f, 3.0f, 0.0f));
 
 	// check to make sure that not colliding with anything
 	// lazy copy paste with below... keep in sync
 	auto grid_cells = state.objects.objectGridCells(this);
 	for (glm::ivec2 grid_cell : grid_cells) {
-		auto potential_collision_objects = state.objects.cellToObjects.at(grid_cell);	
+		const CellBucket& potential_collision_objects = state.objects.spatialGrid.at(grid_cell);
 		for (Object* obj : potential_collision_objects) {
 			if (obj->type != ObjectType::Orb && obj->type != ObjectType::Player && detectCollision(this->physics, obj->physics)) { // cppcheck-suppress useStlAlgorithm
 				// go back in the inventory b/c inside a wall or something
@@ -83,7 +83,7 @@ void Orb::dropItem(Object* other, ServerGameState& state, int itemSelected, floa
 	// lazy copy paste with above... keep in sync
 	auto grid_cells = state.objects.objectGridCells(this);
 	for (glm::ivec2 grid_cell : grid_cells) {
-		auto potential_collision_objects = state.objects.cellToObjects.at(grid_cell);	
+		const CellBucket& potential_collision_objects = state.objects.spatialGrid.at(grid_cell);
 		for (Object* obj : potential_collision_objects) {
 			if (obj->type != ObjectType::Orb && obj->type != ObjectType::Player && detectCollision(this->physics, obj->physics)) { // cppcheck-suppress useStlAlgorithm
 				// go back in the inventory b/c inside a wall or something
@@ -0,0 +1,40 @@
+#include "server/game/physicsstore.hpp"
+
+void PhysicsStore::reserve(MovableID id) {
+	if (id < this->size()) {
+		return;
+	}
+
+	std::size_t size = static_cast<std::size_t>(id) + 1;
+	this->velocities.resize(size, glm::vec3(0.0f));
+	this->multipliers.resize(size, glm::vec3(1.0f));
+	this->tick_velocities.resize(size, glm::vec3(0.0f));
+	this->nausea.resize(size, 1.0f);
+}
+
+void PhysicsStore::integrate() {
+	std::size_t size = this->size();
+	this->steps.resize(size);
+
+	//	A plain loop over plain arrays, so that this vectorizes. Empty slots are
+	//	worked out as well, which is cheaper than skipping them
+	for (std::size_t i = 0; i < size; i++) {
+		glm::vec3 step = this->velocities[i] * this->multipliers[i] + this->tick_velocities[i];
+		step.x *= this->nausea[i];
+		step.z *= this->nausea[i];
+		this->steps[i] = step;
+	}
+}
+
+glm::vec3 PhysicsStore::getStep(MovableID id) const {
+	//	Objects created since the last integrate() don't move until the next tick
+	if (id >= this->steps.size()) {
+		return glm::vec3(0.0f);
+	}
+
+	return this->steps[id];
+}
+
+std::size_t PhysicsStore::size() const {
+	return this->velocities.size();
+}
@@ -75,7 +75,7 @@ void Potion::useItem(Object* other, ServerGameState& state, int itemSelected) {
         break;
     }
     case PotionType::Nausea: {
-        player->physics.nauseous = this->effectScalar;
+        player->physics.nauseous() = this->effectScalar;
         player->sharedInventory.usedItems.insert({ this->typeID, std::make_pair(ModelType::NauseaPotion, this->iteminfo.remaining_time) });
         break;
     }
@@ -120,7 +120,7 @@ bool Potion::timeOut() {
 UsedItemsMap::iterator Potion::revertEffect(ServerGameState& state) {
     switch (this->potType) {
     case PotionType::Nausea: {
-        this->usedPlayer->physics.nauseous = 1.0f;
+        this->usedPlayer->physics.nauseous() = 1.0f;
         break;
     }
     case PotionType::Invisibility: {
@@ -12,8 +12,8 @@ Projectile::Projectile(glm::vec3 corner, glm::vec3 facing,
     Object(ObjectType::Projectile, Physics(true, Collider::Box, corner, facing, dimensions), model),
     opt(options), destroy_sound(destroy_sound)
 {
-    this->physics.velocityMultiplier = glm::vec3(this->opt.h_mult, this->opt.v_mult, this->opt.h_mult);
-    this->physics.velocity = glm::normalize(facing);
+    this->physics.velocityMultiplier() = glm::vec3(this->opt.h_mult, this->opt.v_mult, this->opt.h_mult);
+    this->physics.velocity() = glm::normalize(facing);
 }
 
 bool Projectile::doTick(ServerGameState& state) {
@@ -37,16 +37,16 @@ bool Projectile::doTick(ServerGameState& state) {
     auto pos_to_go_to = target->physics.shared.getCenterPosition();
     auto dir_to_target = glm::normalize(pos_to_go_to - this->physics.shared.getCenterPosition());
 
-    this->physics.velocity += dir_to_target * this->opt.homing_strength;
-    this->physics.velocity = glm::normalize(this->physics.velocity);
-    this->physics.shared.facing = this->physics.velocity;
+    this->physics.velocity() += dir_to_target * this->opt.homing_strength;
+    this->physics.velocity() = glm::normalize(this->physics.velocity());
+    this->physics.shared.facing = this->physics.velocity();
 
     return true;
 }
 
 void Projectile::doCollision(Object* other, ServerGameState& state) {
-    this->physics.velocity.x = 0;
-    this->physics.velocity.z = 0;
+    this->physics.velocity().x = 0;
+    this->physics.velocity().z = 0;
     this->physics.collider = Collider::None;
 
     state.markForDeletion(this->globalID);
@@ -62,7 +62,7 @@ void Projectile::doCollision(Object* other, ServerGameState& state) {
 
     if (!this->opt.isSpell) {
         // do damage if creature
-        Creature* creature = dynamic_cast<Creature*>(other);
+        Creature* creature = other->as<Creature>();
         if (creature == nullptr) return;
 
         creature->stats.health.decrease(this->opt.damage);
@@ -79,7 +79,7 @@ void Projectile::doCollision(Object* other, ServerGameState& state) {
         switch (orb->sType) {
         case SpellType::Fireball: {
             // do damage if creature
-            Creature* creature = dynamic_cast<Creature*>(other);
+            Creature* creature = other->as<Creature>();
             if (creature != nullptr) {
                 creature->stats.health.decrease(this->opt.damage);
                 return;
@@ -99,7 +99,7 @@ void Projectile::doCollision(Object* other, ServerGameState& state) {
 
         case SpellType::HealOrb: {
             // heal if creature
-            Creature* creature = dynamic_cast<Creature*>(other);
+            Creature* creature = other->as<Creature>();
             if (creature != nullptr) {
                 creature->stats.health.increase(this->opt.damage);
                 return;
@@ -17,9 +17,9 @@ Python::Python(glm::vec3 corner, glm::vec3 facing) :
     this->diagonal = false;
     this->stopped = false;
 
-    this->physics.velocityMultiplier.y = 0.3;
-    this->physics.velocityMultiplier.x = 0.4;
-    this->physics.velocityMultiplier.z = 0.4;
+    this->physics.velocityMultiplier().y = 0.3;
+    this->physics.velocityMultiplier().x = 0.4;
+    this->physics.velocityMultiplier().z = 0.4;
     this->physics.shared.dimensions = glm::vec3(2.0f, 3.0f, 2.0f);
 }
 
@@ -28,7 +28,7 @@ bool Python::doBehavior(ServerGameState& state) {
     std::chrono::duration<double> elapsed_seconds{ now - this->last_move_time };
     
     if (elapsed_seconds > std::chrono::seconds(this->moveDelay)) {
-        auto players = state.objects.getPlayers();
+        const auto& players = state.objects.getPlayers();
         float closest_dist = std::numeric_limits<float>::max();
         Player* target = nullptr;
         for (int p = 0; p < players.size(); p++) {
@@ -56,22 +56,22 @@ bool Python::doBehavior(ServerGameState& state) {
 
         if (this->diagonal) {
             if (randomInt(0, 1) == 0) {
-                this->physics.velocity.x = (this->physics.shared.facing.x * 0.5) * 0.525
+                this->physics.velocity().x = (this->physics.shared.facing.x * 0.5) * 0.525
                     + (this->physics.shared.facing.z * 0.5) * 0.85;
-                this->physics.velocity.z = (this->physics.shared.facing.x * 0.5) * -0.85
+                this->physics.velocity().z = (this->physics.shared.facing.x * 0.5) * -0.85
                     + (this->physics.shared.facing.z * 0.5) * 0.525;
             }
             else {
-                this->physics.velocity.x = (this->physics.shared.facing.x * 0.5) * 0.525
+                this->physics.velocity().x = (this->physics.shared.facing.x * 0.5) * 0.525
                     + (this->physics.shared.facing.z * 0.5) * -0.85;
-                this->physics.velocity.z = (this->physics.shared.facing.x * 0.5) * 0.85
+                this->physics.velocity().z = (this->physics.shared.facing.x * 0.5) * 0.85
                     + (this->physics.shared.facing.z * 0.5) * 0.525;
             }
             this->diagonal = false;
         }
         else {
-            this->physics.velocity.x = this->physics.shared.facing.x * 0.5;
-            this->physics.velocity.z = this->physics.shared.facing.z * 0.5;
+            this->physics.velocity().x = this->physics.shared.facing.x * 0.5;
+            this->physics.velocity().z = this->physics.shared.facing.z * 0.5;
             this->diagonal = true;
         }
         
@@ -89,8 +89,8 @@ bool Python::doBehavior(ServerGameState& state) {
         return true;
     } 
     else if (elapsed_seconds > std::chrono::seconds(this->moveDuration) && !this->stopped) {
-        this->physics.velocity.x = 0;
-        this->physics.velocity.z = 0;
+        this->physics.velocity().x = 0;
+        this->physics.velocity().z = 0;
         this->stopped = true;
         return true;
     }
@@ -99,7 +99,7 @@ bool Python::doBehavior(ServerGameState& state) {
 }
 
 void Python::doCollision(Object* other, ServerGameState& state) {
-    Creature* creature = dynamic_cast<Creature*>(other);
+    Creature* creature = other->as<Creature>();
     if (creature == nullptr) return;
 
     if (creature->type == ObjectType::Player) {
@@ -107,7 +107,7 @@ void Python::doCollision(Object* other, ServerGameState& state) {
         auto knockback = glm::normalize(
             other->physics.shared.getCenterPosition() - this->physics.shared.getCenterPosition());
         knockback.y = 0;
-        creature->physics.currTickVelocity = 0.5f * knockback;
+        creature->physics.currTickVelocity() = 0.5f * knockback;
     }
 }
 
@@ -27,6 +27,7 @@
 #include "shared/audio/utilities.hpp"
 #include "shared/game/sharedmodel.hpp"
 #include "shared/game/sharedobject.hpp"
+#include "shared/game/movement.hpp"
 #include "shared/utilities/root_path.hpp"
 #include "shared/utilities/time.hpp"
 #include "shared/network/constants.hpp"
@@ -60,7 +61,6 @@ ServerGameState::ServerGameState(GameConfig config) : config(config) {
 	//	No player died yet
 	this->numPlayerDeaths = 0;
 
-	this->currentGhostTrap = nullptr;
 	this->spawner = std::make_unique<Spawner>();
 	this->spawner->spawnDummy(*this);
 	this->spawner->spawnSmallDummy(*this);
@@ -105,70 +105,53 @@ ServerGameState::ServerGameState(GamePhase start_phase, const GameConfig& config
 ServerGameState::~ServerGameState() {}
 
 /*	SharedGameState generation	*/
-std::vector<SharedGameState> ServerGameState::generateSharedGameState(bool send_all) {
-	std::vector<SharedGameState> partial_updates;
-
-	auto getUpdateTemplate = [this]() {
-		SharedGameState curr_update;
-		curr_update.timestep = this->timestep;
-		curr_update.lobby = this->lobby;
-		curr_update.phase = this->phase;
-		curr_update.matchPhase = this->matchPhase;
-		curr_update.relay_finish_time = this->relay_finish_time;
-		curr_update.playerVictory = this->playerVictory;
-		curr_update.numPlayerDeaths = this->numPlayerDeaths;
-		return curr_update;
-	};
+SharedGameState ServerGameState::generateSharedGameState(bool send_all) {
+	SharedGameState update;
+	update.timestep = this->timestep;
+	update.lobby = this->lobby;
+	update.phase = this->phase;
+	update.matchPhase = this->matchPhase;
+	update.relay_finish_time = this->relay_finish_time;
+	update.playerVictory = this->playerVictory;
+	update.numPlayerDeaths = this->numPlayerDeaths;
 
 	if (send_all) {
+		//	Only objects that exist are sent, since whoever gets a full update
+		//	starts over from nothing instead of applying it to what it had
 		auto all_objects = this->objects.toShared();
+		update.objects.reserve(all_objects.size());
 
-		for (int i = 0; i < all_objects.size(); i += OBJECTS_PER_UPDATE) {
-			SharedGameState curr_update = getUpdateTemplate();
-
-			for (int j = 0; j < OBJECTS_PER_UPDATE && i + j < all_objects.size(); j++) {
-				EntityID curr_id = i + j;
-				curr_update.objects.insert({curr_id, all_objects.at(curr_id)});
-			}
-
-			partial_updates.push_back(curr_update);
+		for (auto& object : all_objects) {
+			EntityID id = object.globalID;
+			update.objects.insert({id, std::move(object)});
 		}
 	} else {
-		SharedGameState curr_update = getUpdateTemplate();
-
-		int num_in_curr_update = 0;
 		for (EntityID id : this->updated_entities) {
-
 			Object* obj = this->objects.getObject(id);
 			if (obj == nullptr) {
-				curr_update.objects.insert({ id, boost::none });
-			} else {
-				curr_update.objects.insert({ id, obj->toShared() });
+				update.objects.insert({ id, boost::none });
+				continue;
 			}
 
-			num_in_curr_update++;
-
-			if (num_in_curr_update >= OBJECTS_PER_UPDATE) {
-				partial_updates.push_back(curr_update);
-				curr_update = getUpdateTemplate();
-				num_in_curr_update = 0;
+			//	Objects that were marked as updated but came out the same as the
+			//	last time they were broadcast don't need to go to anyone. They
+			//	are rebuilt in case they changed again after being marked
+			obj->markDirty();
+			if (obj->takeSharedChanges() == 0) {
+				continue;
 			}
-		}
-
-		//	Make sure that SharedGameState updates are sent while the server is in the
-		//	Lobby phase (to ensure players can see other players lobby status updates)
-		if (num_in_curr_update > 0 || 
-		   this->getPhase() == GamePhase::LOBBY ||
-		   this->getPhase() == GamePhase::INTRO_CUTSCENE) {
-			partial_updates.push_back(curr_update);
+			update.objects.insert({ id, obj->getShared() });
 		}
 
 		// wipe updated entities list
-		std::unordered_set<EntityID> empty;
-		std::swap(this->updated_entities, empty);
+		this->updated_entities.clear();
 	}
 
-	return partial_updates;
+	return update;
+}
+
+bool ServerGameState::hasUpdatedEntities() const {
+	return !this->updated_entities.empty();
 }
 
 SoundTable& ServerGameState::soundTable() {
@@ -181,7 +164,8 @@ void ServerGameState::update(const EventList& events) {
 
 	for (const auto& [src_eid, event] : events) { // cppcheck-suppress unusedVariable
 		// skip any events from dead players
-		auto player = dynamic_cast<Player*>(this->objects.getObject(src_eid));
+		Object* src = this->objects.getObject(src_eid);
+		Player* player = (src != nullptr) ? src->as<Player>() : nullptr;
 		if (player != nullptr && !player->info.is_alive) {
 			continue;
 		}
@@ -190,33 +174,32 @@ void ServerGameState::update(const EventList& events) {
 
 		switch (event.type) {
 		case EventType::ChangeFacing: {
-			auto changeFacingEvent = boost::get<ChangeFacingEvent>(event.data);
+			auto changeFacingEvent = std::get<ChangeFacingEvent>(event.data);
 			obj = this->objects.getObject(changeFacingEvent.entity_to_change_face);
 
 			//	If the object is the DM and the DM is paralyzed, ignore the event
 			if (obj->type == ObjectType::DungeonMaster
-				&& dynamic_cast<DungeonMaster*>(obj)->isParalyzed()) break;
+				&& obj->as<DungeonMaster>()->isParalyzed()) break;
 
 			obj->physics.shared.facing = changeFacingEvent.facing;
-			this->updated_entities.insert({ obj->globalID });
+			this->markAsUpdated(obj);
 			break;
 		}
 
 		case EventType::StartAction: {
-			auto startAction = boost::get<StartActionEvent>(event.data);
+			auto startAction = std::get<StartActionEvent>(event.data);
 			obj = this->objects.getObject(startAction.entity_to_act);
 
 			//	If the object is the DM and the DM is paralyzed, ignore the event
 			if (obj->type == ObjectType::DungeonMaster 
-				&& dynamic_cast<DungeonMaster *>(obj)->isParalyzed()) break;
+				&& obj->as<DungeonMaster>()->isParalyzed()) break;
 
-			this->updated_entities.insert({ obj->globalID });
+			this->markAsUpdated(obj);
 
 			//switch case for action (currently using keys)
 			switch (startAction.action) {
 			case ActionType::MoveCam: {
-				obj->physics.velocity.x = (startAction.movement * PLAYER_SPEED).x;
-				obj->physics.velocity.z = (startAction.movement * PLAYER_SPEED).z;
+				obj->physics.velocity() = moveCamVelocity(obj->physics.velocity(), startAction.movement);
 				if (obj->is_sprinting) {
 					obj->animState = (obj->animState == AnimState::JumpAnim) ? obj->animState : AnimState::SprintAnim;
 				} else {
@@ -225,8 +208,7 @@ void ServerGameState::update(const EventList& events) {
 				break;
 			}
 			case ActionType::Jump: {
-				if (!obj->physics.feels_gravity || obj->physics.velocity.y != 0) { break; }
-				obj->physics.velocity.y += (startAction.movement * JUMP_SPEED / 2.0f).y;
+				if (!startJump(obj->physics.velocity(), startAction.movement, obj->physics.feels_gravity)) { break; }
 				obj->animState = AnimState::JumpAnim;
 				this->sound_table.addNewSoundSource(SoundSource(
 					ServerSFX::PlayerJump,
@@ -241,10 +223,10 @@ void ServerGameState::update(const EventList& events) {
 				if (obj->type == ObjectType::DungeonMaster) {
 					DungeonMaster* dm = this->objects.getDM();
 
-					obj->physics.velocityMultiplier = (dm->physics.shared.corner.y/5.0f) * glm::vec3(1.5f, 1.1f, 1.5f);
+					obj->physics.velocityMultiplier() = (dm->physics.shared.corner.y/5.0f) * glm::vec3(1.5f, 1.1f, 1.5f);
 				}
 				else {
-					obj->physics.velocityMultiplier = glm::vec3(1.5f, 1.1f, 1.5f);
+					obj->physics.velocityMultiplier() = SPRINT_MULTIPLIER;
 					obj->animState = (obj->animState == AnimState::WalkAnim) ? AnimState::SprintAnim : obj->animState;
 					obj->is_sprinting = true;
 				}
@@ -253,10 +235,13 @@ void ServerGameState::update(const EventList& events) {
 			case ActionType::Zoom: { // only for DM
 				DungeonMaster * dm = this->objects.getDM();
 
-				if (dm != nullptr && (dm->physics.shared.corner.y + startAction.movement.y >= 10.0f) && (dm->physics.shared.corner.y + startAction.movement.y <= 100.0f)) {
+				//	Zooms from a whole tick can be merged into one, so clamp to the
+				//	allowed height instead of ignoring zooms that would go past it
+				if (dm != nullptr) {
 					dm->physics.shared.corner += startAction.movement;
+					dm->physics.shared.corner.y = glm::clamp(dm->physics.shared.corner.y, 10.0f, 100.0f);
 
-					obj->physics.velocityMultiplier = (dm->physics.shared.corner.y / 10.0f) * glm::vec3(1.5f, 1.1f, 1.5f);
+					obj->physics.velocityMultiplier() = (dm->physics.shared.corner.y / 10.0f) * glm::vec3(1.5f, 1.1f, 1.5f);
 				}
 
 				break;
@@ -267,31 +252,31 @@ void ServerGameState::update(const EventList& events) {
 		}
 
 		case EventType::StopAction: {
-			auto stopAction = boost::get<StopActionEvent>(event.data);
+			auto stopAction = std::get<StopActionEvent>(event.data);
 			obj = this->objects.getObject(stopAction.entity_to_act);
 
 			//	If the object is the DM and the DM is paralyzed, ignore the event
 			if (obj->type == ObjectType::DungeonMaster
-				&& dynamic_cast<DungeonMaster*>(obj)->isParalyzed()) break;
+				&& obj->as<DungeonMaster>()->isParalyzed()) break;
 
-			this->updated_entities.insert({ obj->globalID });
+			this->markAsUpdated(obj);
 			//switch case for action (currently using keys)
 			switch (stopAction.action) {
 			case ActionType::MoveCam: {
-				obj->physics.velocity.x = 0.0f;
-				obj->physics.velocity.z = 0.0f;
+				obj->physics.velocity().x = 0.0f;
+				obj->physics.velocity().z = 0.0f;
 				obj->animState = AnimState::IdleAnim;
 				break;
 			}
 			case ActionType::Sprint: {
-				obj->physics.velocityMultiplier = glm::vec3(1.0f, 1.0f, 1.0f);
+				obj->physics.velocityMultiplier() = glm::vec3(1.0f, 1.0f, 1.0f);
 
 				// if DM gotta re-adjust velocity to be based on height
 				if (obj->type == ObjectType::DungeonMaster) {
-					obj->physics.velocityMultiplier = (obj->physics.shared.corner.y / 10.0f) * glm::vec3(1.5f, 1.1f, 1.5f);
+					obj->physics.velocityMultiplier() = (obj->physics.shared.corner.y / 10.0f) * glm::vec3(1.5f, 1.1f, 1.5f);
 				}
 
-				if (obj->physics.velocity.x != 0.0f && obj->physics.velocity.z != 0.0f) {
+				if (obj->physics.velocity().x != 0.0f && obj->physics.velocity().z != 0.0f) {
 					obj->animState = AnimState::WalkAnim;
 				} else {
 					obj->animState = AnimState::IdleAnim;
@@ -309,22 +294,22 @@ void ServerGameState::update(const EventList& events) {
 		case EventType::MoveRelative:
 		{
 			//currently just sets the velocity to given 
-			auto moveRelativeEvent = boost::get<MoveRelativeEvent>(event.data);
+			auto moveRelativeEvent = std::get<MoveRelativeEvent>(event.data);
 			obj = this->objects.getObject(moveRelativeEvent.entity_to_move);
 
 			//	If the object is the DM and the DM is paralyzed, ignore the event
 			if (obj->type == ObjectType::DungeonMaster
-				&& dynamic_cast<DungeonMaster*>(obj)->isParalyzed()) break;
+				&& obj->as<DungeonMaster>()->isParalyzed()) break;
 
-			obj->physics.velocity += moveRelativeEvent.movement;
-			this->updated_entities.insert(obj->globalID);
+			obj->physics.velocity() += moveRelativeEvent.movement;
+			this->markAsUpdated(obj);
 			break;
 
 		}
 
 		case EventType::SelectItem:
 		{
-			auto selectItemEvent = boost::get<SelectItemEvent>(event.data);
+			auto selectItemEvent = std::get<SelectItemEvent>(event.data);
 			obj = this->objects.getObject(selectItemEvent.playerEID);
 
 			if (obj == nullptr) {
@@ -345,7 +330,7 @@ void ServerGameState::update(const EventList& events) {
 				else
 					dm->sharedTrapInventory.selected = dm->sharedTrapInventory.selected + selectItemEvent.itemNum;
 
-				this->updated_entities.insert(dm->globalID);
+				this->markAsUpdated(dm);
 			}
 			else {
 				//	If the current selected item is a Mirror and it is used, set it to not be used
@@ -356,7 +341,7 @@ void ServerGameState::update(const EventList& events) {
 
 					if (selectedItem->type == ObjectType::Mirror && selectedItem->iteminfo.used) {
 						//	Set mirror to be unused
-						Mirror* mirror = dynamic_cast<Mirror*>(selectedItem);
+						Mirror* mirror = selectedItem->as<Mirror>();
 					
 						mirror->revertEffect(*this);
 					}
@@ -369,43 +354,43 @@ void ServerGameState::update(const EventList& events) {
 				else
 					player->sharedInventory.selected = player->sharedInventory.selected + selectItemEvent.itemNum;
 
-				this->updated_entities.insert(player->globalID);
+				this->markAsUpdated(player);
 			}
 			break;
 		}
 
 		case EventType::UseItem:
 		{
-			auto useItemEvent = boost::get<UseItemEvent>(event.data);
+			auto useItemEvent = std::get<UseItemEvent>(event.data);
 			int itemSelected = player->sharedInventory.selected - 1;
 
 			if (player->inventory[itemSelected] != -1) {
 				Item* item = this->objects.getItem(player->inventory[itemSelected]);
 				item->useItem(player, *this, itemSelected);
 
-				if (dynamic_cast<Potion*>(item) != nullptr) {
+				if (item->is<Potion>()) {
 					player->animState = AnimState::DrinkPotionAnim;
-				} else if (dynamic_cast<Weapon*>(item) != nullptr) {
+				} else if (item->is<Weapon>()) {
 					player->animState = AnimState::AttackAnim;
 				}
 
-				this->updated_entities.insert(player->globalID);
-				this->updated_entities.insert(item->globalID);
+				this->markAsUpdated(player);
+				this->markAsUpdated(item);
 			}
 			break;
 		}
 
 		case EventType::DropItem:
 		{
-			auto dropItemEvent = boost::get<DropItemEvent>(event.data);
+			auto dropItemEvent = std::get<DropItemEvent>(event.data);
 			int itemSelected = player->sharedInventory.selected - 1;
 
 			if (player->inventory[itemSelected] != -1) {
 				Item* item = this->objects.getItem(player->inventory[itemSelected]);
 				item->dropItem(player, *this, itemSelected, 3.0f);
 
-				this->updated_entities.insert(player->globalID);
-				this->updated_entities.insert(item->globalID);
+				this->markAsUpdated(player);
+				this->markAsUpdated(item);
 			}
 			break;
 		}
@@ -418,7 +403,7 @@ void ServerGameState::update(const EventList& events) {
 			if (dm == nullptr) 
 				break;
 
-			auto trapPlacementEvent = boost::get<TrapPlacementEvent>(event.data);
+			auto trapPlacementEvent = std::get<TrapPlacementEvent>(event.data);
 
 			Grid& currGrid = this->getGrid();
 
@@ -439,13 +424,14 @@ void ServerGameState::update(const EventList& events) {
 			if (cell == nullptr)
 				break;
 
-			this->updated_entities.insert(dm->globalID);
+			this->markAsUpdated(dm);
 
 			// mark previous ghost trap for deletion, if exists
-			if (this->currentGhostTrap != nullptr) {
-				markForDeletion(this->currentGhostTrap->globalID);
-				this->currentGhostTrap = nullptr; // reset ghost trap variable
+			Trap* ghostTrap = this->objects.resolve(this->currentGhostTrap);
+			if (ghostTrap != nullptr) {
+				markForDeletion(ghostTrap->globalID);
 			}
+			this->currentGhostTrap = ObjectHandle<Trap>(); // reset ghost trap variable
 
 			if (trapPlacementEvent.hover) {
 				// only hover for traps, not lightning
@@ -457,19 +443,19 @@ void ServerGameState::update(const EventList& events) {
 				if (trap == nullptr)
 					break;
 
-				this->currentGhostTrap = trap;
+				this->currentGhostTrap = this->objects.handleOf(trap);
 
-				this->currentGhostTrap->setIsDMTrapHover(true);
+				trap->setIsDMTrapHover(true);
 
-				this->updated_entities.insert(trap->globalID);
+				this->markAsUpdated(trap);
 			}
 			else if(trapPlacementEvent.place) {
 				auto curr_time = std::chrono::system_clock::now();
 
 				// Lightning now has its own mana system
 				if (trapPlacementEvent.cell == CellType::Lightning) {
-					if (dm->dmInfo.mana_remaining >= LIGHTNING_MANA) {
-						Weapon* lightning = dm->lightning;
+					Weapon* lightning = this->objects.resolve(dm->lightning);
+					if (lightning != nullptr && dm->dmInfo.mana_remaining >= LIGHTNING_MANA) {
 						glm::vec3 corner(
 							cell->x * Grid::grid_cell_width,
 							0.0f,
@@ -553,7 +539,7 @@ void ServerGameState::update(const EventList& events) {
 				trap->setIsDMTrap(true);
 				trap->setExpiration(curr_time + std::chrono::seconds(10));
 
-				this->updated_entities.insert(trap->globalID);
+				this->markAsUpdated(trap);
 
 				dm->sharedTrapInventory.trapsInCooldown[trapPlacementEvent.cell] = std::chrono::system_clock::to_time_t(curr_time);
 
@@ -568,14 +554,9 @@ void ServerGameState::update(const EventList& events) {
 				float randFloat = randomDouble(0.0, 1.0);
 
 				if (randFloat <= ITEM_SPAWN_PROB) {
-					auto players = this->objects.getPlayers();
-
-					for (int p = 0; p < players.size(); p++) {
-						auto _player = players.get(p);
-
-						if (_player == nullptr)
-							continue;
+					const auto& players = this->objects.getPlayers();
 
+					for (auto _player : players) {
 						GridCell* _cell = this->getGrid().getCell(_player->physics.shared.corner.x / Grid::grid_cell_width, _player->physics.shared.corner.z / Grid::grid_cell_width);
 
 						int randomC = randomInt(std::max(_cell->x - ITEM_SPAWN_BOUND, 0), std::min(this->grid.getColumns() - 1, _cell->x + ITEM_SPAWN_BOUND));
@@ -708,7 +689,7 @@ void ServerGameState::update(const EventList& events) {
 
 							if (spawned_object != nullptr) {
 								this->objects.createObject(spawned_object);
-								this->updated_entities.insert(spawned_object->globalID);
+								this->markAsUpdated(spawned_object);
 							}
 						}
 					}
@@ -774,47 +755,44 @@ void ServerGameState::markForDeletion(EntityID id) {
 
 
 void ServerGameState::markAsUpdated(EntityID id) {
+	Object* object = this->objects.getObject(id);
+	if (object != nullptr) {
+		object->markDirty();
+	}
 	this->updated_entities.insert(id);
 }
 
+void ServerGameState::markAsUpdated(Object* object) {
+	object->markDirty();
+	this->updated_entities.insert(object->globalID);
+}
+
 void ServerGameState::updateMovement() {
 	//	Update all movable objects' positions
 
 	//	Iterate through all objects in the ServerGameState and update their
 	//	positions and velocities if they are movable.
 
-	//	If objects move too fast, split their movement into NUM_INCREMENTAL_STEPS
-	const int NUM_INCREMENTAL_STEPS = 6;
-
-	//	This is the threshold that determines whether we need to use incremental
-	//	steps. If the magnitude of the movementStep vector is greater than this
-	//	value, then we'll split the movementStep into multiple incremental steps
-	const float SINGLE_MOVE_THRESHOLD = 0.33f;
-
-	//	This ratio is the reciprocal of NUM_INCREMENTAL_STEPS
-	const float INCREMENTAL_MOVE_RATIO = 1.0f / NUM_INCREMENTAL_STEPS;
+	//	Work out how far every movable object wants to move in one pass over
+	//	the velocities in the PhysicsStore
+	PhysicsStore& physicsStore = this->objects.physicsStore;
+	physicsStore.integrate();
 
 	//	Iterate through all game objects
-	SmartVector<Object*> gameObjects = this->objects.getMovableObjects();
+	const SmartVector<Object*>& gameObjects = this->objects.getMovableObjects();
 
-	for (int i = 0; i < gameObjects.size(); i++) {
-		//	Get iterating game object
-		Object* object = gameObjects.get(i);
-
-		//	If the object is a nullptr or isn't movable, skip
-		if (object == nullptr || !(object->physics.movable))
+	for (Object* object : gameObjects) {
+		//	If the object isn't movable, skip
+		if (!(object->physics.movable))
 			continue;
 
 		glm::vec3 starting_corner_pos = object->physics.shared.corner;
 
 		//	Object is movable - for now, add to updated entities set
-		this->updated_entities.insert(object->globalID);
+		this->markAsUpdated(object);
 
-		//	Object is movable - compute total movement step
-		glm::vec3 totalMovementStep = 
-			object->physics.velocity * object->physics.velocityMultiplier + object->physics.currTickVelocity;
-		totalMovementStep.x *= object->physics.nauseous;
-		totalMovementStep.z *= object->physics.nauseous;
+		//	Object is movable - get its total movement step
+		glm::vec3 totalMovementStep = physicsStore.getStep(object->movableID);
 
 		if (object->type == ObjectType::DungeonMaster) {
 			object->physics.shared.corner += totalMovementStep;
@@ -836,7 +814,7 @@ void ServerGameState::updateMovement() {
 			continue;
 		}
 
-		auto creature = dynamic_cast<Creature*>(object);
+		auto creature = object->as<Creature>();
 		if (creature != nullptr) {
 			if (creature->statuses.getStatusLength(Status::Slimed) > 0) {
 				totalMovementStep *= 0.5f;
@@ -853,83 +831,17 @@ void ServerGameState::updateMovement() {
 			continue;
 		}
 
-		glm::vec3 movementStep;
-		int numSteps = 0;
-		if (glm::length(totalMovementStep) > SINGLE_MOVE_THRESHOLD) {
-			movementStep = INCREMENTAL_MOVE_RATIO * totalMovementStep;
-		} else {
-			movementStep = totalMovementStep;
-			numSteps = NUM_INCREMENTAL_STEPS - 1;
-		}
-
-		//	Object's current position (before current movementStep)
-		glm::vec3 currentPosition = object->physics.shared.corner;
-
-		//	Perform collision detection + movement update for each incremental
-		//	step (or this loop only iterates once if incremental steps are not
-		//	used)
-		while (numSteps < NUM_INCREMENTAL_STEPS) {
-			numSteps++;
-
-			bool collided = false; 
-			bool collidedX = false;
-			bool collidedZ = false;
-
-			//	Move object to new position and check whether a collision has
-			//	occurred
-			collided = this->hasObjectCollided(object, 
-				currentPosition + movementStep);
-
-			//	If a collision has occurred, repeat collision checking for
-			//	movement if object's position is only updated in the x or z
-			//	axes.
-			if (collided) {
-				//	Test for collision when object only moves by movementStep's
-				//	x component
-				collidedX = this->hasObjectCollided(object,
-					glm::vec3(
-						currentPosition.x + movementStep.x,
-						currentPosition.y,
-						currentPosition.z
-					));
-				
-				//	Test for collision when object only moves by movementStep's
-				//	z component
-				collidedZ = this->hasObjectCollided(object,
-					glm::vec3(
-						currentPosition.x,
-						currentPosition.y,
-						currentPosition.z + movementStep.z
-					));
-			}
-
-			//	Update object's movement
-
-			//	Horizontal movement
-			if (collidedX) {
-				movementStep.x = 0;
-			}
-			if (collidedZ) {
-				movementStep.z = 0;
-			}
-
-			this->objects.moveObject(object, currentPosition + movementStep);
-
-			if (collidedX && collidedZ) {
-				//	Object doesn't move at all - can skip any additional
-				//	steps
-				break;
-			}
-
-			//	Update current position vector
-			currentPosition = object->physics.shared.corner;
-		}
+		//	Collision detection leaves the object wherever it was last checked, so
+		//	move it to where it actually is after each step
+		moveWithCollisions(object->physics.shared.corner, totalMovementStep,
+			[this, object](glm::vec3 corner) { return this->hasObjectCollided(object, corner); },
+			[this, object](glm::vec3 corner) { this->objects.moveObject(object, corner); });
 
         const float spike_low_y = 2.9f;
         if (object->type == ObjectType::SpikeTrap && object->physics.shared.corner.y < spike_low_y) {
             object->physics.shared.corner.y = spike_low_y;
             object->physics.feels_gravity = false;
-            object->physics.velocity.y = 0;
+            object->physics.velocity().y = 0;
             if (starting_corner_pos.y != 3.0f) {
                 this->sound_table.addNewSoundSource(SoundSource(
                     ServerSFX::CeilingSpikeImpact,
@@ -942,12 +854,11 @@ void ServerGameState::updateMovement() {
         }
 
 		//	Vertical movement
-		if (object->physics.shared.corner.y < 0) {
-			//	Clamp object to floor if corner's y position is lower than the floor
-			object->physics.shared.corner.y = 0;
+		//	Clamp object to floor if corner's y position is lower than the floor
+		if (clampToFloor(object->physics.shared.corner)) {
 
 			// After landing, set object's animation to non-jump (idle)
-			if (object->physics.velocity.x != 0.0f && object->physics.velocity.z != 0.0f) {
+			if (object->physics.velocity().x != 0.0f && object->physics.velocity().z != 0.0f) {
 				if (object->is_sprinting) {
 					object->animState = AnimState::SprintAnim;
 				} else {
@@ -990,32 +901,34 @@ void ServerGameState::updateMovement() {
 		//	Update object's gravity velocity if the object is in the air or
 		//	has just landed
 		// update gravity factor
-		if (object->physics.feels_gravity) {
-			if ((object->physics.shared.corner).y > 0) {
-				object->physics.velocity.y -= GRAVITY;
-			}
-			else {
-				object->physics.velocity.y = 0.0f;
-			}
-		}
+		updateGravity(object->physics.velocity(), object->physics.shared.corner.y,
+			object->physics.feels_gravity);
 	}
 
 	//	Handle collision resolution effects
 	//	NOTE - if collision resolution can change an object's position, behavior
 	//	is undefined! (e.g., an object can move into another object but
 	//	collision detection is not performed!)
-	//	Iterate through set of collided objects
-	for (std::pair<Object*, Object*> objects : this->collidedObjects) {
-		objects.first->doCollision(objects.second, *this);
-		objects.second->doCollision(objects.first, *this);
+	//	Iterate through collided object pairs
+	for (const auto& [firstHandle, secondHandle] : this->collidedObjects) {
+		//	Skip the pair if an earlier collision removed either object
+		Object* first = this->objects.resolve(firstHandle);
+		Object* second = this->objects.resolve(secondHandle);
+		if (first == nullptr || second == nullptr) {
+			continue;
+		}
+
+		first->doCollision(second, *this);
+		second->doCollision(first, *this);
 
 		//	Add both collided objects to updated entities set
-		this->updated_entities.insert(objects.first->globalID);
-		this->updated_entities.insert(objects.second->globalID);
+		this->markAsUpdated(first);
+		this->markAsUpdated(second);
 	}
 
-	//	Clear set of collided objects for this timestep
+	//	Clear collided objects for this timestep
 	this->collidedObjects.clear();
+	this->collidedPairs.clear();
 }
 
 bool ServerGameState::hasObjectCollided(Object* object, glm::vec3 newCornerPosition) {
@@ -1026,10 +939,9 @@ bool ServerGameState::hasObjectCollided(Object* object, glm::vec3 newCornerPosit
 	//	Check whether a collision has occurred in object's new corner position
 	//	Iterate through the object's occupied grid cells
 	for (glm::ivec2 cellPos : object->gridCellPositions) {
-		//	Get vector of pointers of all objects that occupy the iterating
-		//	GridCell position
-		std::vector<Object*>& objectsInCell =
-			this->objects.cellToObjects.at(cellPos);
+		//	Get pointers to all objects that occupy the iterating GridCell
+		//	position
+		const CellBucket& objectsInCell = this->objects.spatialGrid.at(cellPos);
 
 		//	Iterate through all objects in this GridCell and check whether the
 		//	current object collides with any of them
@@ -1053,11 +965,10 @@ bool ServerGameState::hasObjectCollided(Object* object, glm::vec3 newCornerPosit
 				//	different order (e.g. {object, otherObj} and 
 				//	{otherObj, object} shouldn't be treated as two separate
 				//	object collision pairs)
-				if (object->globalID < otherObj->globalID) {
-					this->collidedObjects.insert({ object, otherObj });
-				}
-				else {
-					this->collidedObjects.insert({ otherObj, object });
+				Object* first = object->globalID < otherObj->globalID ? object : otherObj;
+				Object* second = first == object ? otherObj : object;
+				if (this->collidedPairs.insert((uint64_t(first->globalID) << 32) | second->globalID)) {
+					this->collidedObjects.push_back({ this->objects.handleOf(first), this->objects.handleOf(second) });
 				}
 
 				//	Exception - if the other object is a floor spike trap,
@@ -1090,98 +1001,82 @@ void ServerGameState::spawnEnemies() {
 }
 
 void ServerGameState::updateItems() {
-	auto items = this->objects.getItems();
-	for (int i = 0; i < items.size(); i++) {
-		auto item = items.get(i);
-		if (item == nullptr) { continue; }
-
+	const auto& items = this->objects.getItems();
+	for (auto item : items) {
 		if (item->physics.movable && item->physics.shared.corner.y == 0) {
-			item->physics.velocity.x = 0;
-			item->physics.velocity.z = 0;
+			item->physics.velocity().x = 0;
+			item->physics.velocity().z = 0;
 		}
 
 		if (item->type == ObjectType::Potion) {
-			Potion* pot = dynamic_cast<Potion*>(item);
+			Potion* pot = item->as<Potion>();
 			if (pot->iteminfo.used) {
 				if (pot->timeOut()) {
 					pot->revertEffect(*this);
-					this->updated_entities.insert(pot->globalID);
+					this->markAsUpdated(pot);
 				}
 			}
 		}
 
 		if (item->type == ObjectType::Mirror) {
-			Mirror* mirror = dynamic_cast<Mirror*>(item);
+			Mirror* mirror = item->as<Mirror>();
 			if (mirror->iteminfo.used) {
 				if (mirror->timeOut()) {
 					mirror->revertEffect(*this);
-					this->updated_entities.insert(mirror->globalID);
+					this->markAsUpdated(mirror);
 				}
 			}
 		}
 
 		if (item->type == ObjectType::Weapon) {
-			Weapon* weapon = dynamic_cast<Weapon*>(item);
+			Weapon* weapon = item->as<Weapon>();
 			weapon->reset(*this);
 		}
 	}
 }
 
 void ServerGameState::updateEnemies() {
-	auto enemies = this->objects.getEnemies();
-
-	for (int e = 0; e < enemies.size(); e++){
-		auto enemy = enemies.get(e);
-		if (enemy == nullptr) continue;
+	const auto& enemies = this->objects.getEnemies();
 
+	for (auto enemy : enemies) {
 		if (enemy->doBehavior(*this)) {
-			this->updated_entities.insert(enemy->globalID);
+			this->markAsUpdated(enemy);
 		}
 	}
 }
 
 void ServerGameState::doProjectileTicks() {
-	auto projectiles = this->objects.getProjectiles();
-	for (int p = 0; p < projectiles.size(); p++) {
-		auto projectile = projectiles.get(p);
-		if (projectile == nullptr) continue;
-
+	const auto& projectiles = this->objects.getProjectiles();
+	for (auto projectile : projectiles) {
 		if (projectile->doTick(*this)) {
-			this->updated_entities.insert(projectile->globalID);
+			this->markAsUpdated(projectile);
 		}
 	}
 }
 
 void ServerGameState::updateAttacks() {
-	auto weaponColliders = this->objects.getWeaponColliders();
-	for (int i = 0; i < weaponColliders.size(); i++) {
-		auto weaponCollider = weaponColliders.get(i);
-		if (weaponCollider == nullptr) { continue; }
+	const auto& weaponColliders = this->objects.getWeaponColliders();
+	for (auto weaponCollider : weaponColliders) {
 		weaponCollider->updateMovement(*this);
 		if(weaponCollider->readyTime(*this)){
 			if (weaponCollider->timeOut(*this)) {
 				this->markForDeletion(weaponCollider->globalID);
 			}
 			else {
-				this->updated_entities.insert(weaponCollider->globalID);
+				this->markAsUpdated(weaponCollider);
 				continue;
 			}
 		}
-		this->updated_entities.insert(weaponCollider->globalID);
+		this->markAsUpdated(weaponCollider);
 	}
 }
 
 void ServerGameState::doTorchlightTicks() {
-	auto torchlights = this->objects.getTorchlights();
-
-	for (int t = 0; t < torchlights.size(); t++) {
-		auto torchlight = torchlights.get(t);
-
-		if (torchlight == nullptr) 
-			continue;
+	const auto& torchlights = this->objects.getTorchlights();
 
+	for (auto torchlight : torchlights) {
 		if (torchlight->doTick(*this, this->dmLightningCutLights, this->dmActionCutLights)) {
-			this->updated_entities.insert(torchlight->globalID);
+			this->markAsUpdated(torchlight);
 		}
 	}
 }
@@ -1212,13 +1107,11 @@ void ServerGameState::updateTraps() {
 			}
 		}
 
-		this->updated_entities.insert(dm->globalID);
+		this->markAsUpdated(dm);
 	}
 
-	auto traps = this->objects.getTraps();
-	for (int i = 0; i < traps.size(); i++) {
-		auto trap = traps.get(i);
-		if (trap == nullptr) { continue; }
+	const auto& traps = this->objects.getTraps();
+	for (auto trap : traps) {
 		if (trap->getIsDMTrap() && dm != nullptr) {
 			if (current_time >= trap->getExpiration()) {
 				int trapsPlaced = dm->getPlacedTraps();
@@ -1238,11 +1131,11 @@ void ServerGameState::updateTraps() {
 		// check for activations
 		if (trap->shouldTrigger(*this)) {
 			trap->trigger(*this);
-			this->updated_entities.insert(trap->globalID);
+			this->markAsUpdated(trap);
 		}
 		if (trap->shouldReset(*this)) {
 			trap->reset(*this);
-			this->updated_entities.insert(trap->globalID);
+			this->markAsUpdated(trap);
 		}
 	}
 }
@@ -1256,11 +1149,8 @@ void ServerGameState::handleDeaths() {
 
 	// thinking that you might have to handle enemies differently either way because
 	// they wont have a SharedPlayerInfo and respawn time stuff they need to
-	auto players = this->objects.getPlayers();
-	for (int p = 0; p < players.size(); p++) {
-		auto player = players.get(p);
-		if (player == nullptr) continue;
-
+	const auto& players = this->objects.getPlayers();
+	for (auto player : players) {
 		if (player->stats.health.current() <= 0 && player->info.is_alive) {
 			//	Player died - increment number of player deaths
 			this->numPlayerDeaths++;
@@ -1283,9 +1173,9 @@ void ServerGameState::handleDeaths() {
 			player->physics.collider = Collider::None;
 			for (int i = 0; i < player->sharedInventory.inventory_size; i++) {
 				if (player->inventory[i] != -1) {
-            		auto item = dynamic_cast<Item*>(this->objects.getItem(player->inventory[i]));
+            		Item* item = this->objects.getItem(player->inventory[i]);
 					item->dropItem(player, *this, i, 0.0f);
-					this->updated_entities.insert(item->globalID);
+					this->markAsUpdated(item);
 				}
 				// hardcode "random" drops
 				if (i == 1){ player->physics.shared.facing *= -1.0f; }
@@ -1295,30 +1185,27 @@ void ServerGameState::handleDeaths() {
 
 			// remove pot effects when killed
 			for (auto it = player->sharedInventory.usedItems.begin(); it != player->sharedInventory.usedItems.end(); ) {
-				auto item = dynamic_cast<Item*>(this->objects.getItem(it->first));
+				Item* item = this->objects.getItem(it->first);
 				if (item->type == ObjectType::Potion) {
-					Potion* pot = dynamic_cast<Potion*>(item);
+					Potion* pot = item->as<Potion>();
 					it = pot->revertEffect(*this);
-					this->updated_entities.insert(pot->globalID);
+					this->markAsUpdated(pot);
 				} else {
 					it++;
 				}
 			}
 
-			this->updated_entities.insert(player->globalID);
-			player->physics.velocity = glm::vec3(0.0f);
+			this->markAsUpdated(player);
+			player->physics.velocity() = glm::vec3(0.0f);
 			player->info.is_alive = false;
 			player->info.respawn_time = getMsSinceEpoch() + 5000; // currently hardcode to wait 5s
 		}
 	}
 
-	auto enemies = this->objects.getEnemies();
-	for (int e = 0; e < enemies.size(); e++) {
-		auto enemy = enemies.get(e);
-		if (enemy == nullptr) continue;
-
+	const auto& enemies = this->objects.getEnemies();
+	for (auto enemy : enemies) {
 		if (enemy->stats.health.current() <= 0) {
-			this->updated_entities.insert(enemy->globalID);
+			this->markAsUpdated(enemy);
 			if (enemy->doDeath(*this)) {
 				this->entities_to_delete.insert(enemy->globalID);
 			}
@@ -1337,14 +1224,11 @@ void ServerGameState::handleDeaths() {
 
 
 void ServerGameState::handleRespawns() {
-	auto players = this->objects.getPlayers();
-	for (int p = 0; p < players.size(); p++) {
-		auto player = players.get(p);
-		if (player == nullptr) continue;
-
+	const auto& players = this->objects.getPlayers();
+	for (auto player : players) {
 		if (!player->info.is_alive) {
 			if (getMsSinceEpoch() >= player->info.respawn_time) {
-				this->updated_entities.insert(player->globalID);
+				this->markAsUpdated(player);
 				player->physics.collider = Collider::Box;
 				player->physics.shared.corner = this->getGrid().getRandomSpawnPoint();
 				player->info.is_alive = true;
@@ -1365,19 +1249,12 @@ void ServerGameState::deleteEntities() {
 }
 
 void ServerGameState::tickStatuses() {
-	auto players = this->objects.getPlayers();
-	for (auto p = 0; p < players.size(); p++) {
-		auto player = players.get(p);
-		if (player == nullptr) continue;
-
-		player->statuses.tickStatus();
-	}
-	auto enemies = this->objects.getEnemies();
-	for (auto e = 0; e < enemies.size(); e++) {
-		auto enemy = enemies.get(e);
-		if (enemy == nullptr) continue;
+	//	Only players' and enemies' statuses wear off over time
+	for (Creature* creature : this->objects.getCreatures()) {
+		if (creature->is<DungeonMaster>())
+			continue;
 
-		enemy->statuses.tickStatus();
+		creature->statuses.tickStatus();
 	}
 }
 
@@ -1405,7 +1282,7 @@ void ServerGameState::updateCompass() {
 	}
 
 	if (!orb_pos.has_value()) {
-		auto items = this->objects.getItems();
+		const auto& items = this->objects.getItems();
 		for (auto i = 0; i < items.size(); i++) {
 			Item* item = items.get(i);
 			if (item == nullptr) continue;
@@ -1417,11 +1294,8 @@ void ServerGameState::updateCompass() {
 		}
 	}*/
 
-	auto players = this->objects.getPlayers();
-	for (auto p = 0; p < players.size(); p++) {
-		auto player = players.get(p);
-		if (player == nullptr) continue;
-
+	const auto& players = this->objects.getPlayers();
+	for (auto player : players) {
 		//auto x = player->physics.shared.getCenterPosition().x - orb_pos->x;
 		//auto y = player->physics.shared.getCenterPosition().y - orb_pos->y;
 
@@ -1435,81 +1309,75 @@ void ServerGameState::updateCompass() {
 }
 
 void ServerGameState::handleTickVelocity() {
-	auto players = this->objects.getPlayers();
-	for (auto p = 0; p < players.size(); p++) {
-		auto player = players.get(p);
-		if (player == nullptr) continue;
-
+	const auto& players = this->objects.getPlayers();
+	for (auto player : players) {
 		// is this actually the best i can do...? -ted
-		if (player->physics.currTickVelocity != glm::vec3(0.0f)) {
-			if (player->physics.currTickVelocity.x > 0) {
-				player->physics.currTickVelocity.x -= 0.05f;
+		if (player->physics.currTickVelocity() != glm::vec3(0.0f)) {
+			if (player->physics.currTickVelocity().x > 0) {
+				player->physics.currTickVelocity().x -= 0.05f;
 			}
-			else if (player->physics.currTickVelocity.x < 0) {
-				player->physics.currTickVelocity.x += 0.05f;
+			else if (player->physics.currTickVelocity().x < 0) {
+				player->physics.currTickVelocity().x += 0.05f;
 			}
 
-			if (player->physics.currTickVelocity.y > 0) {
-				player->physics.currTickVelocity.y -= 0.05f;
+			if (player->physics.currTickVelocity().y > 0) {
+				player->physics.currTickVelocity().y -= 0.05f;
 			}
-			else if (player->physics.currTickVelocity.y < 0) {
-				player->physics.currTickVelocity.y += 0.05f;
+			else if (player->physics.currTickVelocity().y < 0) {
+				player->physics.currTickVelocity().y += 0.05f;
 			}
 
-			if (player->physics.currTickVelocity.z > 0) {
-				player->physics.currTickVelocity.z -= 0.05f;
+			if (player->physics.currTickVelocity().z > 0) {
+				player->physics.currTickVelocity().z -= 0.05f;
 			}
-			else if (player->physics.currTickVelocity.z < 0) {
-				player->physics.currTickVelocity.z += 0.05f;
+			else if (player->physics.currTickVelocity().z < 0) {
+				player->physics.currTickVelocity().z += 0.05f;
 			}
 
-			if (abs(player->physics.currTickVelocity.x) <= 0.05f) {
-				player->physics.currTickVelocity.x = 0.0f;
+			if (abs(player->physics.currTickVelocity().x) <= 0.05f) {
+				player->physics.currTickVelocity().x = 0.0f;
 			}
-			if (abs(player->physics.currTickVelocity.y) <= 0.05f) {
-				player->physics.currTickVelocity.y = 0.0f;
+			if (abs(player->physics.currTickVelocity().y) <= 0.05f) {
+				player->physics.currTickVelocity().y = 0.0f;
 			}
-			if (abs(player->physics.currTickVelocity.z) <= 0.05f) {
-				player->physics.currTickVelocity.z = 0.0f;
+			if (abs(player->physics.currTickVelocity().z) <= 0.05f) {
+				player->physics.currTickVelocity().z = 0.0f;
 			}
 		}
 	}
 
-	auto enemies = this->objects.getEnemies();
-	for (auto e = 0; e < enemies.size(); e++) {
-		auto enemy = enemies.get(e);
-		if (enemy == nullptr) continue;
-
-		if (enemy->physics.currTickVelocity != glm::vec3(0.0f)) {
-			if (enemy->physics.currTickVelocity.x > 0) {
-				enemy->physics.currTickVelocity.x -= 0.05f;
+	const auto& enemies = this->objects.getEnemies();
+	for (auto enemy : enemies) {
+		if (enemy->physics.currTickVelocity() != glm::vec3(0.0f)) {
+			if (enemy->physics.currTickVelocity().x > 0) {
+				enemy->physics.currTickVelocity().x -= 0.05f;
 			}
-			else if (enemy->physics.currTickVelocity.x < 0) {
-				enemy->physics.currTickVelocity.x += 0.05f;
+			else if (enemy->physics.currTickVelocity().x < 0) {
+				enemy->physics.currTickVelocity().x += 0.05f;
 			}
 
-			if (enemy->physics.currTickVelocity.y > 0) {
-				enemy->physics.currTickVelocity.y -= 0.05f;
+			if (enemy->physics.currTickVelocity().y > 0) {
+				enemy->physics.currTickVelocity().y -= 0.05f;
 			}
-			else if (enemy->physics.currTickVelocity.y < 0) {
-				enemy->physics.currTickVelocity.y += 0.05f;
+			else if (enemy->physics.currTickVelocity().y < 0) {
+				enemy->physics.currTickVelocity().y += 0.05f;
 			}
 
-			if (enemy->physics.currTickVelocity.z > 0) {
-				enemy->physics.currTickVelocity.z -= 0.05f;
+			if (enemy->physics.currTickVelocity().z > 0) {
+				enemy->physics.currTickVelocity().z -= 0.05f;
 			}
-			else if (enemy->physics.currTickVelocity.z < 0) {
-				enemy->physics.currTickVelocity.z += 0.05f;
+			else if (enemy->physics.currTickVelocity().z < 0) {
+				enemy->physics.currTickVelocity().z += 0.05f;
 			}
 
-			if (abs(enemy->physics.currTickVelocity.x) <= 0.05f) {
-				enemy->physics.currTickVelocity.x = 0.0f;
+			if (abs(enemy->physics.currTickVelocity().x) <= 0.05f) {
+				enemy->physics.currTickVelocity().x = 0.0f;
 			}
-			if (abs(enemy->physics.currTickVelocity.y) <= 0.05f) {
-				enemy->physics.currTickVelocity.y = 0.0f;
+			if (abs(enemy->physics.currTickVelocity().y) <= 0.05f) {
+				enemy->physics.currTickVelocity().y = 0.0f;
 			}
-			if (abs(enemy->physics.currTickVelocity.z) <= 0.05f) {
-				enemy->physics.currTickVelocity.z = 0.0f;
+			if (abs(enemy->physics.currTickVelocity().z) <= 0.05f) {
+				enemy->physics.currTickVelocity().z = 0.0f;
 			}
 		}
 	}
@@ -1519,12 +1387,7 @@ void ServerGameState::updatePlayerLightningInvulnerabilityStatus() {
 	//	Iterate through all players. If one of the players has a
 	//	lightning invulernability, check whether it should be turned
 	//	off, and if so, turn it off.
-	for (int i = 0; i < this->objects.getPlayers().size(); i++) {
-		Player* player = this->objects.getPlayers().get(i);
-
-		if (player == nullptr)
-			continue;
-
+	for (Player* player : this->objects.getPlayers()) {
 		if (player->isInvulnerableToLightning()) {
 			//	Player is invulnerable to lightning - check whether timeout
 			//	has occurred and if so, set as vulnerable to lightning again
@@ -1584,12 +1447,7 @@ void ServerGameState::transitionToRelayRace() {
 
 	this->relay_finish_time = getSecSinceEpoch() + TIME_LIMIT_S.count();
 	//	Open all exits!
-	for (int i = 0; i < this->objects.getExits().size(); i++) {
-		Exit* exit = this->objects.getExits().get(i);
-
-		if (exit == nullptr)
-			continue;
-
+	for (Exit* exit : this->objects.getExits()) {
 		exit->shared.open = true;
 	}
 }
@@ -1821,6 +1679,7 @@ Trap* ServerGameState::placeTrapInCell(GridCell* cell, CellType type) {
 
 void ServerGameState::loadMaze(const Grid& grid) {
 	this->grid = grid;
+	this->objects.setGridSize(this->grid.getColumns(), this->grid.getRows());
 
 	//	Verify that there's at least one spawn point
 	size_t num_spawn_points = this->grid.getSpawnPoints().size();
@@ -2410,7 +2269,7 @@ std::string ServerGameState::to_string() {
 	representation += "\n\ttimestep len:\t\t" + std::to_string(TIMESTEP_LEN.count());
 	representation += "\n\tobjects: [\n";
 
-	SmartVector<Object*> gameObjects = this->objects.getObjects();
+	const SmartVector<Object*>& gameObjects = this->objects.getObjects();
 
 	for (int i = 0; i < gameObjects.size(); i++) {
 		Object* object = gameObjects.get(i);
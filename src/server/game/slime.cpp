@@ -18,9 +18,9 @@ Slime::Slime(glm::vec3 corner, glm::vec3 facing, int size):
     this->jump_strengths = {0.3f, 0.3f, 0.8f};
 
     this->size = size;
-    this->physics.velocityMultiplier.y = 0.3;
-    this->physics.velocityMultiplier.x = 0.3;
-    this->physics.velocityMultiplier.z = 0.3;
+    this->physics.velocityMultiplier().y = 0.3;
+    this->physics.velocityMultiplier().x = 0.3;
+    this->physics.velocityMultiplier().z = 0.3;
     this->physics.shared.dimensions = glm::vec3(size, size, size);
     this->last_jump_time = std::chrono::system_clock::now();
 
@@ -52,8 +52,8 @@ bool Slime::doBehavior(ServerGameState& state) {
         }
 
         // when it lands again reset its lateral velocity
-        this->physics.velocity.x = 0;
-        this->physics.velocity.z = 0;
+        this->physics.velocity().x = 0;
+        this->physics.velocity().z = 0;
         mutated = true;
     }
 
@@ -69,9 +69,9 @@ bool Slime::doBehavior(ServerGameState& state) {
         ));
 
         this->increaseJumpIndex();
-        this->physics.velocity.y += JUMP_SPEED * 1.75;
+        this->physics.velocity().y += JUMP_SPEED * 1.75;
 
-        auto players = state.objects.getPlayers();
+        const auto& players = state.objects.getPlayers();
         float closest_dist = std::numeric_limits<float>::max();
         Player* target = nullptr;
         for (int p = 0; p < players.size(); p++) {
@@ -97,8 +97,8 @@ bool Slime::doBehavior(ServerGameState& state) {
         }
 
 
-        this->physics.velocity.x = this->jump_strengths.at(this->jump_index) * this->physics.shared.facing.x;
-        this->physics.velocity.z = this->jump_strengths.at(this->jump_index) * this->physics.shared.facing.z;
+        this->physics.velocity().x = this->jump_strengths.at(this->jump_index) * this->physics.shared.facing.x;
+        this->physics.velocity().z = this->jump_strengths.at(this->jump_index) * this->physics.shared.facing.z;
 
         this->last_jump_time = now;
         this->animState = AnimState::JumpAnim;
@@ -109,7 +109,7 @@ bool Slime::doBehavior(ServerGameState& state) {
 }
 
 void Slime::doCollision(Object* other, ServerGameState& state) {
-    Creature* creature = dynamic_cast<Creature*>(other);
+    Creature* creature = other->as<Creature>();
     if (creature == nullptr) return;
 
     if (creature->type == ObjectType::Player) {
@@ -125,16 +125,16 @@ void Slime::doCollision(Object* other, ServerGameState& state) {
 bool Slime::doDeath(ServerGameState& state) {
     if (this->size > 1) {
         auto slime1 = new Slime(this->physics.shared.corner, this->physics.shared.facing, this->size - 1);
-        slime1->physics.velocity.y += JUMP_SPEED;
+        slime1->physics.velocity().y += JUMP_SPEED;
         auto slime2 = new Slime(this->physics.shared.corner, this->physics.shared.facing, this->size - 1);
-        slime2->physics.velocity.y += JUMP_SPEED;
+        slime2->physics.velocity().y += JUMP_SPEED;
 
-        if (this->physics.velocity.x != 0) {
-            slime2->physics.velocity.x = -this->physics.velocity.x;
-            slime2->physics.velocity.z = -this->physics.velocity.z;
+        if (this->physics.velocity().x != 0) {
+            slime2->physics.velocity().x = -this->physics.velocity().x;
+            slime2->physics.velocity().z = -this->physics.velocity().z;
         } else {
-            slime2->physics.velocity.x += 0.5f;
-            slime2->physics.velocity.z += 0.5f;
+            slime2->physics.velocity().x += 0.5f;
+            slime2->physics.velocity().z += 0.5f;
         }
         SpecificID id1 = state.objects.createObject(slime1);
         SpecificID id2 = state.objects.createObject(slime2);
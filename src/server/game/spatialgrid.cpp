@@ -0,0 +1,61 @@
+#include "server/game/spatialgrid.hpp"
+
+#include <algorithm>
+
+/*	CellBucket	*/
+
+CellBucket::CellBucket() :
+	data(local), count(0), capacity(INLINE_CAPACITY)
+{
+}
+
+CellBucket::~CellBucket() {
+	if (this->data != this->local) {
+		delete[] this->data;
+	}
+}
+
+void CellBucket::push(Object* object) {
+	if (this->count == this->capacity) {
+		uint32_t new_capacity = this->capacity * 2;
+		Object** new_data = new Object*[new_capacity];
+		std::copy(this->data, this->data + this->count, new_data);
+
+		if (this->data != this->local) {
+			delete[] this->data;
+		}
+		this->data = new_data;
+		this->capacity = new_capacity;
+	}
+
+	this->data[this->count++] = object;
+}
+
+bool CellBucket::remove(Object* object) {
+	for (uint32_t i = 0; i < this->count; i++) {
+		if (this->data[i] == object) {
+			this->data[i] = this->data[--this->count];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void CellBucket::clear() {
+	this->count = 0;
+}
+
+/*	SpatialGrid	*/
+
+SpatialGrid::SpatialGrid() :
+	columns(0), rows(0)
+{
+}
+
+void SpatialGrid::resize(int columns, int rows) {
+	this->columns = std::max(columns, 0);
+	this->rows = std::max(rows, 0);
+	this->cells = std::make_unique<CellBucket[]>(static_cast<std::size_t>(this->columns) * this->rows);
+	this->fallback.clear();
+}
@@ -58,7 +58,7 @@ void Spell::useItem(Object* other, ServerGameState& state, int itemSelected) {
 
         std::vector<Player*> valid_players;
 
-        auto all_players = state.objects.getPlayers();
+        const auto& all_players = state.objects.getPlayers();
         for (int i = 0; i < all_players.size(); i++) {
             if (all_players.get(i) != nullptr && all_players.get(i)->typeID != player->typeID) {
                 valid_players.push_back(all_players.get(i));
@@ -78,8 +78,8 @@ void Spell::useItem(Object* other, ServerGameState& state, int itemSelected) {
         while (true) {
             auto randomTPx = randomInt(-TELEPORT_RANGE, TELEPORT_RANGE);
             auto randomTPy = randomInt(-TELEPORT_RANGE, TELEPORT_RANGE);
-            r_col = rand_player->gridCellPositions[0].x + randomTPx;
-            r_row = rand_player->gridCellPositions[0].y + randomTPy;
+            r_col = rand_player->gridCellPositions.min.x + randomTPx;
+            r_row = rand_player->gridCellPositions.min.y + randomTPy;
 
             if (!(r_col >= 0 && r_col < grid.getColumns() && r_row >= 0 && r_row < grid.getRows())) {
                 continue;
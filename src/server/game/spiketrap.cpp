@@ -32,7 +32,7 @@ bool SpikeTrap::shouldTrigger(ServerGameState& state) {
     }
 
 
-    auto players = state.objects.getPlayers();
+    const auto& players = state.objects.getPlayers();
     for (int p = 0; p < players.size(); p++) {
         auto player = players.get(p);
         if (player == nullptr) continue;
@@ -63,7 +63,7 @@ void SpikeTrap::trigger(ServerGameState& state) {
     this->reset_dimensions = this->physics.shared.dimensions;
 
     this->physics.feels_gravity = true;
-    this->physics.velocity.y = -50.0f * GRAVITY;
+    this->physics.velocity().y = -50.0f * GRAVITY;
 
     this->dropped_time = std::chrono::system_clock::now();
 }
@@ -83,11 +83,11 @@ void SpikeTrap::reset(ServerGameState& state) {
 }
 
 void SpikeTrap::doCollision(Object* other, ServerGameState& state) {
-    auto creature = dynamic_cast<Creature*>(other);
+    auto creature = other->as<Creature>();
     if (creature == nullptr) return; // not a creature, so don't really care
 
     // if it is falling
-    if (this->physics.velocity.y < 0 && this->physics.shared.corner.y != 0) {
+    if (this->physics.velocity().y < 0 && this->physics.shared.corner.y != 0) {
         creature->stats.health.decrease(DAMAGE);
     }
 }
@@ -40,7 +40,7 @@ void TeleporterTrap::doCollision(Object* other, ServerGameState& state) {
 
     std::optional<glm::vec3> exit_pos;
 
-    auto exits = state.objects.getExits();
+    const auto& exits = state.objects.getExits();
     for (int i = 0; i < exits.size(); i++) {
         auto exit = exits.get(i);
         if (exit == nullptr) continue;
@@ -45,13 +45,13 @@ void Weapon::useItem(Object* other, ServerGameState& state, int itemSelected) {
     if (this->resetAttack) {
         switch (weaponType) {
         case WeaponType::Sword:
-            state.objects.createObject(new MediumAttack(player, attack_origin, player->physics.shared.facing));
+            state.objects.createObject(new MediumAttack(state.objects.handleOf(player), attack_origin, player->physics.shared.facing));
             break;
         case WeaponType::Dagger:
-            state.objects.createObject(new ShortAttack(player, attack_origin, player->physics.shared.facing));
+            state.objects.createObject(new ShortAttack(state.objects.handleOf(player), attack_origin, player->physics.shared.facing));
             break;
         case WeaponType::Hammer:
-            state.objects.createObject(new BigAttack(player, attack_origin, player->physics.shared.facing));
+            state.objects.createObject(new BigAttack(state.objects.handleOf(player), attack_origin, player->physics.shared.facing));
             break;
         default: 
             break;
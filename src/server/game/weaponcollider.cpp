@@ -9,11 +9,11 @@
 #include <chrono>
 
 
-WeaponCollider::WeaponCollider(Player* usedPlayer, glm::vec3 corner, glm::vec3 facing, glm::vec3 dimensions, ModelType model, WeaponOptions&& options):
+WeaponCollider::WeaponCollider(ObjectHandle<Player> usedPlayer, glm::vec3 corner, glm::vec3 facing, glm::vec3 dimensions, ModelType model, WeaponOptions&& options):
     Object(ObjectType::WeaponCollider, Physics(true, Collider::None, corner, facing, dimensions), model),
     opt(options)
 {
-    this->physics.velocityMultiplier = glm::vec3(0.0f);
+    this->physics.velocityMultiplier() = glm::vec3(0.0f);
     this->preparing_time = std::chrono::system_clock::now();
     this->usedPlayer = usedPlayer;
     this->info.attacked = false;
@@ -27,13 +27,16 @@ WeaponCollider::WeaponCollider(Player* usedPlayer, glm::vec3 corner, glm::vec3 f
 }
 
 void WeaponCollider::doCollision(Object* other, ServerGameState& state) {
-    Creature* creature = dynamic_cast<Creature*>(other);
+    Creature* creature = other->as<Creature>();
     if (creature == nullptr) return;
 
+    // nullptr for lightning, or if the player has left the game since attacking
+    Player* usedPlayer = state.objects.resolve(this->usedPlayer);
+
     // don't dmg yourself
-    if (this->usedPlayer != nullptr) {
+    if (usedPlayer != nullptr) {
 
-        if (creature->globalID == this->usedPlayer->globalID) return;
+        if (creature->globalID == usedPlayer->globalID) return;
     }
 
         //  If this weapon collider is a lightning bolt and it collides with
@@ -42,7 +45,7 @@ void WeaponCollider::doCollision(Object* other, ServerGameState& state) {
     //  Also, paralyze the DM for some amount of time.
     if (this->info.lightning && creature->type == ObjectType::Player) {
         std::cout << "Applying lightning damage!" << std::endl;
-        Player* player = dynamic_cast<Player*>(creature);
+        Player* player = creature->as<Player>();
 
         //  Return early if this player is currently invulnerable to lightning
         if (player->isInvulnerableToLightning()) {
@@ -63,7 +66,7 @@ void WeaponCollider::doCollision(Object* other, ServerGameState& state) {
                 std::cout << "Player using a mirror got hit by a lightning bolt!" << std::endl;
                 std::cout << "Deleting mirror!" << std::endl;
 
-                Mirror* mirror = dynamic_cast<Mirror*>(item);
+                Mirror* mirror = item->as<Mirror>();
 
                 //  Add mirror shatter sound effect
                 state.soundTable().addNewSoundSource(SoundSource(
@@ -100,27 +103,30 @@ void WeaponCollider::doCollision(Object* other, ServerGameState& state) {
     // do damage if creature
     creature->stats.health.decrease(this->opt.damage);
 
-    if (this->usedPlayer == nullptr) {
+    if (usedPlayer == nullptr) {
         auto knockback = glm::normalize(
             other->physics.shared.getCenterPosition() - this->physics.shared.getCenterPosition());
 
-        creature->physics.currTickVelocity = 0.7f * knockback;
+        creature->physics.currTickVelocity() = 0.7f * knockback;
     }
     else {
         auto knockback = glm::normalize(
-            other->physics.shared.getCenterPosition() - this->usedPlayer->physics.shared.getCenterPosition());
+            other->physics.shared.getCenterPosition() - usedPlayer->physics.shared.getCenterPosition());
 
-        creature->physics.currTickVelocity = 0.4f * knockback;
+        creature->physics.currTickVelocity() = 0.4f * knockback;
     }
 }
 
 void WeaponCollider::updateMovement(ServerGameState& state) {
     if(!this->opt.followPlayer) { return; }
 
+    Player* usedPlayer = state.objects.resolve(this->usedPlayer);
+    if (usedPlayer == nullptr) { return; }
+
     glm::vec3 attack_origin(
-        this->usedPlayer->physics.shared.getCenterPosition().x,
-        this->usedPlayer->physics.shared.getCenterPosition().y,
-        this->usedPlayer->physics.shared.getCenterPosition().z
+        usedPlayer->physics.shared.getCenterPosition().x,
+        usedPlayer->physics.shared.getCenterPosition().y,
+        usedPlayer->physics.shared.getCenterPosition().z
     );
 
     // Messy manual computation so it melees in the proper direction
@@ -133,7 +139,7 @@ void WeaponCollider::updateMovement(ServerGameState& state) {
         multiplier = 2.5f;
     }
     
-    attack_origin += (this->usedPlayer->physics.shared.facing + glm::vec3(-offset)) * multiplier;
+    attack_origin += (usedPlayer->physics.shared.facing + glm::vec3(-offset)) * multiplier;
     attack_origin.y *= 0;
 
     state.objects.moveObject(this, attack_origin);
@@ -0,0 +1,119 @@
+#include "server/inputcoalescer.hpp"
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * Kinds of events that can be coalesced, each of which a client has at most
+ * one pending copy of at a time
+ */
+enum class InputSlot {
+    Facing,
+    Hover,
+    MoveCam,
+    Jump,
+    Zoom,
+    NUM_SLOTS
+};
+
+/**
+ * @returns Which kind of coalescable input the event is, or nullopt if the event has
+ * to be applied exactly as it was received
+ */
+static std::optional<InputSlot> inputSlot(EntityID src_eid, const Event& event) {
+    switch (event.type) {
+        case EventType::ChangeFacing: {
+            const auto& data = std::get<ChangeFacingEvent>(event.data);
+            if (data.entity_to_change_face == src_eid) {
+                return InputSlot::Facing;
+            }
+            break;
+        }
+        case EventType::TrapPlacement: {
+            const auto& data = std::get<TrapPlacementEvent>(event.data);
+            if (data.entity_to_act == src_eid && data.hover && !data.place) {
+                return InputSlot::Hover;
+            }
+            break;
+        }
+        case EventType::StartAction: {
+            const auto& data = std::get<StartActionEvent>(event.data);
+            if (data.entity_to_act != src_eid) {
+                break;
+            }
+            switch (data.action) {
+                case ActionType::MoveCam: return InputSlot::MoveCam;
+                case ActionType::Jump: return InputSlot::Jump;
+                case ActionType::Zoom: return InputSlot::Zoom;
+                default: break;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return std::nullopt;
+}
+
+EventList coalesceInputs(const EventList& events, InputCoalescingStats& stats) {
+    using PendingSlots = std::array<std::optional<std::size_t>, static_cast<std::size_t>(InputSlot::NUM_SLOTS)>;
+
+    // Index into kept of each client's pending copy of each kind of input
+    std::unordered_map<EntityID, PendingSlots> pending;
+
+    EventList kept;
+    std::vector<bool> dropped;
+    kept.reserve(events.size());
+    dropped.reserve(events.size());
+
+    for (const auto& [src_eid, event] : events) {
+        PendingSlots& slots = pending[src_eid];
+
+        auto slot = inputSlot(src_eid, event);
+        if (!slot.has_value()) {
+            // Anything after this has to be applied after it, so nothing can be
+            // merged across it
+            slots.fill(std::nullopt);
+            kept.push_back({src_eid, event});
+            dropped.push_back(false);
+            continue;
+        }
+
+        std::optional<std::size_t>& prev = slots[static_cast<std::size_t>(slot.value())];
+        if (prev.has_value()) {
+            stats.events_collapsed++;
+
+            switch (slot.value()) {
+                case InputSlot::Jump:
+                    // already jumping this tick
+                    continue;
+                case InputSlot::Zoom:
+                    std::get<StartActionEvent>(kept[prev.value()].second.data).movement +=
+                        std::get<StartActionEvent>(event.data).movement;
+                    continue;
+                default:
+                    // the newer one replaces the older one
+                    dropped[prev.value()] = true;
+                    break;
+            }
+        }
+
+        prev = kept.size();
+        kept.push_back({src_eid, event});
+        dropped.push_back(false);
+    }
+
+    stats.events_received += events.size();
+
+    EventList result;
+    result.reserve(kept.size());
+    for (std::size_t i = 0; i < kept.size(); i++) {
+        if (!dropped[i]) {
+            result.push_back(std::move(kept[i]));
+        }
+    }
+
+    return result;
+}
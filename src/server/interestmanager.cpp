@@ -0,0 +1,201 @@
+#include "server/interestmanager.hpp"
+
+#include <cstdlib>
+
+#include "server/game/grid.hpp"
+#include "server/game/item.hpp"
+#include "server/game/exit.hpp"
+
+InterestManager::InterestManager():
+    full_map(false),
+    has_center(false),
+    last_center(0, 0)
+{
+}
+
+SharedGameState InterestManager::filter(const SharedGameState& update, ObjectManager& objects,
+    EntityID viewer, bool full_map, int radius) {
+    if (this->full_map) {
+        // client already has the whole map, so every update is relevant
+        return update;
+    }
+
+    if (full_map || radius <= 0) {
+        SharedGameState result = update;
+        this->_spawnEverything(result, objects);
+        this->full_map = true;
+        this->known.clear();
+        return result;
+    }
+
+    SharedGameState result = update;
+    result.objects.clear();
+
+    // If the viewer doesn't exist there is nothing to be near, so only the
+    // objects that are always relevant get through
+    Object* viewer_obj = objects.getObject(viewer);
+    glm::ivec2 center = this->last_center;
+    if (viewer_obj != nullptr) {
+        center = Grid::getGridCellFromPosition(viewer_obj->physics.shared.getCenterPosition());
+    } else {
+        radius = -1;
+    }
+
+    for (const auto& [id, obj] : update.objects) {
+        if (!obj.has_value()) {
+            // only tell the client about deletions of objects it has
+            if (this->known.erase(id) > 0) {
+                result.objects.insert({id, boost::none});
+            }
+            continue;
+        }
+
+        Object* object = objects.getObject(id);
+        if (object != nullptr && _isRelevant(object, center, radius)) {
+            result.objects.insert({id, obj});
+            this->known.insert(id);
+        } else if (this->known.erase(id) > 0) {
+            // moved out of range
+            result.objects.insert({id, boost::none});
+        }
+    }
+
+    // Unchanged objects can only come into or go out of range if the viewer moved
+    if (viewer_obj != nullptr && (!this->has_center || center != this->last_center)) {
+        this->_rescan(result, objects, center, radius);
+        this->has_center = true;
+        this->last_center = center;
+    }
+
+    return result;
+}
+
+void InterestManager::reset() {
+    this->known.clear();
+    this->full_map = false;
+    this->has_center = false;
+}
+
+std::size_t InterestManager::numKnown() const {
+    return this->known.size();
+}
+
+bool InterestManager::isFullMap() const {
+    return this->full_map;
+}
+
+bool InterestManager::isAlwaysRelevant(const Object* object) {
+    switch (object->type) {
+        case ObjectType::Player:
+        case ObjectType::DungeonMaster:
+        case ObjectType::Exit:
+        case ObjectType::Orb:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool InterestManager::_isRelevant(const Object* object, glm::ivec2 center, int radius) {
+    if (isAlwaysRelevant(object)) {
+        return true;
+    }
+
+    if (radius < 0) {
+        return false;
+    }
+
+    for (const glm::ivec2& cell : object->gridCellPositions) {
+        if (std::abs(cell.x - center.x) <= radius && std::abs(cell.y - center.y) <= radius) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void InterestManager::_spawnEverything(SharedGameState& result, ObjectManager& objects) {
+    const auto& all_objects = objects.getObjects();
+    for (Object* object : all_objects) {
+        if (this->known.contains(object->globalID) ||
+            result.objects.contains(object->globalID)) {
+            continue;
+        }
+
+        result.objects.insert({object->globalID, object->getShared()});
+    }
+}
+
+void InterestManager::_rescan(SharedGameState& result, ObjectManager& objects,
+    glm::ivec2 center, int radius) {
+    std::unordered_set<EntityID> in_range;
+
+    for (int x = center.x - radius; x <= center.x + radius; x++) {
+        for (int y = center.y - radius; y <= center.y + radius; y++) {
+            glm::ivec2 cell(x, y);
+            if (!objects.spatialGrid.inBounds(cell)) {
+                continue;
+            }
+
+            for (Object* object : objects.spatialGrid.at(cell)) {
+                in_range.insert(object->globalID);
+            }
+        }
+    }
+
+    // out of bounds cells all share one bucket, so check which cells those
+    // objects are actually in
+    for (Object* object : objects.spatialGrid.outOfBounds()) {
+        for (glm::ivec2 cell : object->gridCellPositions) {
+            if (std::abs(cell.x - center.x) <= radius && std::abs(cell.y - center.y) <= radius) {
+                in_range.insert(object->globalID);
+                break;
+            }
+        }
+    }
+
+    const auto& players = objects.getPlayers();
+    for (Player* player : players) {
+        in_range.insert(player->globalID);
+    }
+
+    const auto& exits = objects.getExits();
+    for (Exit* exit : exits) {
+        in_range.insert(exit->globalID);
+    }
+
+    const auto& items = objects.getItems();
+    for (Item* item : items) {
+        if (item->type == ObjectType::Orb) {
+            in_range.insert(item->globalID);
+        }
+    }
+
+    if (objects.getDM() != nullptr) {
+        in_range.insert(objects.getDM()->globalID);
+    }
+
+    // spawn everything that came into range
+    for (EntityID id : in_range) {
+        if (this->known.contains(id) || result.objects.contains(id)) {
+            continue;
+        }
+
+        Object* object = objects.getObject(id);
+        if (object != nullptr) {
+            result.objects.insert({id, object->getShared()});
+            this->known.insert(id);
+        }
+    }
+
+    // and despawn everything that went out of range
+    for (auto it = this->known.begin(); it != this->known.end();) {
+        if (in_range.contains(*it)) {
+            it++;
+            continue;
+        }
+
+        result.objects.insert_or_assign(*it, boost::none);
+        it = this->known.erase(it);
+    }
+}
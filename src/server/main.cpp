@@ -22,8 +22,12 @@ int main(int argc, char** argv) {
 
         if (wait_time <= 0ms) {
             std::cerr << "WARNING: did not meet tick rate!\n";
+            // Still give the sessions a chance to flush and receive what is
+            // ready, without waiting on anything
+            context.poll();
         } else {
             // Wait until next tick, and while idle accept new TCP connections
+            // and send / receive packets
             context.run_for(wait_time);
         }
     }
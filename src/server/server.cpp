@@ -9,13 +9,13 @@
 #include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include <ostream>
 #include <queue>
 #include <thread>
 #include <chrono>
 #include <memory>
 
-#include "boost/variant/get.hpp"
 #include "server/game/exit.hpp"
 #include "server/game/objectmanager.hpp"
 #include "server/game/weaponcollider.hpp"
@@ -31,6 +31,7 @@
 #include "server/game/projectile.hpp"
 #include "shared/network/session.hpp"
 #include "shared/network/packet.hpp"
+#include "shared/network/packetizer.hpp"
 #include "shared/network/constants.hpp"
 #include "shared/utilities/config.hpp"
 #include "shared/game/sharedobject.hpp"
@@ -54,6 +55,12 @@ Server::Server(boost::asio::io_context& io_context, GameConfig config)
 {
     _doAccept(); // start asynchronously accepting
 
+    if (config.server.udp_snapshots) {
+        this->snapshot_channel = std::make_shared<SnapshotChannel>(
+            udp::socket(io_context, udp::endpoint(udp::v4(), 0)));
+        this->snapshot_channel->listen();
+    }
+
     if (config.server.lobby_broadcast) {
         this->lobby_broadcaster.startBroadcasting(ServerLobbyBroadcastPacket {
             .lobby_name  = config.server.lobby_name,
@@ -85,6 +92,25 @@ EventList Server::getAllClientEvents() {
             // Get events from the current session
             std::vector<Event> sessionEvents = session->handleAllReceivedPackets();
 
+            // Snapshot acknowledgements are only relevant to the networking layer, so
+            // consume them here instead of passing them on to the game state
+            std::erase_if(sessionEvents, [this, eid](const Event& e) {
+                if (e.type != EventType::AckSnapshot) {
+                    return false;
+                }
+                this->snapshot_trackers[eid].acknowledge(std::get<AckSnapshotEvent>(e.data).snapshot_id);
+                return true;
+            });
+
+            // Everything up to the last InputFrame received is applied this tick
+            const auto& input_frame = session->getLastInputFrame();
+            if (input_frame.has_value()) {
+                this->processed_inputs.insert_or_assign(eid, ProcessedInputFrame {
+                    .frame = input_frame.value(),
+                    .timestep = this->state.getTimestep()
+                });
+            }
+
             // Put events into the allEvents vector, prepending each event with the id of the 
             // client that requested it
             std::transform(sessionEvents.begin(), sessionEvents.end(), std::back_inserter(allEvents), 
@@ -97,13 +123,149 @@ EventList Server::getAllClientEvents() {
     return allEvents;
 }
 
-void Server::sendUpdateToAllClients(Event event) {
+void Server::sendUpdateToAllClients(const Event& event) {
+    // Serialize the event a single time, and then hand the same immutable packet
+    // to every session instead of having each session re-serialize it
+    auto serialize_start = std::chrono::high_resolution_clock::now();
+    auto packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(event));
+    auto serialize_stop = std::chrono::high_resolution_clock::now();
+
+    BroadcastStats& stats = this->curr_tick_broadcast_stats;
+    stats.packets_serialized++;
+    stats.bytes_serialized += packet->size();
+    stats.serialize_time += serialize_stop - serialize_start;
+
     for (const auto& [_eid, is_dm, _ip, session] : this->sessions) { // cppcheck-suppress unusedVariable
         if (session->isOkay()) {
-            session->sendEvent(event);
+            session->sendPacket(packet);
+            stats.packets_sent++;
+            stats.bytes_sent += packet->size();
         }
     }
+}
+
+void Server::sendSnapshotToAllClients(const SharedGameState& update) {
+    BroadcastStats& stats = this->curr_tick_broadcast_stats;
+
+    for (const auto& [eid, is_dm, ip, session] : this->sessions) {
+        if (!session->isOkay()) {
+            continue;
+        }
+
+        SnapshotTracker& tracker = this->snapshot_trackers[eid];
+
+        // Once the client has said hello over UDP its snapshots go there, where a lost
+        // datagram can't hold up the ones after it. That means any of them can go
+        // missing, so the tracker has to keep resending until they're acknowledged
+        bool use_udp = this->snapshot_channel != nullptr && this->snapshot_channel->hasPeer(eid, ip);
+        tracker.setReliable(!use_udp);
+
+        // Don't pile more snapshots onto a client that can't keep up, since they
+        // will be out of date by the time they get there. Instead remember what was
+        // in them, and send the current state of those objects once it catches up.
+        // The same goes for a client that doesn't have the full state yet
+        if (this->resyncs.contains(eid) || (!use_udp && session->isBackedUp())) {
+            tracker.defer(update);
+            stats.snapshots_deferred++;
+            continue;
+        }
+
+        auto serialize_start = std::chrono::high_resolution_clock::now();
+
+        std::unordered_set<EntityID> deferred = tracker.takeDeferred();
+        SharedGameState client_update;
+        if (!deferred.empty()) {
+            client_update = update;
+            for (EntityID id : deferred) {
+                if (client_update.objects.contains(id)) {
+                    continue;
+                }
+                Object* obj = this->state.objects.getObject(id);
+                if (obj == nullptr) {
+                    client_update.objects.insert({id, boost::none});
+                } else {
+                    client_update.objects.insert({id, obj->getShared()});
+                }
+            }
+        }
+
+        // Only send the objects near this client, spawning and despawning whatever
+        // moved into or out of range
+        SharedGameState relevant = this->interest_managers[eid].filter(
+            deferred.empty() ? update : client_update, this->state.objects, eid, is_dm,
+            this->config.server.interest_radius);
+        stats.objects_sent += relevant.objects.size();
+
+        // Every client has a different baseline, so this has to be serialized per client
+        auto packets = packetizeSnapshot(this->world_eid, tracker.encode(relevant),
+            use_udp ? SNAPSHOT_DATAGRAM_BYTES : this->config.server.max_packet_bytes);
+        auto serialize_stop = std::chrono::high_resolution_clock::now();
+
+        stats.serialize_time += serialize_stop - serialize_start;
+        for (const auto& packet : packets) {
+            // a single object too big for a datagram still has to get there somehow
+            if (!use_udp || !this->snapshot_channel->sendSnapshot(eid, packet)) {
+                session->sendPacket(packet);
+            } else {
+                this->datagram_telemetry[eid].recordSent(*packet);
+            }
 
+            stats.packets_serialized++;
+            stats.packets_sent++;
+            stats.bytes_serialized += packet->size();
+            stats.bytes_sent += packet->size();
+        }
+
+        // Tell players where they really are, and how much of their input that
+        // includes, so they can correct their predictions. Only the newest one
+        // matters, so it can go over UDP with the snapshots
+        auto processed = this->processed_inputs.find(eid);
+        Object* player = this->state.objects.getObject(eid);
+        if (!is_dm && processed != this->processed_inputs.end() && player != nullptr) {
+            auto reconcile = PackagedPacket::make_shared(PacketType::Event, EventPacket {
+                .event = Event(this->world_eid, EventType::ReconcileMovement, ReconcileMovementEvent(
+                    processed->second.frame.sequence, player->physics.shared.corner,
+                    player->physics.velocity(), player->physics.velocityMultiplier()))
+            });
+            if (!use_udp || !this->snapshot_channel->sendSnapshot(eid, reconcile)) {
+                session->sendPacket(reconcile);
+            } else {
+                this->datagram_telemetry[eid].recordSent(*reconcile);
+            }
+        }
+    }
+}
+
+const BroadcastStats& Server::getLastTickBroadcastStats() const {
+    return this->last_tick_broadcast_stats;
+}
+
+const NetworkTelemetry& Server::getLastTickTelemetry() const {
+    return this->last_tick_telemetry;
+}
+
+const InputCoalescingStats& Server::getLastTickInputStats() const {
+    return this->last_tick_input_stats;
+}
+
+std::optional<ProcessedInputFrame> Server::getLastProcessedInput(EntityID client) const {
+    auto processed = this->processed_inputs.find(client);
+    if (processed == this->processed_inputs.end()) {
+        return std::nullopt;
+    }
+    return processed->second;
+}
+
+bool Server::isResyncing(EntityID client) const {
+    return this->resyncs.contains(client);
+}
+
+unsigned short Server::getPort() const {
+    return this->acceptor.local_endpoint().port();
+}
+
+unsigned int Server::getTimestep() const {
+    return this->state.getTimestep();
 }
 
 void Server::sendLightSourceUpdates(EntityID playerID) {
@@ -127,44 +289,32 @@ void Server::sendLightSourceUpdates(EntityID playerID) {
 
     std::priority_queue<EntityID, std::vector<EntityID>, CompareLightPos> closestPointLights(CompareLightPos(playerPos, this->state.objects));
 
-    for(int i = 0; i < this->state.objects.getTorchlights().size(); i++) {
-        auto torch = this->state.objects.getTorchlights().get(i);
-        if (torch == nullptr) continue;
+    for (auto torch : this->state.objects.getTorchlights()) {
         closestPointLights.push(torch->globalID);
     }
 
-    for(int i = 0; i < this->state.objects.getExits().size(); i++) {
-        auto exit = this->state.objects.getExits().get(i);
-        if (exit == nullptr) continue;
+    for (auto exit : this->state.objects.getExits()) {
         closestPointLights.push(exit->globalID);
     }
 
-    for(int i = 0; i < this->state.objects.getItems().size(); i++) {
-        auto item = this->state.objects.getItems().get(i);
-        if (item == nullptr) continue;
+    for (auto item : this->state.objects.getItems()) {
         if (item->type != ObjectType::Orb) continue;
         closestPointLights.push(item->globalID);
         break; // only one orb
     }
 
-    for(int i = 0; i < this->state.objects.getWeaponColliders().size(); i++) {
-        auto item = this->state.objects.getWeaponColliders().get(i);
-        if (item == nullptr) continue;
+    for (auto item : this->state.objects.getWeaponColliders()) {
         if (item->modelType != ModelType::Lightning) continue;
         closestPointLights.push(item->globalID);
         break; // only one lightning 
     }
 
-    for(int i = 0; i < this->state.objects.getTraps().size(); i++) {
-        auto lava = this->state.objects.getTraps().get(i);
-        if (lava == nullptr) continue;
+    for (auto lava : this->state.objects.getTraps()) {
         if (lava->type != ObjectType::Lava) continue;
         closestPointLights.push(lava->globalID);
     }
 
-    for(int i = 0; i < this->state.objects.getProjectiles().size(); i++) {
-        auto proj = this->state.objects.getProjectiles().get(i);
-        if (proj == nullptr) continue;
+    for (auto proj : this->state.objects.getProjectiles()) {
         if (proj->modelType != ModelType::Arrow && proj->modelType != ModelType::Fireball && proj->modelType != ModelType::SpellOrb) continue;
         closestPointLights.push(proj->globalID);
 
@@ -212,6 +362,9 @@ void Server::sendLightSourceUpdates(EntityID playerID) {
 std::chrono::milliseconds Server::doTick() {
     auto start = std::chrono::high_resolution_clock::now();
 
+    this->curr_tick_broadcast_stats = BroadcastStats();
+    this->curr_tick_input_stats = InputCoalescingStats();
+
     switch (this->state.getPhase()) {
         case GamePhase::LOBBY: {
             //  Go through sessions and update GameState lobby info
@@ -240,7 +393,7 @@ std::chrono::milliseconds Server::doTick() {
                     continue;
                 }
 
-                LobbyActionEvent lobbyEvent = boost::get<LobbyActionEvent>(event.data);
+                LobbyActionEvent lobbyEvent = std::get<LobbyActionEvent>(event.data);
 
                 switch (lobbyEvent.action) {
                 case LobbyActionEvent::Action::Ready: {
@@ -314,7 +467,7 @@ std::chrono::milliseconds Server::doTick() {
                             Weapon* lightning = dynamic_cast<Weapon*>(this->state.objects.getItem(lightningID));
                             lightning->iteminfo.held = true;
                             lightning->physics.collider = Collider::None;
-                            dm->lightning = lightning;
+                            dm->lightning = this->state.objects.handleOf(lightning);
 
                             auto& by_id = this->sessions.get<IndexByID>();
                             auto session_entry = by_id.find(dm->globalID);
@@ -335,7 +488,8 @@ std::chrono::milliseconds Server::doTick() {
                                     });
 
                                     session->sendPacket(PackagedPacket::make_shared(PacketType::ServerAssignEID,
-                                        ServerAssignEIDPacket{ .eid = dm->globalID, .is_dungeon_master = true }));
+                                        ServerAssignEIDPacket{ .eid = dm->globalID, .is_dungeon_master = true,
+                                            .snapshot_port = this->_getSnapshotPort() }));
                                 }
                             }
 
@@ -349,20 +503,14 @@ std::chrono::milliseconds Server::doTick() {
                             }
 
                             this->state.markAsUpdated(dm->globalID);
-                            for (const auto& partial_update : this->state.generateSharedGameState(false)) {
-                                sendUpdateToAllClients(Event(this->world_eid, EventType::LoadGameState, LoadGameStateEvent(partial_update)));
-                            }
+                            sendSnapshotToAllClients(this->state.generateSharedGameState(false));
 
                             std::cout << "Assigned player " + std::to_string(index) + " to be the DM" << std::endl;
                         }
 
                         int player_idx = 0;  // only increment when assigning a model                          
 
-                        auto players = this->state.objects.getPlayers();
-                        for (int i = 0; i < players.size(); i++) {
-                            auto player = players.get(i);
-                            if (player == nullptr) continue;
-
+                        for (auto player : this->state.objects.getPlayers()) {
                             if (player_idx == 0) {
                                 player->modelType = ModelType::PlayerFire;
                             }
@@ -413,7 +561,9 @@ std::chrono::milliseconds Server::doTick() {
         case GamePhase::GAME: {
             EventList allClientEvents = getAllClientEvents();
 
-            updateGameState(allClientEvents);
+            // Clients send input every frame, which is several times per tick, so only
+            // apply what actually matters for this tick
+            updateGameState(coalesceInputs(allClientEvents, this->curr_tick_input_stats));
 
             static int curr_player_idx = 0;
 
@@ -436,15 +586,27 @@ std::chrono::milliseconds Server::doTick() {
     }
 
     this->sendSoundCommands();
+    this->_sendResyncs();
 
+    // Objects that were updated but didn't change are left out of the snapshot,
+    // but clients still get one every tick that anything was updated
+    bool has_updates = this->state.hasUpdatedEntities();
     auto shared_gamestate = this->state.generateSharedGameState(false);
 
-    // send partial updates to the clients
-    // ALSO where the packets actually get sent
-    for (const auto& partial_update: shared_gamestate) {
-        sendUpdateToAllClients(Event(this->world_eid, EventType::LoadGameState, LoadGameStateEvent(partial_update)));
+    // Make sure that SharedGameState updates are sent while the server is in the
+    // Lobby phase (to ensure players can see other players lobby status updates)
+    if (has_updates ||
+        this->state.getPhase() == GamePhase::LOBBY ||
+        this->state.getPhase() == GamePhase::INTRO_CUTSCENE) {
+        // send the update to the clients
+        // ALSO where the packets actually get sent
+        sendSnapshotToAllClients(shared_gamestate);
     }
 
+    this->last_tick_broadcast_stats = this->curr_tick_broadcast_stats;
+    this->last_tick_input_stats = this->curr_tick_input_stats;
+    this->_collectTelemetry();
+
     // Calculate how long we need to wait until the next tick
     auto stop = std::chrono::high_resolution_clock::now();
     auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -462,15 +624,22 @@ void Server::_doAccept() {
                 auto addr = this->socket.remote_endpoint().address();
                 auto new_session = this->_handleNewSession(addr);
 
-                // send complete gamestate to the new person who connected
-                int i = 0;
-                for (auto& partial_update : this->state.generateSharedGameState(true)) {
-                    new_session->sendEvent(Event(0, EventType::LoadGameState, LoadGameStateEvent(partial_update)));
+                // send complete gamestate to the new person who connected, which means
+                // anything we thought they had acknowledged no longer applies
+                EntityID client_eid = new_session->getInfo().client_eid.value();
+                this->snapshot_trackers[client_eid].reset();
+                if (this->snapshot_channel != nullptr) {
+                    // wait for the new client to say hello before sending it datagrams
+                    this->snapshot_channel->removePeer(client_eid);
                 }
 
-                new_session->sendPacket(PackagedPacket::make_shared(PacketType::ServerAssignEID,
-                    ServerAssignEIDPacket { .eid = new_session->getInfo().client_eid.value(), 
-                                            .is_dungeon_master = new_session->getInfo().is_dungeon_master.value()}));
+                // the client only learns its EID once it has the state to go with it
+                this->_startResync(client_eid, new_session->getInfo().is_dungeon_master.value(), {
+                    PackagedPacket::make_shared(PacketType::ServerAssignEID,
+                        ServerAssignEIDPacket { .eid = client_eid,
+                                                .is_dungeon_master = new_session->getInfo().is_dungeon_master.value(),
+                                                .snapshot_port = this->_getSnapshotPort()})
+                });
             } else {
                 std::cerr << "Error accepting tcp connection: " << ec << std::endl;
 
@@ -483,6 +652,66 @@ void Server::_doAccept() {
         });
 }
 
+void Server::_startResync(EntityID client, bool is_dm, std::vector<std::shared_ptr<PackagedPacket>> then_send) {
+    InterestManager& interest = this->interest_managers[client];
+    interest.reset();
+    SharedGameState full_state = interest.filter(this->state.generateSharedGameState(true),
+        this->state.objects, client, is_dm, this->config.server.interest_radius);
+    full_state.resync_id = this->next_resync_id++;
+
+    // replaces whatever was left of a previous resync, which the client will throw away
+    auto chunks = splitSnapshot(this->world_eid, full_state, SNAPSHOT_DATAGRAM_BYTES);
+    this->resyncs.insert_or_assign(client, PendingResync {
+        .chunks = std::deque<SharedGameState>(std::make_move_iterator(chunks.begin()),
+            std::make_move_iterator(chunks.end())),
+        .then_send = std::move(then_send)
+    });
+}
+
+void Server::_sendResyncs() {
+    BroadcastStats& stats = this->curr_tick_broadcast_stats;
+
+    for (const auto& [eid, _is_dm, _ip, session] : this->sessions) { // cppcheck-suppress unusedVariable
+        auto resync = this->resyncs.find(eid);
+        if (resync == this->resyncs.end()) {
+            continue;
+        }
+
+        if (!session->isOkay()) {
+            // it starts over whenever the client reconnects
+            this->resyncs.erase(resync);
+            continue;
+        }
+
+        auto serialize_start = std::chrono::high_resolution_clock::now();
+
+        std::size_t bytes_sent = 0;
+        auto& chunks = resync->second.chunks;
+        while (!chunks.empty() && bytes_sent < RESYNC_BYTES_PER_TICK && !session->isBackedUp()) {
+            auto packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(Event(
+                this->world_eid, EventType::LoadGameState, LoadGameStateEvent(chunks.front()))));
+            chunks.pop_front();
+
+            session->sendPacket(packet);
+            bytes_sent += packet->size();
+            stats.packets_serialized++;
+            stats.packets_sent++;
+        }
+        stats.bytes_serialized += bytes_sent;
+        stats.bytes_sent += bytes_sent;
+
+        auto serialize_stop = std::chrono::high_resolution_clock::now();
+        stats.serialize_time += serialize_stop - serialize_start;
+
+        if (chunks.empty()) {
+            for (const auto& packet : resync->second.then_send) {
+                session->sendPacket(packet);
+            }
+            this->resyncs.erase(resync);
+        }
+    }
+}
+
 std::shared_ptr<Session> Server::_handleNewSession(boost::asio::ip::address addr) {
     auto& by_ip = this->sessions.get<IndexByIP>();
     auto old_session = by_ip.find(addr);
@@ -532,6 +761,77 @@ std::shared_ptr<Session> Server::_handleNewSession(boost::asio::ip::address addr
     return session;
 }
 
+void Server::_collectTelemetry() {
+    NetworkTelemetry tick_total;
+
+    // packets shared between sessions were serialized here, instead of by a session
+    tick_total.serialize_time += this->curr_tick_broadcast_stats.serialize_time;
+
+    for (const auto& [eid, _is_dm, _ip, session] : this->sessions) { // cppcheck-suppress unusedVariable
+        NetworkTelemetry telemetry = session->takeTelemetry();
+
+        auto datagrams = this->datagram_telemetry.find(eid);
+        if (datagrams != this->datagram_telemetry.end()) {
+            telemetry.merge(datagrams->second);
+        }
+
+        tick_total.merge(telemetry);
+        if (this->config.server.telemetry.interval_ticks > 0) {
+            this->interval_telemetry[eid].merge(telemetry);
+        }
+    }
+    this->datagram_telemetry.clear();
+
+    this->last_tick_telemetry = tick_total;
+
+    if (this->config.server.telemetry.interval_ticks <= 0) {
+        return;
+    }
+
+    this->interval_total_telemetry.merge(tick_total);
+    this->interval_ticks++;
+    if (this->interval_ticks >= this->config.server.telemetry.interval_ticks) {
+        this->_writeTelemetry();
+        this->interval_telemetry.clear();
+        this->interval_total_telemetry = NetworkTelemetry();
+        this->interval_ticks = 0;
+    }
+}
+
+void Server::_writeTelemetry() {
+    nlohmann::json sessions = nlohmann::json::object();
+    for (const auto& [eid, telemetry] : this->interval_telemetry) {
+        sessions[std::to_string(eid)] = telemetry.toJson();
+    }
+
+    nlohmann::json report = {
+        {"timestep", this->state.getTimestep()},
+        {"ticks", this->interval_ticks},
+        {"total", this->interval_total_telemetry.toJson()},
+        {"sessions", sessions}
+    };
+
+    const std::string& file = this->config.server.telemetry.file;
+    if (file.empty()) {
+        std::cout << report.dump() << std::endl;
+        return;
+    }
+
+    std::ofstream out(file, std::ios::app);
+    if (!out) {
+        std::cerr << "Could not open telemetry file " << file << std::endl;
+        return;
+    }
+    out << report.dump() << "\n";
+}
+
+uint16_t Server::_getSnapshotPort() const {
+    if (this->snapshot_channel == nullptr) {
+        return 0;
+    }
+    return this->snapshot_channel->getPort();
+}
+
 void Server::sendSoundCommands() {
     bool is_intro_cutscene = this->state.getPhase() == GamePhase::INTRO_CUTSCENE;    
 
@@ -539,11 +839,8 @@ void Server::sendSoundCommands() {
 
     // TODO: send sound effects to DM?
     std::vector<Object*> players; // hold players and DM
-    for (int i = 0; i < curr_state.objects.getPlayers().size(); i++) {
-        auto player = curr_state.objects.getPlayer(i);
-        if (player != nullptr) {
-            players.push_back(player);
-        }
+    for (Player* player : curr_state.objects.getPlayers()) {
+        players.push_back(player);
     }
     if (curr_state.objects.getDM() != nullptr) {
         players.push_back(curr_state.objects.getDM());
@@ -0,0 +1,137 @@
+#include "server/snapshottracker.hpp"
+
+#include <iostream>
+
+#include "shared/network/constants.hpp"
+
+SnapshotTracker::SnapshotTracker():
+    next_snapshot_id(1),
+    reliable(true)
+{
+}
+
+SharedGameState SnapshotTracker::encode(const SharedGameState& update) {
+    if (this->pending.size() >= MAX_UNACKED_SNAPSHOTS) {
+        // The client has stopped acknowledging, so the baseline is most likely
+        // stale. Start over from full objects instead of growing forever.
+        std::cerr << "Client has " << this->pending.size()
+            << " unacknowledged snapshots, resending full objects" << std::endl;
+        this->reset();
+    }
+
+    SharedGameState encoded = update;
+    encoded.objects.clear();
+    encoded.object_deltas.clear();
+    encoded.snapshot_id = this->next_snapshot_id++;
+
+    PendingSnapshot snapshot;
+    snapshot.id = encoded.snapshot_id;
+
+    for (const auto& [id, obj] : update.objects) {
+        this->_encodeObject(id, obj, encoded, snapshot);
+    }
+
+    if (!this->reliable) {
+        // Any of the unacknowledged snapshots might never arrive, so everything in
+        // them is repeated until the client acknowledges a snapshot that has it.
+        // Objects that aren't in the update haven't changed since the most recent
+        // snapshot they were in, so that is the state to repeat.
+        for (auto prev = this->pending.rbegin(); prev != this->pending.rend(); prev++) {
+            for (const auto& [id, obj] : prev->objects) {
+                if (!snapshot.objects.contains(id)) {
+                    this->_encodeObject(id, obj, encoded, snapshot);
+                }
+            }
+        }
+    }
+
+    this->pending.push_back(std::move(snapshot));
+
+    return encoded;
+}
+
+void SnapshotTracker::_encodeObject(EntityID id, const boost::optional<SharedObject>& obj,
+    SharedGameState& encoded, PendingSnapshot& snapshot) {
+    snapshot.objects.insert({id, obj});
+
+    // deleted objects are always sent
+    if (!obj.has_value()) {
+        encoded.objects.insert({id, boost::none});
+        snapshot.sent_fields.insert({id, ALL_SHARED_OBJECT_FIELDS});
+        return;
+    }
+
+    SharedObjectFieldMask unacked = this->_unacknowledgedFields(id);
+    auto base = this->baseline.find(id);
+
+    // If the client doesn't have an acknowledged copy, or the object was sent in
+    // full since then (so the client's copy might not be the baseline), we can't
+    // safely send a delta
+    if (base == this->baseline.end() || unacked == ALL_SHARED_OBJECT_FIELDS) {
+        encoded.objects.insert({id, obj});
+        snapshot.sent_fields.insert({id, ALL_SHARED_OBJECT_FIELDS});
+        return;
+    }
+
+    SharedObjectFieldMask fields = base->second.diff(obj.get()) | unacked;
+    if (fields == 0) {
+        // client already has exactly this object
+        return;
+    }
+
+    encoded.object_deltas.insert({id, SharedObjectDelta(obj.get(), fields)});
+    snapshot.sent_fields.insert({id, fields});
+}
+
+void SnapshotTracker::acknowledge(uint32_t snapshot_id) {
+    while (!this->pending.empty() && this->pending.front().id <= snapshot_id) {
+        for (const auto& [id, obj] : this->pending.front().objects) {
+            if (obj.has_value()) {
+                this->baseline.insert_or_assign(id, obj.get());
+            } else {
+                this->baseline.erase(id);
+            }
+        }
+
+        this->pending.pop_front();
+    }
+}
+
+void SnapshotTracker::defer(const SharedGameState& update) {
+    for (const auto& [id, _obj] : update.objects) { // cppcheck-suppress unusedVariable
+        this->deferred.insert(id);
+    }
+}
+
+std::unordered_set<EntityID> SnapshotTracker::takeDeferred() {
+    std::unordered_set<EntityID> ids;
+    std::swap(ids, this->deferred);
+    return ids;
+}
+
+void SnapshotTracker::reset() {
+    this->baseline.clear();
+    this->pending.clear();
+    this->deferred.clear();
+}
+
+void SnapshotTracker::setReliable(bool reliable) {
+    this->reliable = reliable;
+}
+
+std::size_t SnapshotTracker::numUnacknowledged() const {
+    return this->pending.size();
+}
+
+SharedObjectFieldMask SnapshotTracker::_unacknowledgedFields(EntityID id) const {
+    SharedObjectFieldMask fields = 0;
+
+    for (const auto& snapshot : this->pending) {
+        auto sent = snapshot.sent_fields.find(id);
+        if (sent != snapshot.sent_fields.end()) {
+            fields |= sent->second;
+        }
+    }
+
+    return fields;
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "server/inputcoalescer.hpp"
+
+static std::pair<EntityID, Event> facing(EntityID eid, float x) {
+    return {eid, Event(eid, EventType::ChangeFacing, ChangeFacingEvent(eid, glm::vec3(x, 0.0f, 0.0f)))};
+}
+
+static std::pair<EntityID, Event> action(EntityID eid, ActionType type, glm::vec3 movement) {
+    return {eid, Event(eid, EventType::StartAction, StartActionEvent(eid, movement, type))};
+}
+
+static std::pair<EntityID, Event> hover(EntityID eid, float x, bool place = false) {
+    return {eid, Event(eid, EventType::TrapPlacement,
+        TrapPlacementEvent(eid, glm::vec3(x, 0.0f, 0.0f), CellType::SpikeTrap, !place, place))};
+}
+
+static std::pair<EntityID, Event> useItem(EntityID eid) {
+    return {eid, Event(eid, EventType::UseItem, UseItemEvent(eid))};
+}
+
+static float facingX(const std::pair<EntityID, Event>& event) {
+    return std::get<ChangeFacingEvent>(event.second.data).facing.x;
+}
+
+TEST(InputCoalescerTest, KeepsLatestFacing) {
+    InputCoalescingStats stats;
+    EventList result = coalesceInputs({facing(1, 1), facing(1, 2), facing(1, 3)}, stats);
+
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(facingX(result[0]), 3);
+    EXPECT_EQ(stats.events_received, 3);
+    EXPECT_EQ(stats.events_collapsed, 2);
+}
+
+TEST(InputCoalescerTest, StatefulEventsKeepOrder) {
+    // using an item depends on which way we were facing at the time
+    InputCoalescingStats stats;
+    EventList result = coalesceInputs({facing(1, 1), facing(1, 2), useItem(1), facing(1, 3), facing(1, 4)}, stats);
+
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(facingX(result[0]), 2);
+    EXPECT_EQ(result[1].second.type, EventType::UseItem);
+    EXPECT_EQ(facingX(result[2]), 4);
+    EXPECT_EQ(stats.events_collapsed, 2);
+}
+
+TEST(InputCoalescerTest, ClientsAreCoalescedSeparately) {
+    InputCoalescingStats stats;
+    EventList result = coalesceInputs({facing(1, 1), facing(2, 10), useItem(2), facing(1, 2), facing(2, 20)}, stats);
+
+    // client 2 using an item doesn't stop client 1's facing from merging
+    ASSERT_EQ(result.size(), 4);
+    EXPECT_EQ(result[0].first, 2);
+    EXPECT_EQ(facingX(result[0]), 10);
+    EXPECT_EQ(result[1].second.type, EventType::UseItem);
+    EXPECT_EQ(result[2].first, 1);
+    EXPECT_EQ(facingX(result[2]), 2);
+    EXPECT_EQ(facingX(result[3]), 20);
+}
+
+TEST(InputCoalescerTest, MergesIdempotentActions) {
+    InputCoalescingStats stats;
+    EventList result = coalesceInputs({
+        action(1, ActionType::Jump, glm::vec3(0, 1, 0)),
+        action(1, ActionType::Zoom, glm::vec3(0, 1, 0)),
+        action(1, ActionType::Jump, glm::vec3(0, 1, 0)),
+        action(1, ActionType::Zoom, glm::vec3(0, 1, 0)),
+        action(1, ActionType::Zoom, glm::vec3(0, -1, 0)),
+        action(1, ActionType::Zoom, glm::vec3(0, 1, 0)),
+    }, stats);
+
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(std::get<StartActionEvent>(result[0].second.data).action, ActionType::Jump);
+    EXPECT_EQ(std::get<StartActionEvent>(result[1].second.data).action, ActionType::Zoom);
+    EXPECT_EQ(std::get<StartActionEvent>(result[1].second.data).movement.y, 2);
+    EXPECT_EQ(stats.events_collapsed, 4);
+}
+
+TEST(InputCoalescerTest, KeepsLatestHoverButEveryPlacement) {
+    InputCoalescingStats stats;
+    EventList result = coalesceInputs({hover(1, 1), hover(1, 2), hover(1, 3, true), hover(1, 4), hover(1, 5)}, stats);
+
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(std::get<TrapPlacementEvent>(result[0].second.data).world_pos.x, 2);
+    EXPECT_TRUE(std::get<TrapPlacementEvent>(result[1].second.data).place);
+    EXPECT_EQ(std::get<TrapPlacementEvent>(result[2].second.data).world_pos.x, 5);
+}
+
+TEST(InputCoalescerTest, OtherEntitiesAreNotCoalesced) {
+    // only merge input a client sends about itself
+    InputCoalescingStats stats;
+    EventList events = {
+        {1, Event(1, EventType::ChangeFacing, ChangeFacingEvent(5, glm::vec3(1.0f)))},
+        {1, Event(1, EventType::ChangeFacing, ChangeFacingEvent(5, glm::vec3(2.0f)))},
+    };
+    EXPECT_EQ(coalesceInputs(events, stats).size(), 2);
+    EXPECT_EQ(stats.events_collapsed, 0);
+}
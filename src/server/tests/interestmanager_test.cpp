@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <unordered_set>
+
+#include "server/interestmanager.hpp"
+#include "server/game/servergamestate.hpp"
+#include "server/game/grid.hpp"
+#include "shared/utilities/config.hpp"
+
+#include "testconfig.hpp"
+
+static const int RADIUS = 3;
+
+/**
+ * Loads one of the bigger demo mazes with a single player in it, so that most of the
+ * maze is out of range of the player
+ */
+class InterestManagerTest : public ::testing::Test {
+protected:
+    InterestManagerTest():
+        state(GamePhase::GAME, demoMazeConfig())
+    {
+        player = new Player(state.getGrid().getRandomSpawnPoint(), glm::vec3(0.0f));
+        state.objects.createObject(player);
+    }
+
+    /**
+     * @returns Ids of every object that should be relevant to the player, found the slow way
+     */
+    std::unordered_set<EntityID> expectedRelevant() {
+        glm::ivec2 center = Grid::getGridCellFromPosition(player->physics.shared.getCenterPosition());
+
+        std::unordered_set<EntityID> ids;
+        auto objects = state.objects.getObjects();
+        for (int i = 0; i < objects.size(); i++) {
+            Object* object = objects.get(i);
+            if (object == nullptr) {
+                continue;
+            }
+            if (InterestManager::isAlwaysRelevant(object)) {
+                ids.insert(object->globalID);
+                continue;
+            }
+            for (const auto& cell : object->gridCellPositions) {
+                if (std::abs(cell.x - center.x) <= RADIUS && std::abs(cell.y - center.y) <= RADIUS) {
+                    ids.insert(object->globalID);
+                    break;
+                }
+            }
+        }
+        return ids;
+    }
+
+    /**
+     * @returns Ids of every object the client has
+     */
+    static std::unordered_set<EntityID> clientIds(const SharedGameState& client) {
+        std::unordered_set<EntityID> ids;
+        for (const auto& [id, obj] : client.objects) {
+            if (obj.has_value()) {
+                ids.insert(id);
+            }
+        }
+        return ids;
+    }
+
+    ServerGameState state;
+    Player* player;
+    InterestManager interest;
+};
+
+TEST_F(InterestManagerTest, FullStateOnlyContainsNearbyObjects) {
+    SharedGameState full = state.generateSharedGameState(true);
+    SharedGameState filtered = interest.filter(full, state.objects, player->globalID, false, RADIUS);
+
+    EXPECT_LT(filtered.objects.size(), full.objects.size());
+    EXPECT_EQ(clientIds(filtered), expectedRelevant());
+    EXPECT_EQ(interest.numKnown(), filtered.objects.size());
+    EXPECT_TRUE(filtered.objects.contains(player->globalID));
+}
+
+TEST_F(InterestManagerTest, MovingSpawnsAndDespawns) {
+    SharedGameState client;
+    client.update(interest.filter(state.generateSharedGameState(true), state.objects,
+        player->globalID, false, RADIUS));
+    auto before = clientIds(client);
+
+    // move to the opposite corner of the maze from where we are
+    glm::vec3 pos = player->physics.shared.corner;
+    glm::vec3 far_pos(
+        Grid::grid_cell_width * state.getGrid().getColumns() - pos.x,
+        pos.y,
+        Grid::grid_cell_width * state.getGrid().getRows() - pos.z);
+    state.objects.moveObject(player, far_pos);
+    state.markAsUpdated(player->globalID);
+
+    SharedGameState update = interest.filter(state.generateSharedGameState(false), state.objects,
+        player->globalID, false, RADIUS);
+    client.update(update);
+
+    auto after = clientIds(client);
+    EXPECT_EQ(after, expectedRelevant());
+    EXPECT_NE(after, before);
+
+    // everything the client used to have that is no longer relevant was despawned
+    for (EntityID id : before) {
+        if (!after.contains(id)) {
+            ASSERT_TRUE(update.objects.contains(id));
+            EXPECT_FALSE(update.objects.at(id).has_value());
+        }
+    }
+
+    // and standing still doesn't send anything new
+    SharedGameState still = interest.filter(SharedGameState(), state.objects,
+        player->globalID, false, RADIUS);
+    EXPECT_TRUE(still.objects.empty());
+}
+
+TEST_F(InterestManagerTest, OnlyKnownDeletionsAreSent) {
+    interest.filter(state.generateSharedGameState(true), state.objects, player->globalID, false, RADIUS);
+    auto relevant = expectedRelevant();
+
+    // one object in range and one out of range
+    EntityID near_id = 0, far_id = 0;
+    bool found_near = false, found_far = false;
+    auto objects = state.objects.getObjects();
+    for (int i = 0; i < objects.size(); i++) {
+        Object* object = objects.get(i);
+        if (object == nullptr || InterestManager::isAlwaysRelevant(object)) {
+            continue;
+        }
+        if (relevant.contains(object->globalID) && !found_near) {
+            near_id = object->globalID;
+            found_near = true;
+        } else if (!relevant.contains(object->globalID) && !found_far) {
+            far_id = object->globalID;
+            found_far = true;
+        }
+    }
+    ASSERT_TRUE(found_near);
+    ASSERT_TRUE(found_far);
+
+    SharedGameState update;
+    update.objects.insert({near_id, boost::none});
+    update.objects.insert({far_id, boost::none});
+
+    SharedGameState filtered = interest.filter(update, state.objects, player->globalID, false, RADIUS);
+    ASSERT_EQ(filtered.objects.size(), 1);
+    EXPECT_FALSE(filtered.objects.at(near_id).has_value());
+}
+
+TEST_F(InterestManagerTest, FullMapSeesEverything) {
+    SharedGameState full = state.generateSharedGameState(true);
+
+    // start off as a player, then get switched over to the whole map
+    SharedGameState client;
+    client.update(interest.filter(full, state.objects, player->globalID, false, RADIUS));
+    client.update(interest.filter(SharedGameState(), state.objects, player->globalID, true, RADIUS));
+
+    EXPECT_TRUE(interest.isFullMap());
+    EXPECT_EQ(client.objects.size(), full.objects.size());
+
+    // from then on updates go through untouched
+    SharedGameState update = state.generateSharedGameState(true);
+    EXPECT_EQ(interest.filter(update, state.objects, player->globalID, true, RADIUS).objects.size(),
+        update.objects.size());
+}
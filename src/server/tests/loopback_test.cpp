@@ -0,0 +1,350 @@
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "server/server.hpp"
+#include "shared/game/constants.hpp"
+#include "shared/netsim/netharness.hpp"
+#include "shared/utilities/config.hpp"
+#include "shared/utilities/root_path.hpp"
+
+using namespace std::chrono_literals;
+
+using Clock = DelayLine::Clock;
+
+/**
+ * Runs a real Server with ScriptedClients connected to it over simulated links, and
+ * measures what it would be like to play on that network
+ */
+class LoopbackServerTest : public ::testing::TestWithParam<bool> {
+protected:
+    static GameConfig makeConfig(int num_players, bool udp_snapshots,
+        const std::string& maze_file = "demo/game1_player_pov.maze") {
+        GameConfig config {};
+        config.port = 0;
+        config.server.lobby_name = "loopback";
+        config.server.lobby_broadcast = false;
+        config.server.max_players = num_players;
+        config.server.disable_dm = true;
+        config.server.skip_intro = true;
+        config.server.disable_enemies = true;
+        config.server.maze.directory = "maps";
+        config.server.maze.procedural = false;
+        config.server.maze.maze_file = maze_file;
+        config.server.max_packet_bytes = 1400;
+        config.server.interest_radius = 20;
+        config.server.udp_snapshots = udp_snapshots;
+        return config;
+    }
+
+    /**
+     * @returns Path of the largest .maze file in maps/demo, relative to maps
+     */
+    static std::string largestDemoMaze() {
+        boost::filesystem::path largest;
+        for (const auto& entry : boost::filesystem::directory_iterator(getRepoRoot() / "maps" / "demo")) {
+            if (entry.path().extension() == ".maze" &&
+                (largest.empty() || boost::filesystem::file_size(entry.path()) > boost::filesystem::file_size(largest))) {
+                largest = entry.path();
+            }
+        }
+        return "demo/" + largest.filename().string();
+    }
+
+    /**
+     * Gets every client into the lobby, readies them up and starts the game
+     *
+     * @returns Whether every client ended up in the game
+     */
+    bool startGame(Server& server, const std::vector<std::shared_ptr<ScriptedClient>>& clients) {
+        auto all_clients = [&](auto pred) {
+            return std::all_of(clients.begin(), clients.end(), pred);
+        };
+
+        // join the lobby
+        for (int i = 0; i < 100 && !all_clients([](const auto& c) { return c->getEID().has_value(); }); i++) {
+            this->tick(server);
+        }
+        if (!all_clients([](const auto& c) { return c->getEID().has_value(); })) {
+            return false;
+        }
+
+        // get everyone ready, wait for the server to see that, and then start the game
+        for (auto& client : clients) {
+            EntityID eid = client->getEID().value();
+            client->addInput(Event(eid, EventType::LobbyAction,
+                LobbyActionEvent(LobbyActionEvent::Action::Ready, PlayerRole::Player)));
+        }
+        for (int i = 0; i < 10; i++) {
+            this->tick(server);
+        }
+        EntityID host = clients[0]->getEID().value();
+        clients[0]->addInput(Event(host, EventType::LobbyAction,
+            LobbyActionEvent(LobbyActionEvent::Action::StartGame, PlayerRole::Player)));
+
+        for (int i = 0; i < 100 && !all_clients([](const auto& c) { return c->getState().phase == GamePhase::GAME; }); i++) {
+            this->tick(server);
+        }
+        return all_clients([](const auto& c) { return c->getState().phase == GamePhase::GAME; });
+    }
+
+    /**
+     * Runs one server tick, and then the network until the next tick is due
+     */
+    void tick(Server& server) {
+        auto start = Clock::now();
+        auto wait = server.doTick();
+        auto tick_time = Clock::now() - start;
+
+        this->tick_starts[server.getTimestep()] = start;
+        this->tick_times.push_back(tick_time);
+        this->telemetry.merge(server.getLastTickTelemetry());
+
+        this->harness.pollFor(std::max(std::chrono::duration_cast<std::chrono::microseconds>(wait),
+            std::chrono::microseconds(1000)));
+    }
+
+    NetHarness harness;
+
+    /// @brief When the tick that sent each timestep's snapshot started
+    std::unordered_map<unsigned int, Clock::time_point> tick_starts;
+
+    std::vector<Clock::duration> tick_times;
+
+    /// @brief What the server has sent and received
+    NetworkTelemetry telemetry;
+};
+
+TEST_P(LoopbackServerTest, PlayersOnBadNetwork) {
+    const int NUM_CLIENTS = 2;
+    const int NUM_GAME_TICKS = 60;
+    bool udp_snapshots = GetParam();
+
+    LinkConditions network;
+    network.latency = 20ms;
+    network.jitter = 5ms;
+    network.loss = 0.02;
+    network.retransmit_timeout = 60ms;
+
+    Server server(this->harness.getContext(), makeConfig(NUM_CLIENTS, udp_snapshots));
+
+    std::vector<std::shared_ptr<ScriptedClient>> clients;
+    for (int i = 0; i < NUM_CLIENTS; i++) {
+        network.seed = i + 1;
+        clients.push_back(this->harness.addClient(server.getPort(), network, network));
+    }
+
+    ASSERT_TRUE(this->startGame(server, clients));
+
+    // everyone runs around in circles
+    std::vector<std::size_t> arrivals_before;
+    std::size_t bytes_before = 0;
+    for (auto& client : clients) {
+        arrivals_before.push_back(client->getArrivals().size());
+        bytes_before += client->getBytesReceived();
+    }
+    std::size_t ticks_before = this->tick_times.size();
+    // only measure snapshots from the ticks that follow
+    this->tick_starts.clear();
+    this->telemetry = NetworkTelemetry();
+
+    for (int t = 0; t < NUM_GAME_TICKS; t++) {
+        for (auto& client : clients) {
+            EntityID eid = client->getEID().value();
+            float angle = t * 0.2f;
+            client->addInput(Event(eid, EventType::StartAction,
+                StartActionEvent(eid, glm::vec3(std::cos(angle), 0.0f, std::sin(angle)), ActionType::MoveCam)));
+        }
+        this->tick(server);
+    }
+
+    // let everything in flight arrive
+    this->harness.pollFor(200ms);
+
+    std::vector<Clock::duration> latencies;
+    std::size_t bytes_received = 0;
+    for (std::size_t i = 0; i < clients.size(); i++) {
+        const auto& arrivals = clients[i]->getArrivals();
+        for (std::size_t a = arrivals_before[i]; a < arrivals.size(); a++) {
+            auto start = this->tick_starts.find(arrivals[a].timestep);
+            if (start != this->tick_starts.end()) {
+                latencies.push_back(arrivals[a].time - start->second);
+            }
+        }
+        bytes_received += clients[i]->getBytesReceived();
+    }
+    bytes_received -= bytes_before;
+
+    ASSERT_FALSE(latencies.empty());
+    std::sort(latencies.begin(), latencies.end());
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    std::vector<Clock::duration> game_tick_times(this->tick_times.begin() + ticks_before, this->tick_times.end());
+    std::sort(game_tick_times.begin(), game_tick_times.end());
+
+    std::cout << (udp_snapshots ? "UDP" : "TCP") << " snapshots, " << NUM_CLIENTS << " players, "
+        << NUM_GAME_TICKS << " ticks:\n"
+        << "  snapshot latency: median " << ms(latencies[latencies.size() / 2])
+        << " ms, p95 " << ms(latencies[latencies.size() * 95 / 100]) << " ms\n"
+        << "  bytes per tick per client: " << bytes_received / NUM_GAME_TICKS / NUM_CLIENTS << "\n"
+        << "  tick time: median " << ms(game_tick_times[game_tick_times.size() / 2])
+        << " ms, max " << ms(game_tick_times.back()) << " ms\n"
+        << "  bytes sent by event type:\n";
+
+    std::vector<std::pair<EventType, TrafficCounter>> by_event(
+        this->telemetry.sent_by_event.begin(), this->telemetry.sent_by_event.end());
+    std::sort(by_event.begin(), by_event.end(), [](const auto& a, const auto& b) {
+        return a.second.bytes > b.second.bytes;
+    });
+    for (const auto& [type, counter] : by_event) {
+        std::cout << "    " << type << ": " << counter.bytes << " bytes in " << counter.count << " packets\n";
+    }
+
+    // everything the clients got over TCP, the server sent (datagrams have headers of
+    // their own, which the server doesn't count)
+    if (!udp_snapshots) {
+        EXPECT_EQ(this->telemetry.totalBytesSent(), bytes_received);
+    }
+
+    // nothing can arrive faster than the link allows
+    EXPECT_GE(latencies.front(), network.latency - network.jitter);
+    for (auto& client : clients) {
+        EXPECT_TRUE(client->getSession()->isOkay());
+    }
+}
+
+TEST_P(LoopbackServerTest, ReconnectOnLargestMaze) {
+    const int NUM_CLIENTS = 2;
+    bool udp_snapshots = GetParam();
+
+    LinkConditions network;
+    network.latency = 20ms;
+    network.jitter = 5ms;
+    network.loss = 0.02;
+    network.retransmit_timeout = 60ms;
+
+    // everyone sees the whole maze, which is as big as a resync gets
+    GameConfig config = makeConfig(NUM_CLIENTS, udp_snapshots, largestDemoMaze());
+    config.server.interest_radius = 0;
+    Server server(this->harness.getContext(), config);
+
+    std::vector<std::shared_ptr<ScriptedClient>> clients;
+    for (int i = 0; i < NUM_CLIENTS; i++) {
+        network.seed = i + 1;
+        clients.push_back(this->harness.addClient(server.getPort(), network, network));
+    }
+    ASSERT_TRUE(this->startGame(server, clients));
+
+    auto& dropped = clients[1];
+    auto& other = clients[0];
+    EntityID eid = dropped->getEID().value();
+
+    // drop the connection, and give the server a moment to notice
+    dropped->getLink()->close();
+    for (int i = 0; i < 5; i++) {
+        this->tick(server);
+    }
+
+    auto reconnect_start = Clock::now();
+    dropped->reconnect();
+
+    std::size_t other_arrivals_before = other->getArrivals().size();
+    std::size_t ticks_before = this->tick_times.size();
+    auto is_playable = [&]() {
+        auto resync_time = dropped->getLastResyncTime();
+        return dropped->getEID() == eid && resync_time.has_value() && resync_time.value() > reconnect_start;
+    };
+    for (int i = 0; i < 200 && !is_playable(); i++) {
+        this->tick(server);
+    }
+    ASSERT_TRUE(is_playable());
+    std::size_t resync_ticks = this->tick_times.size() - ticks_before;
+
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    std::vector<Clock::duration> resync_tick_times(this->tick_times.begin() + ticks_before, this->tick_times.end());
+    std::sort(resync_tick_times.begin(), resync_tick_times.end());
+
+    std::cout << (udp_snapshots ? "UDP" : "TCP") << " snapshots, reconnecting on " << largestDemoMaze() << ":\n"
+        << "  time to playable: " << ms(dropped->getLastResyncTime().value() - reconnect_start)
+        << " ms over " << resync_ticks << " ticks\n"
+        << "  full state: " << dropped->getState().objects.size() << " objects in "
+        << dropped->getBytesReceived() << " bytes\n"
+        << "  tick time while resyncing: median " << ms(resync_tick_times[resync_tick_times.size() / 2])
+        << " ms, max " << ms(resync_tick_times.back()) << " ms\n";
+
+    // sees the same as everyone else again, without any leftovers from deleted objects
+    const SharedGameState& state = dropped->getState();
+    EXPECT_EQ(state.phase, GamePhase::GAME);
+    EXPECT_TRUE(state.objects.contains(eid));
+    EXPECT_EQ(state.objects.size(), other->getState().objects.size());
+    for (const auto& [id, obj] : state.objects) {
+        EXPECT_TRUE(obj.has_value()) << id;
+    }
+    EXPECT_FALSE(server.isResyncing(eid));
+
+    // the other player kept getting snapshots the whole time
+    EXPECT_GT(other->getArrivals().size(), other_arrivals_before);
+
+    // and snapshots pick up where the resync left off
+    std::size_t arrivals_before = dropped->getArrivals().size();
+    for (int i = 0; i < 20; i++) {
+        dropped->addInput(Event(eid, EventType::StartAction,
+            StartActionEvent(eid, glm::vec3(1.0f, 0.0f, 0.0f), ActionType::MoveCam)));
+        this->tick(server);
+    }
+    EXPECT_GT(dropped->getArrivals().size(), arrivals_before);
+    EXPECT_TRUE(dropped->getSession()->isOkay());
+}
+
+TEST_P(LoopbackServerTest, DISABLED_TickTimeOnLargestMaze) {
+    const int NUM_CLIENTS = 4;
+    const int NUM_GAME_TICKS = 100;
+    bool udp_snapshots = GetParam();
+
+    Server server(this->harness.getContext(), makeConfig(NUM_CLIENTS, udp_snapshots, largestDemoMaze()));
+
+    std::vector<std::shared_ptr<ScriptedClient>> clients;
+    for (int i = 0; i < NUM_CLIENTS; i++) {
+        clients.push_back(this->harness.addClient(server.getPort(), LinkConditions(), LinkConditions()));
+    }
+    ASSERT_TRUE(this->startGame(server, clients));
+
+    std::size_t ticks_before = this->tick_times.size();
+    for (int t = 0; t < NUM_GAME_TICKS; t++) {
+        for (auto& client : clients) {
+            EntityID eid = client->getEID().value();
+            float angle = t * 0.2f;
+            client->addInput(Event(eid, EventType::StartAction,
+                StartActionEvent(eid, glm::vec3(std::cos(angle), 0.0f, std::sin(angle)), ActionType::MoveCam)));
+        }
+        this->tick(server);
+    }
+
+    std::vector<Clock::duration> game_tick_times(this->tick_times.begin() + ticks_before, this->tick_times.end());
+    std::sort(game_tick_times.begin(), game_tick_times.end());
+    Clock::duration total {0};
+    for (auto tick_time : game_tick_times) {
+        total += tick_time;
+    }
+
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    std::cout << (udp_snapshots ? "UDP" : "TCP") << " snapshots, " << NUM_CLIENTS << " players on "
+        << largestDemoMaze() << ", " << NUM_GAME_TICKS << " ticks:\n"
+        << "  tick time: mean " << ms(total) / NUM_GAME_TICKS
+        << " ms, median " << ms(game_tick_times[game_tick_times.size() / 2])
+        << " ms, max " << ms(game_tick_times.back()) << " ms\n";
+
+    for (auto& client : clients) {
+        EXPECT_TRUE(client->getSession()->isOkay());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(SnapshotTransports, LoopbackServerTest, ::testing::Values(false, true));
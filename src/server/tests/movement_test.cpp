@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include "server/game/physicsstore.hpp"
+#include "server/game/servergamestate.hpp"
+#include "server/game/slime.hpp"
+#include "shared/utilities/config.hpp"
+
+#include "testconfig.hpp"
+
+/**
+ * Counts heap allocations made while counting_allocations is set. Replacing the
+ * global operator new applies to the whole test binary, but it only counts while a
+ * test asks it to.
+ */
+static std::atomic<bool> counting_allocations {false};
+static std::atomic<std::size_t> num_allocations {0};
+
+void* operator new(std::size_t size) {
+    if (counting_allocations) {
+        num_allocations++;
+    }
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+TEST(PhysicsStoreTest, IntegratesEachSlot) {
+    Physics physics(true, Collider::Box, glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    physics.velocity() = glm::vec3(1.0f, 2.0f, 3.0f);
+    physics.velocityMultiplier() = glm::vec3(2.0f, 1.0f, 0.5f);
+    physics.currTickVelocity() = glm::vec3(0.5f, 0.0f, -1.0f);
+    physics.nauseous() = -1.0f;
+
+    PhysicsStore store;
+    physics.attach(store, 2);
+    store.integrate();
+
+    // nausea only flips the horizontal movement, and empty slots don't move
+    EXPECT_EQ(store.size(), 3);
+    EXPECT_EQ(store.getStep(0), glm::vec3(0.0f));
+    EXPECT_EQ(store.getStep(2), glm::vec3(-2.5f, 2.0f, -0.5f));
+    EXPECT_EQ(store.getStep(3), glm::vec3(0.0f));
+}
+
+TEST(PhysicsStoreTest, AttachedPhysicsUsesItsSlot) {
+    Physics physics(true, Collider::Box, glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    physics.velocity() = glm::vec3(1.0f, 0.0f, 0.0f);
+
+    PhysicsStore store;
+    physics.attach(store, 0);
+    EXPECT_EQ(store.velocity(0), glm::vec3(1.0f, 0.0f, 0.0f));
+
+    // writes go to the store, and a copy doesn't share the slot
+    physics.velocity().y = 2.0f;
+    Physics copy = physics;
+    copy.velocity().y = 5.0f;
+    EXPECT_EQ(store.velocity(0), glm::vec3(1.0f, 2.0f, 0.0f));
+
+    // detaching takes the latest values along
+    store.velocity(0).z = 3.0f;
+    physics.detach();
+    store.velocity(0) = glm::vec3(0.0f);
+    EXPECT_EQ(physics.velocity(), glm::vec3(1.0f, 2.0f, 3.0f));
+}
+
+/**
+ * Fills one of the bigger demo mazes with enemies, so that the movement phase of a tick
+ * has plenty to do
+ */
+class MovementTest : public ::testing::Test {
+protected:
+    MovementTest():
+        state(GamePhase::GAME, demoMazeConfig())
+    {}
+
+    /**
+     * Adds enemies at random spawn points
+     */
+    std::vector<Slime*> spawnSlimes(int count) {
+        std::vector<Slime*> slimes;
+        for (int i = 0; i < count; i++) {
+            auto slime = new Slime(this->state.getGrid().getRandomSpawnPoint(), glm::vec3(1, 0, 1), 1 + i % 3);
+            this->state.objects.createObject(slime);
+            slimes.push_back(slime);
+        }
+        return slimes;
+    }
+
+    ServerGameState state;
+};
+
+/**
+ * Once every object has been through the cells it is moving around in, moving
+ * everything (collisions included) shouldn't need any more memory
+ */
+TEST_F(MovementTest, MovementPhaseDoesNotAllocate) {
+    const int NUM_SLIMES = 256;
+    const int NUM_WARMUP_TICKS = 10;
+    const int NUM_TICKS = 40;
+
+    auto slimes = this->spawnSlimes(NUM_SLIMES);
+
+    // every slime goes back and forth along its own direction, so it keeps going
+    // through the same cells
+    auto setVelocities = [&](int t) {
+        float sign = (t / 5) % 2 == 0 ? 1.0f : -1.0f;
+        for (std::size_t i = 0; i < slimes.size(); i++) {
+            float angle = static_cast<float>(i);
+            slimes[i]->physics.velocity() = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * 0.2f * sign;
+        }
+    };
+
+    for (int t = 0; t < NUM_WARMUP_TICKS; t++) {
+        setVelocities(t);
+        this->state.updateMovement();
+    }
+
+    num_allocations = 0;
+    for (int t = NUM_WARMUP_TICKS; t < NUM_WARMUP_TICKS + NUM_TICKS; t++) {
+        setVelocities(t);
+        counting_allocations = true;
+        this->state.updateMovement();
+        counting_allocations = false;
+    }
+
+    EXPECT_EQ(num_allocations, 0) << "heap allocations in " << NUM_TICKS << " ticks of movement";
+}
+
+TEST_F(MovementTest, ObjectManagerKeepsVelocitiesInItsStore) {
+    auto slimes = this->spawnSlimes(2);
+    PhysicsStore& store = this->state.objects.physicsStore;
+
+    slimes[1]->physics.velocity() = glm::vec3(0.1f, 0.0f, 0.0f);
+    EXPECT_EQ(store.velocity(slimes[1]->movableID), glm::vec3(0.1f, 0.0f, 0.0f));
+
+    // a new object that takes over a removed object's slot starts with its own values
+    MovableID freed = slimes[1]->movableID;
+    this->state.objects.removeObject(slimes[1]->globalID);
+    auto replacement = this->spawnSlimes(1)[0];
+    ASSERT_EQ(replacement->movableID, freed);
+    EXPECT_EQ(store.velocity(freed), glm::vec3(0.0f));
+}
+
+/**
+ * Not a correctness test: reports how long updateMovement takes with more and more
+ * movable objects running around
+ */
+TEST_F(MovementTest, DISABLED_MovementPhaseCost) {
+    const int SLIME_COUNTS[] = {256, 512, 1024};
+    const int NUM_TICKS = 50;
+
+    std::vector<Slime*> slimes;
+    for (int num_slimes : SLIME_COUNTS) {
+        auto more = this->spawnSlimes(num_slimes - static_cast<int>(slimes.size()));
+        slimes.insert(slimes.end(), more.begin(), more.end());
+
+        std::chrono::steady_clock::duration total {0};
+        for (int t = 0; t < NUM_TICKS; t++) {
+            for (std::size_t i = 0; i < slimes.size(); i++) {
+                float angle = t * 0.1f + i;
+                slimes[i]->physics.velocity() = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * 0.2f;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            this->state.updateMovement();
+            total += std::chrono::steady_clock::now() - start;
+        }
+
+        std::cout << "updateMovement with " << this->state.objects.getMovableObjects().numElements()
+            << " movable objects: " << std::chrono::duration<double, std::milli>(total).count() / NUM_TICKS
+            << " ms per tick\n";
+    }
+
+    PhysicsStore& store = this->state.objects.physicsStore;
+    const int NUM_INTEGRATIONS = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_INTEGRATIONS; i++) {
+        store.integrate();
+    }
+    auto integrate_time = (std::chrono::steady_clock::now() - start) / NUM_INTEGRATIONS;
+    std::cout << "  of which working out every step: "
+        << std::chrono::duration<double, std::micro>(integrate_time).count() << " us\n";
+
+    // everyone stays in the maze
+    for (Slime* slime : slimes) {
+        EXPECT_GE(slime->physics.shared.corner.y, 0.0f);
+    }
+}
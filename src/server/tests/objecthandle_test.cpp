@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+#include <utility>
+
+#include "server/game/item.hpp"
+#include "server/game/objectmanager.hpp"
+#include "shared/utilities/custom_hash.hpp"
+
+static Item* makeItem() {
+    return new Item(ObjectType::Item, true, glm::vec3(1, 0, 1), ModelType::Cube, glm::vec3(1));
+}
+
+TEST(ObjectHandleTest, UnsetHandleResolvesToNothing) {
+    ObjectManager objects;
+    ObjectHandle<Item> handle;
+
+    EXPECT_FALSE(handle.isSet());
+    EXPECT_EQ(objects.resolve(handle), nullptr);
+    EXPECT_FALSE(objects.handleOf<Item>(nullptr).isSet());
+    // not stale, just unset
+    EXPECT_EQ(objects.getStaleResolutions(), 0);
+}
+
+TEST(ObjectHandleTest, GoesStaleWhenEntityIDIsReused) {
+    ObjectManager objects;
+    Item* item = makeItem();
+    objects.createObject(item);
+    EntityID id = item->globalID;
+
+    ObjectHandle<Item> handle = objects.handleOf(item);
+    EXPECT_TRUE(handle.isSet());
+    EXPECT_EQ(handle.index(), id);
+    EXPECT_EQ(objects.resolve(handle), item);
+
+    objects.removeObject(id);
+    EXPECT_EQ(objects.resolve(handle), nullptr);
+
+    // the new object gets the same EntityID, and the same memory from the
+    // ObjectPool, but the old handle still doesn't resolve to it
+    Item* replacement = makeItem();
+    objects.createObject(replacement);
+    EXPECT_EQ(replacement->globalID, id);
+    EXPECT_EQ(replacement, item);
+    EXPECT_EQ(objects.resolve(handle), nullptr);
+
+    ObjectHandle<Item> fresh = objects.handleOf(replacement);
+    EXPECT_NE(fresh, handle);
+    EXPECT_EQ(objects.resolve(fresh), replacement);
+
+#ifndef NDEBUG
+    EXPECT_EQ(objects.getStaleResolutions(), 2);
+#else
+    EXPECT_EQ(objects.getStaleResolutions(), 0);
+#endif
+}
+
+TEST(ObjectHandleTest, HashesInPairs) {
+    ObjectManager objects;
+    Item* first = makeItem();
+    Item* second = makeItem();
+    objects.createObject(first);
+    objects.createObject(second);
+
+    std::unordered_set<std::pair<ObjectHandle<Object>, ObjectHandle<Object>>, pair_hash> pairs;
+    pairs.insert({ objects.handleOf<Object>(first), objects.handleOf<Object>(second) });
+    pairs.insert({ objects.handleOf<Object>(first), objects.handleOf<Object>(second) });
+    pairs.insert({ objects.handleOf<Object>(second), objects.handleOf<Object>(first) });
+
+    EXPECT_EQ(pairs.size(), 2);
+}
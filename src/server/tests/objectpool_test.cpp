@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include "server/game/item.hpp"
+#include "server/game/potion.hpp"
+#include "server/game/servergamestate.hpp"
+#include "shared/utilities/config.hpp"
+
+#include "testconfig.hpp"
+
+static ObjectPoolStats statsFor(const std::string& name) {
+    return getObjectPoolStats()[name];
+}
+
+static Item* makeItem() {
+    return new Item(ObjectType::Item, true, glm::vec3(-1, 0, -1), ModelType::Cube, glm::vec3(1));
+}
+
+TEST(ObjectPoolTest, ReusesDeletedObjects) {
+    Item* item = makeItem();
+    ObjectPoolStats before = statsFor("Item");
+
+    Object* object = item;
+    delete object;
+    Item* again = makeItem();
+
+    // the most recently deleted slot is handed out first
+    EXPECT_EQ(again, item);
+    ObjectPoolStats after = statsFor("Item");
+    EXPECT_EQ(after.allocations, before.allocations + 1);
+    EXPECT_EQ(after.deallocations, before.deallocations + 1);
+    EXPECT_EQ(after.live, before.live);
+    EXPECT_EQ(after.capacity, before.capacity);
+
+    delete again;
+}
+
+TEST(ObjectPoolTest, SubclassesUseTheirOwnPool) {
+    ObjectPoolStats items_before = statsFor("Item");
+    Item* potion = new Potion(glm::vec3(0.0f), glm::vec3(1.0f), PotionType::Health);
+
+    EXPECT_EQ(statsFor("Item").allocations, items_before.allocations);
+    EXPECT_EQ(statsFor("Potion").live, 1);
+
+    delete potion;
+    EXPECT_EQ(statsFor("Potion").live, 0);
+}
+
+TEST(ObjectPoolTest, NextGameReusesPools) {
+    {
+        ServerGameState state(GamePhase::GAME, demoMazeConfig());
+        EXPECT_GT(statsFor("SolidSurface").live, 0);
+    }
+    auto after_first = getObjectPoolStats();
+    EXPECT_EQ(after_first["SolidSurface"].live, 0);
+
+    {
+        ServerGameState state(GamePhase::GAME, demoMazeConfig());
+    }
+
+    // loading the same maze again doesn't need any more memory
+    for (const auto& [name, stats] : getObjectPoolStats()) {
+        EXPECT_EQ(stats.slabs, after_first[name].slabs) << name;
+        EXPECT_EQ(stats.live, after_first[name].live) << name;
+    }
+}
+
+/**
+ * Not a correctness test: reports how long it takes to create and delete objects, like
+ * projectiles and attacks coming and going in a fight
+ */
+TEST(ObjectPoolTest, DISABLED_ChurnCost) {
+    const int NUM_OBJECTS = 1000;
+    const int ITERATIONS = 200;
+
+    // straight from the heap, for comparison
+    std::vector<void*> memory(NUM_OBJECTS);
+    auto heap_start = std::chrono::steady_clock::now();
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (auto& mem : memory) {
+            mem = ::operator new(sizeof(Item));
+            ::new (mem) Item(ObjectType::Item, true, glm::vec3(-1, 0, -1), ModelType::Cube, glm::vec3(1));
+        }
+        for (auto& mem : memory) {
+            static_cast<Item*>(mem)->~Item();
+            ::operator delete(mem);
+        }
+    }
+    auto heap_end = std::chrono::steady_clock::now();
+
+    std::vector<Object*> objects(NUM_OBJECTS);
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (auto& object : objects) {
+            object = makeItem();
+        }
+        for (auto& object : objects) {
+            delete object;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto per_object = [&](auto duration) {
+        return std::chrono::duration<double, std::nano>(duration).count() / ITERATIONS / NUM_OBJECTS;
+    };
+    std::cout << "Item new + delete: " << per_object(heap_end - heap_start) << " ns per object from the heap, "
+        << per_object(end - start) << " ns per object from its pool\n";
+    for (const auto& [name, stats] : getObjectPoolStats()) {
+        std::cout << "  " << name << ": " << stats.allocations << " allocations, peak "
+            << stats.peak_live << " live, " << stats.capacity << " slots in " << stats.slabs << " slabs\n";
+    }
+
+    EXPECT_EQ(statsFor("Item").live, 0);
+}
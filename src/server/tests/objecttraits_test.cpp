@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include "server/game/dungeonmaster.hpp"
+#include "server/game/minotaur.hpp"
+#include "server/game/mirror.hpp"
+#include "server/game/potion.hpp"
+#include "server/game/projectile.hpp"
+#include "server/game/python.hpp"
+#include "server/game/servergamestate.hpp"
+#include "server/game/slime.hpp"
+#include "server/game/spell.hpp"
+#include "server/game/weapon.hpp"
+#include "server/game/weaponcollider.hpp"
+#include "shared/utilities/config.hpp"
+
+#include "testconfig.hpp"
+
+/**
+ * A demo maze (which has walls, traps, torches, items and an exit) with one of
+ * everything else that the maze doesn't have added to it
+ */
+class ObjectTraitsTest : public ::testing::Test {
+protected:
+    ObjectTraitsTest():
+        state(GamePhase::GAME, demoMazeConfig())
+    {
+        glm::vec3 corner = this->state.getGrid().getRandomSpawnPoint();
+        glm::vec3 facing(1, 0, 0);
+
+        this->state.objects.createObject(new Player(corner, facing));
+        this->state.objects.createObject(new DungeonMaster(corner + glm::vec3(0, 25, 0), facing));
+        this->state.objects.createObject(new Slime(corner, facing, 1));
+        this->state.objects.createObject(new Python(corner, facing));
+        this->state.objects.createObject(new Minotaur(corner, facing));
+        this->state.objects.createObject(new Potion(corner, glm::vec3(1), PotionType::Health));
+        this->state.objects.createObject(new Spell(corner, glm::vec3(1), SpellType::Fireball));
+        this->state.objects.createObject(new Weapon(corner, glm::vec3(1), WeaponType::Sword));
+        this->state.objects.createObject(new Mirror(corner, glm::vec3(1)));
+        this->state.objects.createObject(new Arrow(corner, facing, Direction::LEFT));
+        this->state.objects.createObject(new ShortAttack(ObjectHandle<Player>(), corner, facing));
+    }
+
+    ServerGameState state;
+};
+
+/**
+ * Checks that as<T>() gives the same answer as dynamic_cast<T*>() for object
+ */
+template <typename T>
+static void expectSameAsDynamicCast(Object* object) {
+    EXPECT_EQ(object->as<T>(), dynamic_cast<T*>(object))
+        << objectTypeString(object->type) << " as " << typeid(T).name();
+    EXPECT_EQ(object->is<T>(), dynamic_cast<T*>(object) != nullptr);
+}
+
+TEST_F(ObjectTraitsTest, MatchesDynamicCast) {
+    std::size_t creatures = 0;
+    for (Object* object : this->state.objects.getObjects()) {
+        expectSameAsDynamicCast<Object>(object);
+        expectSameAsDynamicCast<Creature>(object);
+        expectSameAsDynamicCast<Enemy>(object);
+        expectSameAsDynamicCast<Item>(object);
+        expectSameAsDynamicCast<Trap>(object);
+        expectSameAsDynamicCast<Player>(object);
+        expectSameAsDynamicCast<DungeonMaster>(object);
+        expectSameAsDynamicCast<Slime>(object);
+        expectSameAsDynamicCast<Python>(object);
+        expectSameAsDynamicCast<Minotaur>(object);
+        expectSameAsDynamicCast<Potion>(object);
+        expectSameAsDynamicCast<Spell>(object);
+        expectSameAsDynamicCast<Weapon>(object);
+        expectSameAsDynamicCast<Mirror>(object);
+        expectSameAsDynamicCast<SolidSurface>(object);
+        expectSameAsDynamicCast<Projectile>(object);
+        expectSameAsDynamicCast<WeaponCollider>(object);
+
+        if (object->is<Creature>()) {
+            creatures++;
+        }
+    }
+
+    EXPECT_EQ(creatures, 5);
+    EXPECT_EQ(this->state.objects.getCreatures().numElements(), creatures);
+}
+
+TEST_F(ObjectTraitsTest, CreaturesViewFollowsRemoval) {
+    Creature* slime = nullptr;
+    for (Creature* creature : this->state.objects.getCreatures()) {
+        if (creature->is<Slime>()) {
+            slime = creature;
+        }
+    }
+    ASSERT_NE(slime, nullptr);
+
+    this->state.objects.removeObject(slime->globalID);
+    EXPECT_EQ(this->state.objects.getCreatures().numElements(), 4);
+    for (Creature* creature : this->state.objects.getCreatures()) {
+        EXPECT_FALSE(creature->is<Slime>());
+    }
+}
+
+/**
+ * Not a correctness test: reports how long it takes to pick the creatures out of
+ * every object in the maze, like doCollision and updateMovement do, with RTTI and
+ * with the ObjectType
+ */
+TEST_F(ObjectTraitsTest, DISABLED_CreatureCheckCost) {
+    const int ITERATIONS = 500;
+
+    const auto& objects = this->state.objects.getObjects();
+    std::size_t by_rtti = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (Object* object : objects) {
+            Creature* creature = dynamic_cast<Creature*>(object);
+            if (creature != nullptr) {
+                by_rtti += creature->stats.health.current();
+            }
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    std::size_t by_type = 0;
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (Object* object : objects) {
+            Creature* creature = object->as<Creature>();
+            if (creature != nullptr) {
+                by_type += creature->stats.health.current();
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto per_object = [&](auto duration) {
+        return std::chrono::duration<double, std::nano>(duration).count() / ITERATIONS / objects.numElements();
+    };
+    std::cout << "Creature check over " << objects.numElements() << " objects: dynamic_cast "
+        << per_object(mid - start) << " ns per object, as<Creature>() " << per_object(end - mid) << " ns per object\n";
+
+    EXPECT_EQ(by_rtti, by_type);
+}
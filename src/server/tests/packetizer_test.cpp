@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "server/game/servergamestate.hpp"
+#include "shared/network/packetizer.hpp"
+#include "shared/utilities/config.hpp"
+#include "shared/utilities/root_path.hpp"
+#include "shared/utilities/serialize.hpp"
+
+#include "testconfig.hpp"
+
+/**
+ * @returns The count largest .maze files in maps/demo, largest first
+ */
+static std::vector<std::string> largestDemoMazes(std::size_t count) {
+    std::vector<boost::filesystem::path> mazes;
+    for (const auto& entry : boost::filesystem::directory_iterator(getRepoRoot() / "maps" / "demo")) {
+        if (entry.path().extension() == ".maze") {
+            mazes.push_back(entry.path());
+        }
+    }
+
+    std::sort(mazes.begin(), mazes.end(), [](const auto& a, const auto& b) {
+        return boost::filesystem::file_size(a) > boost::filesystem::file_size(b);
+    });
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < count && i < mazes.size(); i++) {
+        names.push_back(mazes[i].filename().string());
+    }
+    return names;
+}
+
+/**
+ * @returns The LoadGameState chunk held in the packet, decoded the same way the client would
+ */
+static SharedGameState decodeChunk(const PackagedPacket& packet) {
+    auto buffers = packet.toBuffer();
+    PacketHeader hdr(const_cast<void*>(buffers[0].data()));
+    std::string data(static_cast<const char*>(buffers[1].data()), buffers[1].size());
+
+    EXPECT_EQ(hdr.type, PacketType::Event);
+    EXPECT_EQ(hdr.size, data.size());
+
+    Event event = deserialize<EventPacket>(data, hdr.format).event;
+    EXPECT_EQ(event.type, EventType::LoadGameState);
+    return std::get<LoadGameStateEvent>(event.data).state;
+}
+
+class PacketizerTest : public ::testing::TestWithParam<std::size_t> {};
+
+TEST_P(PacketizerTest, LargestDemoMazesFitInBudget) {
+    const std::size_t budget = GetParam();
+
+    auto mazes = largestDemoMazes(3);
+    ASSERT_FALSE(mazes.empty());
+
+    for (const auto& maze : mazes) {
+        ServerGameState state(GamePhase::GAME, demoMazeConfig(maze));
+        SharedGameState snapshot = state.generateSharedGameState(true);
+        snapshot.snapshot_id = 7;
+
+        auto packets = packetizeSnapshot(0, snapshot, budget);
+
+        std::size_t total_bytes = 0;
+        SharedGameState client;
+        for (std::size_t i = 0; i < packets.size(); i++) {
+            SharedGameState chunk = decodeChunk(*packets[i]);
+            EXPECT_EQ(chunk.snapshot_id, 7);
+            EXPECT_EQ(chunk.chunk_index, i);
+            EXPECT_EQ(chunk.num_chunks, packets.size());
+
+            // only allowed to go over budget when a single object doesn't fit by itself
+            if (chunk.objects.size() + chunk.object_deltas.size() > 1) {
+                EXPECT_LE(packets[i]->size(), budget) << maze << " chunk " << i;
+            }
+
+            client.update(chunk);
+            total_bytes += packets[i]->size();
+        }
+
+        EXPECT_EQ(client.objects.size(), snapshot.objects.size()) << maze;
+        EXPECT_EQ(client.phase, snapshot.phase) << maze;
+        EXPECT_EQ(client.lobby.max_players, snapshot.lobby.max_players) << maze;
+
+        std::cout << maze << ": " << snapshot.objects.size() << " objects in "
+            << packets.size() << " packets, " << total_bytes << " bytes with a "
+            << budget << " byte budget\n";
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Budgets, PacketizerTest, ::testing::Values(1400, 32768, 65536));
+
+TEST(PacketizerSingleTest, OversizedObjectGetsOwnPacket) {
+    SharedGameState snapshot;
+    for (EntityID id = 0; id < 3; id++) {
+        SharedObject obj;
+        obj.globalID = id;
+        obj.type = ObjectType::Player;
+        obj.inventoryInfo = SharedInventory {};
+        // way bigger than the budget
+        obj.inventoryInfo->usesRemaining = std::vector<int>(10'000, 1);
+        snapshot.objects.insert({id, obj});
+    }
+
+    auto packets = packetizeSnapshot(0, snapshot, 1400);
+    ASSERT_EQ(packets.size(), 3);
+
+    // 40 KB of data made it through, which would have overflowed the old 16 bit size
+    for (const auto& packet : packets) {
+        EXPECT_EQ(decodeChunk(*packet).objects.size(), 1);
+        EXPECT_GT(packet->size(), 40'000);
+    }
+}
+
+TEST(PacketizerSingleTest, EmptySnapshotStillSendsHeader) {
+    SharedGameState snapshot;
+    snapshot.phase = GamePhase::LOBBY;
+    snapshot.lobby.name = "lobby";
+
+    auto packets = packetizeSnapshot(0, snapshot, 1400);
+    ASSERT_EQ(packets.size(), 1);
+
+    SharedGameState chunk = decodeChunk(*packets[0]);
+    EXPECT_TRUE(chunk.isFirstChunk());
+    EXPECT_TRUE(chunk.isLastChunk());
+    EXPECT_EQ(chunk.lobby.name, "lobby");
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "server/game/object.hpp"
+#include "server/game/player.hpp"
+#include "server/game/servergamestate.hpp"
+#include "server/game/slime.hpp"
+#include "shared/utilities/config.hpp"
+
+#include "testconfig.hpp"
+
+/**
+ * Object that counts how many times it has been turned into a SharedObject
+ */
+class CountingObject : public Object {
+public:
+    CountingObject():
+        Object(ObjectType::Object, Physics(false, Collider::None, glm::vec3(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)), ModelType::Cube)
+    {}
+
+    SharedObject toShared() override {
+        this->builds++;
+        return Object::toShared();
+    }
+
+    int builds = 0;
+};
+
+TEST(SharedCacheTest, OnlyRebuildsDirtyObjects) {
+    CountingObject object;
+
+    object.getShared();
+    object.getShared();
+    EXPECT_EQ(object.builds, 1);
+
+    // never broadcast, so everything counts as changed even though it was built
+    EXPECT_EQ(object.takeSharedChanges(), ALL_SHARED_OBJECT_FIELDS);
+    EXPECT_EQ(object.builds, 1);
+
+    // not dirty, so nothing to do
+    EXPECT_EQ(object.takeSharedChanges(), 0);
+    EXPECT_EQ(object.builds, 1);
+
+    // dirty but the same
+    object.markDirty();
+    EXPECT_EQ(object.takeSharedChanges(), 0);
+    EXPECT_EQ(object.builds, 2);
+
+    object.physics.shared.corner.x += 1.0f;
+    object.animState = AnimState::WalkAnim;
+    object.markDirty();
+    EXPECT_EQ(object.takeSharedChanges(),
+        fieldBit(SharedObjectField::Physics) | fieldBit(SharedObjectField::AnimState));
+    EXPECT_EQ(object.getShared().physics.corner.x, 2.0f);
+    EXPECT_EQ(object.builds, 3);
+}
+
+TEST(SharedCacheTest, GetSharedDoesNotHideChangesFromBroadcast) {
+    CountingObject object;
+    object.takeSharedChanges();
+
+    // e.g. a resync picks up the change before the next broadcast does
+    object.physics.shared.corner.x += 1.0f;
+    object.markDirty();
+    EXPECT_EQ(object.getShared().physics.corner.x, 2.0f);
+
+    EXPECT_EQ(object.takeSharedChanges(), fieldBit(SharedObjectField::Physics));
+    EXPECT_EQ(object.takeSharedChanges(), 0);
+}
+
+TEST(SharedCacheTest, NewObjectsAreBroadcastAfterResync) {
+    ServerGameState state(GamePhase::GAME, demoMazeConfig());
+    state.generateSharedGameState(false);
+
+    // like a player who connects: their own resync builds them before anyone
+    // else has been sent them
+    auto player = new Player(state.getGrid().getRandomSpawnPoint(), glm::vec3(0.0f));
+    state.objects.createObject(player);
+    state.generateSharedGameState(true);
+
+    state.updateMovement();
+    EXPECT_TRUE(state.generateSharedGameState(false).objects.contains(player->globalID));
+}
+
+TEST(SharedCacheTest, MarkingAsUpdatedRefreshesGetShared) {
+    ServerGameState state(GamePhase::GAME, demoMazeConfig());
+    auto slime = new Slime(state.getGrid().getRandomSpawnPoint(), glm::vec3(1, 0, 1), 1);
+    state.objects.createObject(slime);
+    state.generateSharedGameState(false);
+    slime->getShared();
+
+    slime->animState = AnimState::WalkAnim;
+    state.markAsUpdated(slime->globalID);
+    EXPECT_EQ(slime->getShared().animState, AnimState::WalkAnim);
+
+    auto update = state.generateSharedGameState(false);
+    ASSERT_TRUE(update.objects.contains(slime->globalID));
+    EXPECT_EQ(update.objects.at(slime->globalID)->animState, AnimState::WalkAnim);
+}
+
+TEST(SharedCacheTest, UpdatesLeaveOutUnchangedObjects) {
+    ServerGameState state(GamePhase::GAME, demoMazeConfig());
+
+    auto slime = new Slime(state.getGrid().getRandomSpawnPoint(), glm::vec3(1, 0, 1), 1);
+    state.objects.createObject(slime);
+
+    // every movable object counts as updated by updateMovement, but only goes
+    // out if it actually moved
+    state.updateMovement();
+    EXPECT_TRUE(state.generateSharedGameState(false).objects.contains(slime->globalID));
+
+    state.updateMovement();
+    EXPECT_FALSE(state.generateSharedGameState(false).objects.contains(slime->globalID));
+
+    slime->physics.velocity() = glm::vec3(0.1f, 0.0f, 0.0f);
+    state.updateMovement();
+    EXPECT_TRUE(state.generateSharedGameState(false).objects.contains(slime->globalID));
+
+    // everything is still there for a full update
+    EXPECT_EQ(state.generateSharedGameState(true).objects.size(), state.objects.getObjects().numElements());
+}
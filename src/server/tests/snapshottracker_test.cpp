@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include "server/snapshottracker.hpp"
+#include "shared/game/event.hpp"
+#include "shared/network/constants.hpp"
+#include "shared/utilities/serialize.hpp"
+
+static SharedObject makeObject(EntityID id) {
+    SharedObject obj;
+    obj.globalID = id;
+    obj.type = ObjectType::Player;
+    obj.physics.corner = glm::vec3(1.0f * id, 0.0f, 2.0f);
+    obj.physics.facing = glm::vec3(1.0f, 0.0f, 0.0f);
+    obj.physics.dimensions = glm::vec3(1.0f, 2.0f, 1.0f);
+    obj.modelType = ModelType::PlayerFire;
+    obj.animState = AnimState::IdleAnim;
+    obj.stats = SharedStats(Stat<int>(0, 100, 100), Stat<int>(0, 10, 5));
+    obj.inventoryInfo = SharedInventory {
+        .selected = 1,
+        .inventory_size = 4,
+        .inventory = {ModelType::HealthPotion, ModelType::Frame, ModelType::Frame, ModelType::Frame},
+        .usesRemaining = {1, 0, 0, 0},
+        .usedItems = {},
+        .hasOrb = false
+    };
+    obj.statuses = SharedStatuses();
+    return obj;
+}
+
+static SharedGameState makeUpdate(const std::vector<boost::optional<SharedObject>>& objects) {
+    SharedGameState update;
+    for (const auto& obj : objects) {
+        if (obj.has_value()) {
+            update.objects.insert({obj->globalID, obj});
+        }
+    }
+    return update;
+}
+
+TEST(SnapshotTrackerTest, SendsFullObjectUntilAcknowledged) {
+    SnapshotTracker tracker;
+    SharedObject obj = makeObject(1);
+
+    SharedGameState first = tracker.encode(makeUpdate({obj}));
+    EXPECT_NE(first.snapshot_id, 0);
+    EXPECT_EQ(first.objects.size(), 1);
+    EXPECT_TRUE(first.object_deltas.empty());
+
+    // not acknowledged, so still have to send the full object
+    SharedGameState second = tracker.encode(makeUpdate({obj}));
+    EXPECT_GT(second.snapshot_id, first.snapshot_id);
+    EXPECT_EQ(second.objects.size(), 1);
+    EXPECT_EQ(tracker.numUnacknowledged(), 2);
+
+    tracker.acknowledge(second.snapshot_id);
+    EXPECT_EQ(tracker.numUnacknowledged(), 0);
+
+    // client has exactly this object, so nothing needs to be sent for it
+    SharedGameState third = tracker.encode(makeUpdate({obj}));
+    EXPECT_TRUE(third.objects.empty());
+    EXPECT_TRUE(third.object_deltas.empty());
+}
+
+TEST(SnapshotTrackerTest, SendsOnlyChangedFields) {
+    SnapshotTracker tracker;
+    SharedObject obj = makeObject(1);
+
+    SharedGameState client;
+    SharedGameState first = tracker.encode(makeUpdate({obj}));
+    client.update(first);
+    tracker.acknowledge(first.snapshot_id);
+
+    obj.physics.corner += glm::vec3(0.5f, 0.0f, 0.0f);
+    SharedGameState second = tracker.encode(makeUpdate({obj}));
+    ASSERT_EQ(second.object_deltas.size(), 1);
+    EXPECT_TRUE(second.objects.empty());
+    EXPECT_EQ(second.object_deltas.at(1).fields, fieldBit(SharedObjectField::Physics));
+
+    client.update(deserialize<SharedGameState>(serialize(second)));
+    EXPECT_EQ(client.objects.at(1)->diff(obj), 0);
+}
+
+TEST(SnapshotTrackerTest, ResendsFieldsFromUnacknowledgedSnapshots) {
+    SnapshotTracker tracker;
+    SharedObject obj = makeObject(1);
+
+    SharedGameState client;
+    SharedGameState first = tracker.encode(makeUpdate({obj}));
+    client.update(first);
+    tracker.acknowledge(first.snapshot_id);
+
+    // health drops, and then goes back to the baseline value before the client
+    // acknowledges the drop. The client has already applied the drop, so the
+    // restored value must still be sent
+    SharedObject hurt = obj;
+    hurt.stats->health.decrease(10);
+    client.update(tracker.encode(makeUpdate({hurt})));
+
+    SharedGameState restored = tracker.encode(makeUpdate({obj}));
+    ASSERT_EQ(restored.object_deltas.size(), 1);
+    EXPECT_TRUE(restored.object_deltas.at(1).has(SharedObjectField::Stats));
+
+    client.update(restored);
+    EXPECT_EQ(client.objects.at(1)->diff(obj), 0);
+}
+
+TEST(SnapshotTrackerTest, DeletedObjectsAreSent) {
+    SnapshotTracker tracker;
+    SharedObject obj = makeObject(1);
+
+    SharedGameState first = tracker.encode(makeUpdate({obj}));
+    tracker.acknowledge(first.snapshot_id);
+
+    SharedGameState deletion;
+    deletion.objects.insert({1, boost::none});
+    SharedGameState second = tracker.encode(deletion);
+    ASSERT_EQ(second.objects.count(1), 1);
+    EXPECT_FALSE(second.objects.at(1).has_value());
+    tracker.acknowledge(second.snapshot_id);
+
+    // the client no longer has the object, so it has to be sent in full
+    SharedGameState third = tracker.encode(makeUpdate({obj}));
+    EXPECT_EQ(third.objects.size(), 1);
+}
+
+TEST(SnapshotTrackerTest, ResetsWhenClientStopsAcknowledging) {
+    SnapshotTracker tracker;
+    SharedObject obj = makeObject(1);
+
+    SharedGameState first = tracker.encode(makeUpdate({obj}));
+    tracker.acknowledge(first.snapshot_id);
+
+    for (int i = 0; i < MAX_UNACKED_SNAPSHOTS + 1; i++) {
+        tracker.encode(makeUpdate({obj}));
+    }
+    EXPECT_LE(tracker.numUnacknowledged(), MAX_UNACKED_SNAPSHOTS);
+}
+
+TEST(SnapshotTrackerTest, SteadyStateIsMuchSmallerThanFullObjects) {
+    SnapshotTracker tracker;
+
+    std::vector<boost::optional<SharedObject>> objects;
+    for (EntityID id = 0; id < 250; id++) {
+        objects.push_back(makeObject(id));
+    }
+
+    SharedGameState first = tracker.encode(makeUpdate(objects));
+    tracker.acknowledge(first.snapshot_id);
+
+    // every object moves, but nothing else about them changes
+    for (auto& obj : objects) {
+        obj->physics.corner += glm::vec3(0.1f, 0.0f, 0.0f);
+    }
+
+    std::size_t full_size = serialize(makeUpdate(objects)).size();
+    std::size_t delta_size = serialize(tracker.encode(makeUpdate(objects))).size();
+
+    std::cout << "full update: " << full_size << " bytes, delta update: "
+        << delta_size << " bytes\n";
+    EXPECT_LT(delta_size * 2, full_size);
+}
+
+TEST(SnapshotTrackerTest, UnreliableSnapshotsSurviveLoss) {
+    SnapshotTracker tracker;
+    tracker.setReliable(false);
+    SharedObject a = makeObject(1);
+    SharedObject b = makeObject(2);
+
+    // the snapshot with a in it is lost, but a comes along with the next one
+    SharedGameState client;
+    tracker.encode(makeUpdate({a}));
+    SharedGameState second = tracker.encode(makeUpdate({b}));
+    client.update(second);
+    ASSERT_TRUE(client.objects.contains(1));
+    EXPECT_EQ(client.objects.at(1)->diff(a), 0);
+    tracker.acknowledge(second.snapshot_id);
+
+    // nothing changes, so nothing needs to be sent
+    EXPECT_TRUE(tracker.encode(SharedGameState()).objects.empty());
+
+    // same goes for a lost deletion
+    SharedGameState deletion;
+    deletion.objects.insert({2, boost::none});
+    tracker.encode(deletion);
+    SharedGameState fourth = tracker.encode(SharedGameState());
+    ASSERT_EQ(fourth.objects.count(2), 1);
+    EXPECT_FALSE(fourth.objects.at(2).has_value());
+
+    // and a lost change to a field, which is resent until it is acknowledged
+    SharedObject moved = a;
+    moved.physics.corner.x += 5.0f;
+    tracker.encode(makeUpdate({moved}));
+    SharedGameState sixth = tracker.encode(SharedGameState());
+    client.update(fourth);
+    client.update(sixth);
+    tracker.acknowledge(sixth.snapshot_id);
+
+    EXPECT_EQ(client.objects.at(1)->diff(moved), 0);
+    EXPECT_FALSE(client.objects.contains(2));
+    EXPECT_TRUE(tracker.encode(SharedGameState()).objects.empty());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "server/game/item.hpp"
+#include "server/game/servergamestate.hpp"
+#include "server/game/spatialgrid.hpp"
+#include "shared/utilities/config.hpp"
+
+#include "testconfig.hpp"
+
+static bool bucketHas(const CellBucket& bucket, Object* object) {
+    return std::find(bucket.begin(), bucket.end(), object) != bucket.end();
+}
+
+/**
+ * Only the addresses are used, so these never get dereferenced
+ */
+static Object* fakeObject(std::size_t i) {
+    return reinterpret_cast<Object*>(0x1000 + i * 0x10);
+}
+
+TEST(CellBucketTest, GrowsPastInlineCapacity) {
+    CellBucket bucket;
+    for (std::size_t i = 0; i < 20; i++) {
+        bucket.push(fakeObject(i));
+    }
+
+    EXPECT_EQ(bucket.size(), 20);
+    for (std::size_t i = 0; i < 20; i++) {
+        EXPECT_TRUE(bucketHas(bucket, fakeObject(i)));
+    }
+}
+
+TEST(CellBucketTest, RemovesOneOccurrence) {
+    CellBucket bucket;
+    bucket.push(fakeObject(0));
+    bucket.push(fakeObject(1));
+    bucket.push(fakeObject(2));
+    bucket.push(fakeObject(1));
+
+    EXPECT_TRUE(bucket.remove(fakeObject(1)));
+    EXPECT_EQ(bucket.size(), 3);
+    EXPECT_TRUE(bucketHas(bucket, fakeObject(1)));
+
+    EXPECT_TRUE(bucket.remove(fakeObject(1)));
+    EXPECT_FALSE(bucket.remove(fakeObject(1)));
+    EXPECT_EQ(bucket.size(), 2);
+    EXPECT_TRUE(bucketHas(bucket, fakeObject(0)));
+    EXPECT_TRUE(bucketHas(bucket, fakeObject(2)));
+
+    bucket.clear();
+    EXPECT_TRUE(bucket.empty());
+}
+
+TEST(SpatialGridTest, OutOfBoundsCellsShareFallback) {
+    SpatialGrid grid;
+    grid.resize(3, 2);
+
+    EXPECT_TRUE(grid.inBounds(glm::ivec2(2, 1)));
+    EXPECT_FALSE(grid.inBounds(glm::ivec2(3, 0)));
+    EXPECT_FALSE(grid.inBounds(glm::ivec2(0, 2)));
+    EXPECT_FALSE(grid.inBounds(glm::ivec2(-1, -1)));
+
+    grid.at(glm::ivec2(-1, -1)).push(fakeObject(0));
+    grid.at(glm::ivec2(2, 1)).push(fakeObject(1));
+
+    EXPECT_EQ(&grid.at(glm::ivec2(5, 5)), &grid.outOfBounds());
+    EXPECT_TRUE(bucketHas(grid.at(glm::ivec2(5, 5)), fakeObject(0)));
+    EXPECT_TRUE(bucketHas(grid.at(glm::ivec2(2, 1)), fakeObject(1)));
+    EXPECT_TRUE(grid.at(glm::ivec2(1, 1)).empty());
+
+    // cells are row-major, so (x, y) and (y, x) are different buckets
+    EXPECT_NE(&grid.at(glm::ivec2(1, 0)), &grid.at(glm::ivec2(0, 1)));
+
+    grid.resize(4, 4);
+    EXPECT_TRUE(grid.outOfBounds().empty());
+    EXPECT_TRUE(grid.at(glm::ivec2(2, 1)).empty());
+}
+
+class ObjectManagerGridTest : public ::testing::Test {
+protected:
+    ObjectManagerGridTest():
+        state(GamePhase::GAME, demoMazeConfig())
+    {}
+
+    /**
+     * Checks that every object is in the bucket of each cell it is in
+     */
+    void expectGridMatchesObjects() {
+        for (Object* object : this->state.objects.getObjects()) {
+            for (glm::ivec2 cell : object->gridCellPositions) {
+                EXPECT_TRUE(bucketHas(this->state.objects.spatialGrid.at(cell), object))
+                    << objectTypeString(object->type) << " missing from (" << cell.x << ", " << cell.y << ")";
+            }
+        }
+    }
+
+    ServerGameState state;
+};
+
+TEST_F(ObjectManagerGridTest, SizedToMaze) {
+    EXPECT_EQ(this->state.objects.spatialGrid.getColumns(), this->state.getGrid().getColumns());
+    EXPECT_EQ(this->state.objects.spatialGrid.getRows(), this->state.getGrid().getRows());
+    this->expectGridMatchesObjects();
+}
+
+TEST_F(ObjectManagerGridTest, FollowsMovesAndRemoval) {
+    glm::vec3 start = this->state.getGrid().getRandomSpawnPoint();
+    auto item = new Item(ObjectType::Item, true, start, ModelType::Cube, glm::vec3(1));
+    this->state.objects.createObject(item);
+    this->state.objects.moveObject(item, start);
+
+    CellRange old_cells = item->gridCellPositions;
+    ASSERT_FALSE(old_cells.empty());
+    this->expectGridMatchesObjects();
+
+    // held items are parked outside of the maze
+    this->state.objects.moveObject(item, glm::vec3(-1, 0, -1));
+    this->expectGridMatchesObjects();
+    EXPECT_TRUE(bucketHas(this->state.objects.spatialGrid.outOfBounds(), item));
+    for (glm::ivec2 cell : old_cells) {
+        EXPECT_FALSE(bucketHas(this->state.objects.spatialGrid.at(cell), item));
+    }
+
+    this->state.objects.removeObject(item->globalID);
+    EXPECT_FALSE(bucketHas(this->state.objects.spatialGrid.outOfBounds(), item));
+    this->expectGridMatchesObjects();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+#include "shared/utilities/config.hpp"
+
+/**
+ * @returns Config for a ServerGameState that loads the given maze file from maps/demo,
+ * with room for 4 players and no enemies spawned by the maze
+ */
+inline GameConfig demoMazeConfig(const std::string& maze_file = "game1_player_pov.maze") {
+    GameConfig config {};
+    config.server.max_players = 4;
+    config.server.disable_enemies = true;
+    config.server.maze.directory = "maps";
+    config.server.maze.procedural = false;
+    config.server.maze.maze_file = "demo/" + maze_file;
+    return config;
+}
@@ -1,5 +1,16 @@
 #include "shared/game/event.hpp"
 
+Event::Event(EntityID evt_source, EventType type, EventData data):
+    evt_source(evt_source),
+    type(static_cast<EventType>(data.index())),
+    data(std::move(data))
+{
+    // the data is what gets sent, so that is what decides the type
+    if (this->type != type) {
+        std::cerr << "Event created as " << type << " with the data of a " << this->type << std::endl;
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const Event& evt) {
     os << "Event { .evt_source=" << evt.evt_source
         << " .type=" << evt.type << "}";
@@ -16,6 +27,7 @@ std::ostream& operator<<(std::ostream& os, const EventType& type) {
         TO_STR(ChangeFacing);
         TO_STR(LobbyAction);
         TO_STR(LoadGameState);
+        TO_STR(LoadSoundCommands);
         TO_STR(StartAction);
         TO_STR(StopAction);
         TO_STR(MoveRelative);
@@ -24,6 +36,11 @@ std::ostream& operator<<(std::ostream& os, const EventType& type) {
         TO_STR(SelectItem);
         TO_STR(UseItem);
         TO_STR(DropItem);
+        TO_STR(UpdateLightSources);
+        TO_STR(TrapPlacement);
+        TO_STR(LoadIntroCutscene);
+        TO_STR(AckSnapshot);
+        TO_STR(ReconcileMovement);
     default:
         os << "Unknown EventType";
         break;
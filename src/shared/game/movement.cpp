@@ -0,0 +1,121 @@
+#include "shared/game/movement.hpp"
+
+glm::vec3 moveCamVelocity(glm::vec3 velocity, glm::vec3 movement) {
+	velocity.x = (movement * PLAYER_SPEED).x;
+	velocity.z = (movement * PLAYER_SPEED).z;
+	return velocity;
+}
+
+bool startJump(glm::vec3& velocity, glm::vec3 movement, bool feels_gravity) {
+	if (!feels_gravity || velocity.y != 0) {
+		return false;
+	}
+
+	velocity.y += (movement * JUMP_SPEED / 2.0f).y;
+	return true;
+}
+
+glm::vec3 moveWithCollisions(glm::vec3 corner, glm::vec3 total_step,
+	const std::function<bool(glm::vec3)>& collides,
+	const std::function<void(glm::vec3)>& move) {
+	//	If objects move too fast, split their movement into NUM_INCREMENTAL_STEPS
+	const int NUM_INCREMENTAL_STEPS = 6;
+
+	//	This is the threshold that determines whether we need to use incremental
+	//	steps. If the magnitude of the movementStep vector is greater than this
+	//	value, then we'll split the movementStep into multiple incremental steps
+	const float SINGLE_MOVE_THRESHOLD = 0.33f;
+
+	//	This ratio is the reciprocal of NUM_INCREMENTAL_STEPS
+	const float INCREMENTAL_MOVE_RATIO = 1.0f / NUM_INCREMENTAL_STEPS;
+
+	glm::vec3 movementStep;
+	int numSteps = 0;
+	if (glm::length(total_step) > SINGLE_MOVE_THRESHOLD) {
+		movementStep = INCREMENTAL_MOVE_RATIO * total_step;
+	} else {
+		movementStep = total_step;
+		numSteps = NUM_INCREMENTAL_STEPS - 1;
+	}
+
+	//	Object's current position (before current movementStep)
+	glm::vec3 currentPosition = corner;
+
+	//	Perform collision detection + movement update for each incremental
+	//	step (or this loop only iterates once if incremental steps are not
+	//	used)
+	while (numSteps < NUM_INCREMENTAL_STEPS) {
+		numSteps++;
+
+		bool collidedX = false;
+		bool collidedZ = false;
+
+		//	Move object to new position and check whether a collision has
+		//	occurred. If so, repeat collision checking for movement if
+		//	object's position is only updated in the x or z axes.
+		if (collides(currentPosition + movementStep)) {
+			collidedX = collides(glm::vec3(
+				currentPosition.x + movementStep.x,
+				currentPosition.y,
+				currentPosition.z
+			));
+
+			collidedZ = collides(glm::vec3(
+				currentPosition.x,
+				currentPosition.y,
+				currentPosition.z + movementStep.z
+			));
+		}
+
+		//	Horizontal movement
+		if (collidedX) {
+			movementStep.x = 0;
+		}
+		if (collidedZ) {
+			movementStep.z = 0;
+		}
+
+		currentPosition += movementStep;
+		move(currentPosition);
+
+		if (collidedX && collidedZ) {
+			//	Object doesn't move at all - can skip any additional steps
+			break;
+		}
+	}
+
+	return currentPosition;
+}
+
+bool clampToFloor(glm::vec3& corner) {
+	if (corner.y < 0) {
+		corner.y = 0;
+		return true;
+	}
+	return false;
+}
+
+void updateGravity(glm::vec3& velocity, float corner_y, bool feels_gravity) {
+	if (!feels_gravity) {
+		return;
+	}
+
+	if (corner_y > 0) {
+		velocity.y -= GRAVITY;
+	} else {
+		velocity.y = 0.0f;
+	}
+}
+
+bool boxesOverlap(glm::vec3 corner1, glm::vec3 dimensions1,
+	glm::vec3 corner2, glm::vec3 dimensions2) {
+	glm::vec3 max1 = corner1 + dimensions1;
+	glm::vec3 max2 = corner2 + dimensions2;
+
+	return (max1.x >= corner2.x &&
+		corner1.x <= max2.x &&
+		max1.y >= corner2.y &&
+		corner1.y <= max2.y &&
+		max1.z >= corner2.z &&
+		corner1.z <= max2.z);
+}
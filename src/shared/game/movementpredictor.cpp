@@ -0,0 +1,202 @@
+#include "shared/game/movementpredictor.hpp"
+
+#include <cmath>
+
+#include "shared/game/movement.hpp"
+
+/**
+ * @return Cell that the given position is in
+ */
+static glm::ivec2 cellOf(glm::vec3 position) {
+	return glm::ivec2(
+		static_cast<int>(std::floor(position.x / PREDICTION_CELL_WIDTH)),
+		static_cast<int>(std::floor(position.z / PREDICTION_CELL_WIDTH)));
+}
+
+MovementPredictor::MovementPredictor():
+	active(false),
+	corner(0.0f),
+	dimensions(0.0f),
+	velocity(0.0f),
+	velocity_multiplier(1.0f),
+	input{.movement = glm::vec3(0.0f), .jump = false, .sprint = false},
+	correction(0.0f)
+{
+}
+
+void MovementPredictor::setStaticColliders(const SharedGameState& state) {
+	this->colliders.clear();
+
+	for (const auto& [id, obj] : state.objects) {
+		// Walls are the only things that never move and always block players. The
+		// floor doesn't have a collider, since gravity already stops at it
+		if (!obj.has_value() || obj->type != ObjectType::SolidSurface ||
+			!obj->solidSurface.has_value() || obj->solidSurface->surfaceType == SurfaceType::Floor) {
+			continue;
+		}
+
+		Box box {.corner = obj->physics.corner, .dimensions = obj->physics.dimensions};
+		glm::ivec2 min_cell = cellOf(box.corner);
+		glm::ivec2 max_cell = cellOf(box.corner + box.dimensions);
+		for (int x = min_cell.x; x <= max_cell.x; x++) {
+			for (int z = min_cell.y; z <= max_cell.y; z++) {
+				this->colliders[glm::ivec2(x, z)].push_back(box);
+			}
+		}
+	}
+}
+
+void MovementPredictor::reset(const SharedPhysics& physics) {
+	this->active = true;
+	this->corner = physics.corner;
+	this->dimensions = physics.dimensions;
+	this->velocity = glm::vec3(0.0f);
+	this->velocity_multiplier = this->input.sprint ? SPRINT_MULTIPLIER : glm::vec3(1.0f);
+	this->history.clear();
+	this->correction = glm::vec3(0.0f);
+}
+
+void MovementPredictor::stop() {
+	this->active = false;
+	this->history.clear();
+	this->correction = glm::vec3(0.0f);
+}
+
+bool MovementPredictor::isActive() const {
+	return this->active;
+}
+
+void MovementPredictor::applyInput(const Event& event) {
+	switch (event.type) {
+		case EventType::StartAction: {
+			const auto& start = std::get<StartActionEvent>(event.data);
+			if (start.action == ActionType::MoveCam) {
+				this->input.movement = start.movement;
+			} else if (start.action == ActionType::Jump) {
+				this->input.jump = true;
+			} else if (start.action == ActionType::Sprint) {
+				this->input.sprint = true;
+			}
+			break;
+		}
+		case EventType::StopAction: {
+			const auto& stop = std::get<StopActionEvent>(event.data);
+			if (stop.action == ActionType::MoveCam) {
+				this->input.movement = glm::vec3(0.0f);
+			} else if (stop.action == ActionType::Sprint) {
+				this->input.sprint = false;
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void MovementPredictor::tick(uint32_t input_sequence) {
+	if (!this->active) {
+		return;
+	}
+
+	this->_step(this->input);
+	this->history.push_back(PredictedTick {.input_sequence = input_sequence, .input = this->input});
+	if (this->history.size() > PREDICTION_MAX_HISTORY) {
+		this->history.pop_front();
+	}
+
+	// a jump only happens once per press
+	this->input.jump = false;
+
+	this->correction *= PREDICTION_CORRECTION_DECAY;
+	this->stats.ticks_predicted++;
+}
+
+void MovementPredictor::reconcile(const ReconcileMovementEvent& authoritative) {
+	if (!this->active) {
+		return;
+	}
+
+	// the server has already applied these, so its position includes them
+	while (!this->history.empty() &&
+		this->history.front().input_sequence <= authoritative.input_sequence) {
+		this->history.pop_front();
+	}
+
+	glm::vec3 predicted = this->getCorner();
+
+	this->corner = authoritative.corner;
+	this->velocity = authoritative.velocity;
+	this->velocity_multiplier = authoritative.velocity_multiplier;
+	for (const PredictedTick& tick : this->history) {
+		this->_step(tick.input);
+		this->stats.ticks_replayed++;
+	}
+
+	// keep drawing where we were, and ease over to the corrected position
+	const float MIN_CORRECTION = 0.001f;
+	glm::vec3 error = predicted - this->corner;
+	this->stats.last_error = glm::length(error);
+	if (this->stats.last_error > MIN_CORRECTION) {
+		this->stats.corrections++;
+	}
+
+	if (this->stats.last_error > PREDICTION_SNAP_DISTANCE) {
+		this->correction = glm::vec3(0.0f);
+	} else {
+		this->correction = error;
+	}
+}
+
+glm::vec3 MovementPredictor::getCorner() const {
+	return this->corner + this->correction;
+}
+
+glm::vec3 MovementPredictor::getPredictedCorner() const {
+	return this->corner;
+}
+
+std::size_t MovementPredictor::numUnconfirmed() const {
+	return this->history.size();
+}
+
+const MovementPredictionStats& MovementPredictor::getStats() const {
+	return this->stats;
+}
+
+void MovementPredictor::_step(const Input& input) {
+	// the same as the server does when it gets these inputs and then runs a tick
+	this->velocity = moveCamVelocity(this->velocity, input.movement);
+	this->velocity_multiplier = input.sprint ? SPRINT_MULTIPLIER : glm::vec3(1.0f);
+	if (input.jump) {
+		startJump(this->velocity, glm::vec3(0.0f, 1.0f, 0.0f), true);
+	}
+
+	this->corner = moveWithCollisions(this->corner, this->velocity * this->velocity_multiplier,
+		[this](glm::vec3 corner) { return this->_collides(corner); },
+		[](glm::vec3 /*corner*/) {});
+
+	clampToFloor(this->corner);
+	updateGravity(this->velocity, this->corner.y, true);
+}
+
+bool MovementPredictor::_collides(glm::vec3 corner) const {
+	glm::ivec2 min_cell = cellOf(corner);
+	glm::ivec2 max_cell = cellOf(corner + this->dimensions);
+
+	for (int x = min_cell.x; x <= max_cell.x; x++) {
+		for (int z = min_cell.y; z <= max_cell.y; z++) {
+			auto cell = this->colliders.find(glm::ivec2(x, z));
+			if (cell == this->colliders.end()) {
+				continue;
+			}
+
+			for (const Box& box : cell->second) {
+				if (boxesOverlap(corner, this->dimensions, box.corner, box.dimensions)) {
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
@@ -1,20 +1,39 @@
 #include "shared/game/sharedgamestate.hpp"
 #include "shared/game/event.hpp"
 
-void SharedGameState::update(const SharedGameState& other) {
-    // copy over static data that is sent every update
-    this->lobby = other.lobby;
+#include <iostream>
 
-    this->phase = other.phase;
-    this->timestep = other.timestep;
-    this->matchPhase = other.matchPhase;
-    this->relay_finish_time = other.relay_finish_time;
-    this->playerVictory = other.playerVictory;
-    this->numPlayerDeaths = other.numPlayerDeaths;
+void SharedGameState::update(const SharedGameState& other) {
+    // copy over static data that is sent with the first chunk of every snapshot
+    if (other.isFirstChunk()) {
+        this->lobby = other.lobby;
+
+        this->phase = other.phase;
+        this->timestep = other.timestep;
+        this->matchPhase = other.matchPhase;
+        this->relay_finish_time = other.relay_finish_time;
+        this->playerVictory = other.playerVictory;
+        this->numPlayerDeaths = other.numPlayerDeaths;
+    }
 
-    // Update our own objects hash map based on new updates
+    // Update our own objects hash map based on new updates. Objects that were deleted
+    // (or that the server stopped sending us) are dropped entirely
     for (const auto& [id, updated_obj] : other.objects) { // cppcheck-suppress unassignedVariable
-        this->objects[id] = updated_obj;
+        if (updated_obj.has_value()) {
+            this->objects[id] = updated_obj;
+        } else {
+            this->objects.erase(id);
+        }
+    }
+
+    // Apply field level updates on top of the objects we already have
+    for (const auto& [id, delta] : other.object_deltas) { // cppcheck-suppress unassignedVariable
+        auto obj = this->objects.find(id);
+        if (obj == this->objects.end() || !obj->second.has_value()) {
+            std::cerr << "Received SharedObjectDelta for unknown object " << id << std::endl;
+            continue;
+        }
+        obj->second->applyDelta(delta);
     }
 }
 
@@ -95,3 +95,57 @@ size_t SharedStatuses::getStatusLength(Status status) const {
         return 0;
     }
 }
+
+// Calls FIELD(SharedObjectField, SharedObject member) for every field that can be
+// sent inside of a SharedObjectDelta
+#define FOR_EACH_DELTA_FIELD(FIELD) \
+	FIELD(Type, type) \
+	FIELD(Physics, physics) \
+	FIELD(ModelType, modelType) \
+	FIELD(AnimState, animState) \
+	FIELD(Stats, stats) \
+	FIELD(ItemInfo, iteminfo) \
+	FIELD(SolidSurface, solidSurface) \
+	FIELD(TrapInfo, trapInfo) \
+	FIELD(PlayerInfo, playerInfo) \
+	FIELD(InventoryInfo, inventoryInfo) \
+	FIELD(TrapInventoryInfo, trapInventoryInfo) \
+	FIELD(PointLightInfo, pointLightInfo) \
+	FIELD(Statuses, statuses) \
+	FIELD(Exit, exit) \
+	FIELD(WeaponInfo, weaponInfo) \
+	FIELD(DMInfo, DMInfo) \
+	FIELD(Compass, compass)
+
+SharedObjectFieldMask SharedObject::diff(const SharedObject& other) const {
+	SharedObjectFieldMask fields = 0;
+
+#define DIFF_FIELD(field, member) \
+	if (!(this->member == other.member)) fields |= fieldBit(SharedObjectField::field);
+
+	FOR_EACH_DELTA_FIELD(DIFF_FIELD)
+#undef DIFF_FIELD
+
+	return fields;
+}
+
+void SharedObject::applyDelta(const SharedObjectDelta& delta) {
+#define APPLY_FIELD(field, member) \
+	if (delta.has(SharedObjectField::field)) this->member = delta.values.member;
+
+	FOR_EACH_DELTA_FIELD(APPLY_FIELD)
+#undef APPLY_FIELD
+}
+
+SharedObjectDelta::SharedObjectDelta(const SharedObject& obj, SharedObjectFieldMask fields):
+	fields(fields)
+{
+	this->values.globalID = obj.globalID;
+
+	//	Only copy over the fields in the mask, since the rest will never be serialized
+#define COPY_FIELD(field, member) \
+	if (this->has(SharedObjectField::field)) this->values.member = obj.member;
+
+	FOR_EACH_DELTA_FIELD(COPY_FIELD)
+#undef COPY_FIELD
+}
@@ -0,0 +1,53 @@
+#include "shared/netsim/delayline.hpp"
+
+#include <algorithm>
+
+DelayLine::DelayLine(LinkConditions conditions, bool reliable):
+    conditions(conditions),
+    reliable(reliable),
+    rng(conditions.seed)
+{
+}
+
+std::optional<DelayLine::Clock::time_point> DelayLine::schedule(std::size_t bytes, Clock::time_point now) {
+    this->stats.sends++;
+    this->stats.bytes_sent += bytes;
+
+    // with a bandwidth cap, sends queue up behind each other to get on the wire
+    Clock::time_point sent = now;
+    if (this->conditions.bandwidth > 0) {
+        auto wire_time = std::chrono::microseconds(bytes * 1'000'000 / this->conditions.bandwidth);
+        this->link_free_at = std::max(now, this->link_free_at) + wire_time;
+        sent = this->link_free_at;
+    }
+
+    auto delay = this->conditions.latency;
+    if (this->conditions.jitter.count() > 0) {
+        std::uniform_int_distribution<int64_t> jitter(-this->conditions.jitter.count(), this->conditions.jitter.count());
+        delay = std::max(delay + std::chrono::microseconds(jitter(this->rng)), std::chrono::microseconds(0));
+    }
+
+    if (this->conditions.loss > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(this->rng) < this->conditions.loss) {
+        this->stats.sends_lost++;
+        if (!this->reliable) {
+            return std::nullopt;
+        }
+        delay += this->conditions.retransmit_timeout;
+    }
+
+    Clock::time_point arrival = sent + delay;
+    if (this->reliable) {
+        arrival = std::max(arrival, this->last_arrival);
+        this->last_arrival = arrival;
+    }
+
+    return arrival;
+}
+
+const LinkConditions& DelayLine::getConditions() const {
+    return this->conditions;
+}
+
+const LinkStats& DelayLine::getStats() const {
+    return this->stats;
+}
@@ -0,0 +1,58 @@
+#include "shared/netsim/netharness.hpp"
+
+#include <iostream>
+
+NetHarness::NetHarness() {
+}
+
+boost::asio::io_context& NetHarness::getContext() {
+    return this->context;
+}
+
+SessionPair NetHarness::connectSessions(const LinkConditions& to_server, const LinkConditions& to_client) {
+    tcp::acceptor acceptor(this->context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+    auto link = std::make_shared<SimulatedLink>(this->context, acceptor.local_endpoint(), to_server, to_client);
+    link->start();
+
+    tcp::socket client_socket(this->context);
+    client_socket.connect(link->getEndpoint());
+    client_socket.set_option(tcp::no_delay(true));
+
+    // the link only connects onwards once it gets to run
+    if (!this->pollUntil([&link]() { return link->isConnected(); })) {
+        std::cerr << "NetHarness: link never connected" << std::endl;
+    }
+
+    tcp::socket server_socket(this->context);
+    acceptor.accept(server_socket);
+    server_socket.set_option(tcp::no_delay(true));
+
+    return SessionPair {
+        .client = std::make_shared<Session>(std::move(client_socket), SessionInfo({}, {}, {})),
+        .server = std::make_shared<Session>(std::move(server_socket), SessionInfo({}, {}, {})),
+        .link = link
+    };
+}
+
+std::shared_ptr<ScriptedClient> NetHarness::addClient(unsigned short server_port,
+    const LinkConditions& to_server, const LinkConditions& to_client) {
+    // 127.0.0.2, 127.0.0.3, ... are all loopback too, and let the Server tell clients apart
+    auto bind_address = boost::asio::ip::make_address_v4(
+        boost::asio::ip::address_v4::loopback().to_uint() + 1 + this->clients.size());
+
+    auto client = std::make_shared<ScriptedClient>(this->context,
+        tcp::endpoint(boost::asio::ip::address_v4::loopback(), server_port),
+        to_server, to_client, bind_address);
+    this->clients.push_back(client);
+    return client;
+}
+
+void NetHarness::pollFor(std::chrono::microseconds duration) {
+    this->context.restart();
+    this->context.run_for(duration);
+
+    for (auto& client : this->clients) {
+        client->poll();
+    }
+}
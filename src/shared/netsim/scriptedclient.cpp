@@ -0,0 +1,146 @@
+#include "shared/netsim/scriptedclient.hpp"
+
+#include <iostream>
+
+ScriptedClient::ScriptedClient(boost::asio::io_context& context, tcp::endpoint server,
+    LinkConditions to_server, LinkConditions to_client, boost::asio::ip::address bind_address):
+    context(context),
+    server(server),
+    to_server(to_server),
+    to_client(to_client),
+    bind_address(bind_address),
+    state(GamePhase::TITLE_SCREEN, GameConfig{})
+{
+    this->_connect();
+}
+
+void ScriptedClient::_connect() {
+    this->link = std::make_shared<SimulatedLink>(this->context, this->server,
+        this->to_server, this->to_client, this->bind_address);
+    this->link->start();
+
+    // The connection is established by the kernel straight away, even though the link
+    // only connects onwards to the Server once the io_context runs
+    tcp::socket socket(this->context);
+    boost::system::error_code ec;
+    socket.connect(this->link->getEndpoint(), ec);
+    if (ec) {
+        std::cerr << "ScriptedClient: error connecting to link: " << ec.message() << std::endl;
+    }
+    socket.set_option(tcp::no_delay(true), ec);
+
+    this->session = std::make_shared<Session>(std::move(socket), SessionInfo({}, {}, {}));
+}
+
+void ScriptedClient::poll() {
+    std::vector<Event> events = this->session->handleAllReceivedPackets();
+    this->_pollSnapshotChannel(events);
+
+    for (const auto& event : events) {
+        if (event.type != EventType::LoadGameState) {
+            continue;
+        }
+
+        const SharedGameState& update = std::get<LoadGameStateEvent>(event.data).state;
+        if (update.resync_id != 0) {
+            if (this->resync_receiver.accept(update)) {
+                this->state = this->resync_receiver.take();
+                this->last_resync_time = DelayLine::Clock::now();
+            }
+            continue;
+        }
+
+        if (!this->snapshot_receiver.accept(update)) {
+            continue;
+        }
+
+        this->state.update(update);
+        this->arrivals.push_back(SnapshotArrival {
+            .timestep = update.timestep,
+            .time = DelayLine::Clock::now()
+        });
+    }
+
+    uint32_t snapshot_to_ack = this->snapshot_receiver.takeAck();
+    if (snapshot_to_ack != 0) {
+        auto eid = this->session->getInfo().client_eid.value_or(0);
+        this->session->addInput(Event(eid, EventType::AckSnapshot, AckSnapshotEvent(snapshot_to_ack)));
+    }
+
+    this->session->sendInputFrame();
+}
+
+void ScriptedClient::reconnect() {
+    this->link->close();
+
+    // the Server will tell the new session its UDP port again
+    this->datagram_link = nullptr;
+    this->snapshot_channel = nullptr;
+
+    this->_connect();
+}
+
+void ScriptedClient::addInput(const Event& event) {
+    this->session->addInput(event);
+}
+
+std::optional<EntityID> ScriptedClient::getEID() const {
+    return this->session->getInfo().client_eid;
+}
+
+const SharedGameState& ScriptedClient::getState() const {
+    return this->state;
+}
+
+const std::vector<SnapshotArrival>& ScriptedClient::getArrivals() const {
+    return this->arrivals;
+}
+
+std::optional<DelayLine::Clock::time_point> ScriptedClient::getLastResyncTime() const {
+    return this->last_resync_time;
+}
+
+std::size_t ScriptedClient::getBytesReceived() const {
+    std::size_t bytes = this->link->getStats(LinkDirection::FromTarget).bytes_sent;
+    if (this->datagram_link != nullptr) {
+        bytes += this->datagram_link->getStats(LinkDirection::FromTarget).bytes_sent;
+    }
+    return bytes;
+}
+
+std::shared_ptr<Session> ScriptedClient::getSession() const {
+    return this->session;
+}
+
+std::shared_ptr<SimulatedLink> ScriptedClient::getLink() const {
+    return this->link;
+}
+
+void ScriptedClient::_pollSnapshotChannel(std::vector<Event>& events) {
+    const SessionInfo& info = this->session->getInfo();
+    if (!info.client_eid.has_value() || !info.snapshot_port.has_value()) {
+        return;
+    }
+
+    if (this->snapshot_channel == nullptr) {
+        // snapshots go through a link of their own, from the same address as the session
+        // so that the Server recognizes them as ours
+        this->datagram_link = std::make_shared<SimulatedDatagramLink>(this->context,
+            udp::endpoint(this->server.address(), info.snapshot_port.value()),
+            this->to_server, this->to_client, this->bind_address);
+        this->datagram_link->start();
+
+        this->snapshot_channel = std::make_shared<SnapshotChannel>(
+            udp::socket(this->context, udp::endpoint(boost::asio::ip::address_v4::loopback(), 0)));
+        this->snapshot_channel->connectTo(this->datagram_link->getEndpoint(), info.client_eid.value());
+        this->snapshot_channel->listen();
+    }
+
+    if (!this->snapshot_channel->isEstablished()) {
+        this->snapshot_channel->sendHello();
+    }
+
+    for (auto& event : this->snapshot_channel->takeReceivedEvents()) {
+        events.push_back(std::move(event));
+    }
+}
@@ -0,0 +1,230 @@
+#include "shared/netsim/simulatedlink.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/write.hpp>
+
+#include <iostream>
+
+SimulatedLink::Pipe::Pipe(boost::asio::io_context& context, tcp::socket& from, tcp::socket& to,
+    LinkConditions conditions):
+    from(from),
+    to(to),
+    line(conditions, true),
+    queue_bytes(0),
+    timer(context),
+    reading(false),
+    writing(false)
+{
+}
+
+SimulatedLink::SimulatedLink(boost::asio::io_context& context, tcp::endpoint target,
+    LinkConditions to_target, LinkConditions from_target, boost::asio::ip::address bind_address):
+    acceptor(context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+    target(target),
+    bind_address(bind_address),
+    near_socket(context),
+    far_socket(context),
+    connected(false),
+    to_target(context, near_socket, far_socket, to_target),
+    from_target(context, far_socket, near_socket, from_target)
+{
+}
+
+void SimulatedLink::start() {
+    auto self(shared_from_this());
+    this->acceptor.async_accept(this->near_socket, [this, self](boost::system::error_code ec) {
+        if (ec) {
+            std::cerr << "SimulatedLink: error accepting connection: " << ec.message() << std::endl;
+            return;
+        }
+        this->acceptor.close();
+        this->near_socket.set_option(tcp::no_delay(true));
+
+        boost::system::error_code bind_ec;
+        this->far_socket.open(this->target.protocol());
+        this->far_socket.bind(tcp::endpoint(this->bind_address, 0), bind_ec);
+        if (bind_ec) {
+            std::cerr << "SimulatedLink: could not bind to " << this->bind_address
+                << ": " << bind_ec.message() << std::endl;
+        }
+
+        this->far_socket.async_connect(this->target, [this, self](boost::system::error_code ec) {
+            if (ec) {
+                std::cerr << "SimulatedLink: error connecting to target: " << ec.message() << std::endl;
+                this->close();
+                return;
+            }
+            this->far_socket.set_option(tcp::no_delay(true));
+
+            this->connected = true;
+            this->_doRead(this->to_target);
+            this->_doRead(this->from_target);
+        });
+    });
+}
+
+tcp::endpoint SimulatedLink::getEndpoint() const {
+    return this->acceptor.local_endpoint();
+}
+
+bool SimulatedLink::isConnected() const {
+    return this->connected;
+}
+
+void SimulatedLink::close() {
+    this->connected = false;
+
+    // errors don't matter here, since the link is going away anyway
+    boost::system::error_code ec;
+    this->acceptor.close(ec);
+    this->near_socket.shutdown(tcp::socket::shutdown_both, ec);
+    this->near_socket.close(ec);
+    this->far_socket.shutdown(tcp::socket::shutdown_both, ec);
+    this->far_socket.close(ec);
+    this->to_target.timer.cancel();
+    this->from_target.timer.cancel();
+}
+
+const LinkStats& SimulatedLink::getStats(LinkDirection direction) const {
+    return direction == LinkDirection::ToTarget ? this->to_target.line.getStats() : this->from_target.line.getStats();
+}
+
+std::size_t SimulatedLink::getBytesInFlight(LinkDirection direction) const {
+    return direction == LinkDirection::ToTarget ? this->to_target.queue_bytes : this->from_target.queue_bytes;
+}
+
+void SimulatedLink::_doRead(Pipe& pipe) {
+    if (!this->connected || pipe.reading || pipe.queue_bytes >= pipe.line.getConditions().window_bytes) {
+        return;
+    }
+
+    pipe.reading = true;
+    auto self(shared_from_this());
+    pipe.from.async_read_some(boost::asio::buffer(pipe.buffer),
+        [this, self, &pipe](boost::system::error_code ec, std::size_t length) {
+            pipe.reading = false;
+            if (ec) {
+                // either end going away takes the whole link down, like a real connection
+                this->close();
+                return;
+            }
+
+            auto arrival = pipe.line.schedule(length, DelayLine::Clock::now());
+            pipe.queue.push_back(Chunk {
+                .arrival = arrival.value(),
+                .bytes = std::vector<char>(pipe.buffer.begin(), pipe.buffer.begin() + length)
+            });
+            pipe.queue_bytes += length;
+
+            this->_doWrite(pipe);
+            this->_doRead(pipe);
+        });
+}
+
+void SimulatedLink::_doWrite(Pipe& pipe) {
+    if (!this->connected || pipe.writing || pipe.queue.empty()) {
+        return;
+    }
+
+    pipe.writing = true;
+    auto self(shared_from_this());
+    pipe.timer.expires_at(pipe.queue.front().arrival);
+    pipe.timer.async_wait([this, self, &pipe](boost::system::error_code ec) {
+        if (ec) {
+            pipe.writing = false;
+            return;
+        }
+
+        boost::asio::async_write(pipe.to, boost::asio::buffer(pipe.queue.front().bytes),
+            [this, self, &pipe](boost::system::error_code ec, std::size_t length) {
+                pipe.writing = false;
+                if (ec) {
+                    this->close();
+                    return;
+                }
+
+                pipe.queue_bytes -= length;
+                pipe.queue.pop_front();
+
+                this->_doWrite(pipe);
+                // there might be room in the window again
+                this->_doRead(pipe);
+            });
+    });
+}
+
+SimulatedDatagramLink::SimulatedDatagramLink(boost::asio::io_context& context, udp::endpoint target,
+    LinkConditions to_target, LinkConditions from_target, boost::asio::ip::address bind_address):
+    near_socket(context, udp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+    far_socket(context, udp::endpoint(bind_address, 0)),
+    target(target),
+    to_target(to_target, false),
+    from_target(from_target, false)
+{
+}
+
+void SimulatedDatagramLink::start() {
+    this->_doReceive(LinkDirection::ToTarget);
+    this->_doReceive(LinkDirection::FromTarget);
+}
+
+udp::endpoint SimulatedDatagramLink::getEndpoint() const {
+    return this->near_socket.local_endpoint();
+}
+
+const LinkStats& SimulatedDatagramLink::getStats(LinkDirection direction) const {
+    return direction == LinkDirection::ToTarget ? this->to_target.getStats() : this->from_target.getStats();
+}
+
+void SimulatedDatagramLink::_doReceive(LinkDirection direction) {
+    bool outgoing = direction == LinkDirection::ToTarget;
+    udp::socket& socket = outgoing ? this->near_socket : this->far_socket;
+    auto& buffer = outgoing ? this->near_buffer : this->far_buffer;
+    udp::endpoint& from = outgoing ? this->near_from : this->far_from;
+
+    auto self(shared_from_this());
+    socket.async_receive_from(boost::asio::buffer(buffer), from,
+        [this, self, direction](boost::system::error_code ec, std::size_t length) {
+            if (ec == boost::asio::error::operation_aborted) {
+                return;
+            }
+
+            if (!ec) {
+                if (direction == LinkDirection::ToTarget) {
+                    this->sender = this->near_from;
+                    this->_forward(direction, length);
+                } else if (this->far_from == this->target && this->sender.has_value()) {
+                    this->_forward(direction, length);
+                }
+            }
+
+            // a failed receive on UDP is only ever about that one datagram
+            this->_doReceive(direction);
+        });
+}
+
+void SimulatedDatagramLink::_forward(LinkDirection direction, std::size_t bytes) {
+    bool outgoing = direction == LinkDirection::ToTarget;
+    DelayLine& line = outgoing ? this->to_target : this->from_target;
+
+    auto arrival = line.schedule(bytes, DelayLine::Clock::now());
+    if (!arrival.has_value()) {
+        return;
+    }
+
+    const auto& buffer = outgoing ? this->near_buffer : this->far_buffer;
+    auto datagram = std::make_shared<std::vector<char>>(buffer.begin(), buffer.begin() + bytes);
+    auto timer = std::make_shared<boost::asio::steady_timer>(this->near_socket.get_executor(), arrival.value());
+    udp::endpoint to = outgoing ? this->target : this->sender.value();
+
+    auto self(shared_from_this());
+    timer->async_wait([this, self, outgoing, datagram, timer, to](boost::system::error_code ec) {
+        if (ec) {
+            return;
+        }
+
+        udp::socket& socket = outgoing ? this->far_socket : this->near_socket;
+        boost::system::error_code send_ec;
+        socket.send_to(boost::asio::buffer(*datagram), to, 0, send_ec);
+    });
+}
@@ -0,0 +1,82 @@
+#include "shared/network/packetizer.hpp"
+
+#include <optional>
+
+#include "shared/game/event.hpp"
+#include "shared/utilities/serialize.hpp"
+
+/**
+ * @returns Size in bytes of a packet holding the given chunk with no objects in it
+ */
+static std::size_t emptyChunkSize(EntityID evt_source, const SharedGameState& chunk) {
+    SerializedSizeCounter counter;
+    return sizeof(PacketHeader) + counter.add(EventPacket(Event(evt_source,
+        EventType::LoadGameState, LoadGameStateEvent(chunk))));
+}
+
+std::vector<SharedGameState> splitSnapshot(EntityID evt_source,
+    const SharedGameState& snapshot, std::size_t max_packet_bytes) {
+    // Template for every chunk, with everything but the objects
+    SharedGameState chunk_template = snapshot;
+    chunk_template.objects.clear();
+    chunk_template.object_deltas.clear();
+
+    chunk_template.chunk_index = 0;
+    const std::size_t first_chunk_overhead = emptyChunkSize(evt_source, chunk_template);
+    chunk_template.chunk_index = 1;
+    const std::size_t other_chunk_overhead = emptyChunkSize(evt_source, chunk_template);
+
+    std::vector<SharedGameState> chunks;
+    chunks.push_back(chunk_template);
+
+    // Each chunk is serialized into its own archive, so entries are measured with a
+    // counter that only ever sees the entries of the current chunk
+    std::optional<SerializedSizeCounter> counter;
+    counter.emplace();
+    std::size_t chunk_bytes = first_chunk_overhead;
+    std::size_t chunk_entries = 0;
+
+    auto fitEntry = [&](const auto& entry) {
+        std::size_t entry_bytes = counter->add(entry);
+
+        if (chunk_entries > 0 && chunk_bytes + entry_bytes > max_packet_bytes) {
+            chunks.push_back(chunk_template);
+            counter.emplace();
+            chunk_bytes = other_chunk_overhead;
+            chunk_entries = 0;
+            entry_bytes = counter->add(entry);
+        }
+
+        chunk_bytes += entry_bytes;
+        chunk_entries++;
+    };
+
+    // Objects are always written before deltas in a SharedGameState, so measure them
+    // in the same order
+    for (const auto& entry : snapshot.objects) {
+        fitEntry(entry);
+        chunks.back().objects.insert(entry);
+    }
+    for (const auto& entry : snapshot.object_deltas) {
+        fitEntry(entry);
+        chunks.back().object_deltas.insert(entry);
+    }
+
+    for (uint32_t i = 0; i < chunks.size(); i++) {
+        chunks[i].chunk_index = i;
+        chunks[i].num_chunks = chunks.size();
+    }
+
+    return chunks;
+}
+
+std::vector<std::shared_ptr<PackagedPacket>> packetizeSnapshot(EntityID evt_source,
+    const SharedGameState& snapshot, std::size_t max_packet_bytes) {
+    std::vector<std::shared_ptr<PackagedPacket>> packets;
+    for (const auto& chunk : splitSnapshot(evt_source, snapshot, max_packet_bytes)) {
+        packets.push_back(PackagedPacket::make_shared(PacketType::Event, EventPacket(Event(
+            evt_source, EventType::LoadGameState, LoadGameStateEvent(chunk)))));
+    }
+
+    return packets;
+}
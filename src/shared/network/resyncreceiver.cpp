@@ -0,0 +1,44 @@
+#include "shared/network/resyncreceiver.hpp"
+
+#include <utility>
+
+ResyncReceiver::ResyncReceiver():
+    resync_id(0),
+    chunks_missing(0)
+{
+}
+
+bool ResyncReceiver::accept(const SharedGameState& chunk) {
+    if (chunk.resync_id < this->resync_id) {
+        return false;
+    }
+
+    if (chunk.resync_id > this->resync_id) {
+        this->resync_id = chunk.resync_id;
+        this->state = SharedGameState();
+        this->chunks_received.assign(chunk.num_chunks, false);
+        this->chunks_missing = chunk.num_chunks;
+    }
+
+    if (chunk.chunk_index >= this->chunks_received.size() || this->chunks_received[chunk.chunk_index]) {
+        return false;
+    }
+
+    this->chunks_received[chunk.chunk_index] = true;
+    this->chunks_missing--;
+    this->state.update(chunk);
+
+    return this->chunks_missing == 0;
+}
+
+bool ResyncReceiver::isResyncing() const {
+    return this->chunks_missing > 0;
+}
+
+SharedGameState ResyncReceiver::take() {
+    SharedGameState resync = std::move(this->state);
+    this->state = SharedGameState();
+    this->chunks_received.clear();
+    this->chunks_missing = 0;
+    return resync;
+}
@@ -6,6 +6,11 @@
 #include <memory>
 #include <string>
 #include <mutex>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <exception>
 
 #include "shared/network/packet.hpp"
 
@@ -13,7 +18,14 @@ using namespace boost::asio::ip;
 
 Session::Session(tcp::socket socket, SessionInfo info):
     socket(std::move(socket)),
-    info(info)
+    reading(false),
+    recv_buffer(RECEIVE_BUFFER_INITIAL_SIZE),
+    recv_read_pos(0),
+    recv_write_pos(0),
+    writing(false),
+    send_queue_bytes(0),
+    info(info),
+    next_input_sequence(1)
 {
     this->okay = true;
 }
@@ -25,6 +37,23 @@ bool Session::isOkay() const {
     return this->okay;
 }
 
+boost::asio::ip::address Session::getRemoteAddress() const {
+    boost::system::error_code ec;
+    return this->socket.remote_endpoint(ec).address();
+}
+
+const NetworkTelemetry& Session::getTelemetry() const {
+    return this->telemetry;
+}
+
+NetworkTelemetry Session::takeTelemetry() {
+    NetworkTelemetry taken;
+    std::swap(taken, this->telemetry);
+    // whatever is still queued up carries on into the next lot
+    this->telemetry.max_send_queue_bytes = this->send_queue_bytes;
+    return taken;
+}
+
 const SessionInfo& Session::getInfo() const {
     return this->info;
 }
@@ -34,56 +63,119 @@ std::vector<Event> Session::handleAllReceivedPackets() {
         return {};
     }
 
+    // make sure we are listening for the next batch of packets
+    this->_doRead();
+
     std::vector<Event> events;
+    std::swap(events, this->received_events);
+    return events;
+}
 
-    while (true) {
-        if (!prev_hdr.has_value()) {
-            // we haven't already pulled in a header, see if there is a header waiting for us
-            if (!socketHasEnoughBytes(sizeof(PacketHeader))) {
-                return events;
-            }
+void Session::_doRead() {
+    if (this->reading || !this->isOkay()) {
+        return;
+    }
+
+    // Make enough room to take in everything that is already waiting on the socket,
+    // and the rest of any packet we've only received part of, in one read
+    std::size_t wanted = RECEIVE_BUFFER_MIN_READ;
 
-            boost::system::error_code ec;
-            boost::asio::read(this->socket, boost::asio::buffer(this->buffer), 
-                boost::asio::transfer_exactly(sizeof(PacketHeader)), ec);
-            switch (_classifySocketError(ec, "receiving header")) {
+    boost::system::error_code ec;
+    wanted = std::max(wanted, this->socket.available(ec));
+
+    // (_parseReceivedBytes has already turned down any header with a size over
+    // MAX_PACKET_BYTES)
+    std::size_t unparsed = this->recv_write_pos - this->recv_read_pos;
+    if (unparsed >= sizeof(PacketHeader)) {
+        PacketHeader hdr(static_cast<void*>(&this->recv_buffer[this->recv_read_pos]));
+        std::size_t packet_size = sizeof(PacketHeader) + hdr.size;
+        if (packet_size > unparsed) {
+            wanted = std::max(wanted, packet_size - unparsed);
+        }
+    }
+
+    this->_reserveReceiveSpace(wanted);
+
+    this->reading = true;
+
+    // capture a shared_ptr to ourselves so we outlive the outstanding read
+    auto self = shared_from_this();
+    this->socket.async_read_some(
+        boost::asio::buffer(this->recv_buffer.data() + this->recv_write_pos,
+                            this->recv_buffer.size() - this->recv_write_pos),
+        [this, self](boost::system::error_code ec, std::size_t bytes_read) {
+            this->reading = false;
+
+            switch (_classifySocketError(ec, "receiving data")) {
                 case SocketError::NONE: break;
-                case SocketError::FATAL: 
+                case SocketError::FATAL:
                     this->okay = false;
-                    return events;
+                    return;
             }
 
-            this->prev_hdr = PacketHeader(static_cast<void*>(&this->buffer[0]));
-        }
+            this->recv_write_pos += bytes_read;
+            this->_parseReceivedBytes();
 
-        // if (!socketHasEnoughBytes(this->prev_hdr->size)) {
-        //     std::cout << "dont have enough bytes for " << this->prev_hdr->size << "\n";
-        //     return events;
-        // }
+            this->_doRead();
+        });
+}
 
-        boost::system::error_code ec;
-        boost::asio::read(this->socket, boost::asio::buffer(this->buffer),
-            boost::asio::transfer_exactly(this->prev_hdr->size), ec);
-
-        switch (_classifySocketError(ec, "receiving data")) {
-            case SocketError::NONE: break;
-            case SocketError::FATAL:
-                this->okay = false;
-                std::cout << "setting ok to bad" << std::endl;
-                return events;
+void Session::_parseReceivedBytes() {
+    while (this->recv_write_pos - this->recv_read_pos >= sizeof(PacketHeader)) {
+        PacketHeader hdr(static_cast<void*>(&this->recv_buffer[this->recv_read_pos]));
+
+        if (hdr.size > MAX_PACKET_BYTES) {
+            // checked before any room is made for the rest of the packet
+            std::cerr << "Received header for a packet of " << hdr.size << " bytes, more than the "
+                << MAX_PACKET_BYTES << " allowed. Closing the session" << std::endl;
+            this->okay = false;
+            return;
         }
 
-        std::string data(this->buffer.begin(), this->buffer.begin() + this->prev_hdr->size);
-        auto event = _handleReceivedPacket(this->prev_hdr->type, data);
-        if (event.has_value()) {
-            events.push_back(event.value());
+        std::size_t data_start = this->recv_read_pos + sizeof(PacketHeader);
+        if (this->recv_write_pos - data_start < hdr.size) {
+            // rest of the packet hasn't arrived yet
+            break;
         }
 
-        this->prev_hdr = {};
+        // deserialize straight out of the receive buffer
+        std::span<const char> data(this->recv_buffer.data() + data_start, hdr.size);
+        this->_handleReceivedPacket(hdr.type, hdr.format, data);
+
+        this->recv_read_pos = data_start + hdr.size;
     }
 
-    // shouldnt get here but for safety
-    return events;
+    if (this->recv_read_pos == this->recv_write_pos) {
+        // everything has been parsed, so start over from the front of the buffer
+        this->recv_read_pos = 0;
+        this->recv_write_pos = 0;
+
+        // and give back memory from any big bursts
+        if (this->recv_buffer.size() > RECEIVE_BUFFER_SHRINK_SIZE) {
+            std::vector<char>(RECEIVE_BUFFER_INITIAL_SIZE).swap(this->recv_buffer);
+        }
+    }
+}
+
+void Session::_reserveReceiveSpace(std::size_t bytes) {
+    if (this->recv_buffer.size() - this->recv_write_pos >= bytes) {
+        return;
+    }
+
+    // move the unparsed bytes to the front to reuse the space of the parsed ones
+    std::size_t unparsed = this->recv_write_pos - this->recv_read_pos;
+    if (this->recv_read_pos > 0) {
+        std::memmove(this->recv_buffer.data(), this->recv_buffer.data() + this->recv_read_pos, unparsed);
+        this->recv_read_pos = 0;
+        this->recv_write_pos = unparsed;
+    }
+
+    if (this->recv_buffer.size() - this->recv_write_pos < bytes) {
+        // Whatever is unparsed is less than a whole packet, so even at its largest the
+        // buffer has room for the rest of it
+        std::size_t new_size = std::max(this->recv_buffer.size() * 2, this->recv_write_pos + bytes);
+        this->recv_buffer.resize(std::min<std::size_t>(new_size, RECEIVE_BUFFER_MAX_SIZE));
+    }
 }
 
 bool Session::connectTo(basic_resolver_results<class boost::asio::ip::tcp> endpoints) {
@@ -97,23 +189,57 @@ bool Session::connectTo(basic_resolver_results<class boost::asio::ip::tcp> endpo
     return true;
 }
 
-std::optional<Event> Session::_handleReceivedPacket(PacketType type, const std::string& data) {
-    // First figure out if packet is event or non-event
-    if (type == PacketType::Event) {
-        auto event = deserialize<EventPacket>(data).event;
-        return event;
-    } else if (type == PacketType::ServerAssignEID) {
-        this->info.client_eid = deserialize<ServerAssignEIDPacket>(data).eid;
-        this->info.is_dungeon_master = deserialize<ServerAssignEIDPacket>(data).is_dungeon_master;
-        std::cout << "Handling ServerAssignEID of " << *this->info.client_eid << "...\n";
-        std::cout << "Is Dungeon Master? " << (*this->info.is_dungeon_master ? "true" : "false") << "...\n";
-    } else if (type == PacketType::ClientDeclareInfo) {
-        this->info.client_name = deserialize<ClientDeclareInfoPacket>(data).player_name;
-        std::cout << "Handling ClientDeclareInfo from " << *this->info.client_name << "...\n";
-    } else {
-        std::cerr << "Unknown packet type received in Session::_addReceivedPacket " << (int) type << std::endl;
+void Session::_handleReceivedPacket(PacketType type, WireFormat format, std::span<const char> data) {
+    this->telemetry.recordReceived(type, sizeof(PacketHeader) + data.size());
+    auto deserialize_start = std::chrono::high_resolution_clock::now();
+
+    try {
+        // First figure out if packet is event or non-event
+        if (type == PacketType::Event) {
+            Event event = deserialize<EventPacket>(data, format).event;
+            this->telemetry.received_by_event[event.type].add(sizeof(PacketHeader) + data.size());
+            if (isKnownEventType(event.type)) {
+                this->received_events.push_back(std::move(event));
+            } else {
+                std::cerr << "Skipping event of unknown type " << static_cast<int>(event.type) << std::endl;
+            }
+        } else if (type == PacketType::InputFrame) {
+            auto packet = deserialize<InputFramePacket>(data, format);
+            for (const auto& event : packet.events) {
+                // the bytes are counted towards the InputFrame as a whole
+                this->telemetry.received_by_event[event.type].add(0);
+            }
+            if (this->last_input_frame.has_value() && packet.sequence <= this->last_input_frame->sequence) {
+                std::cerr << "Received InputFrame " << packet.sequence << " after InputFrame "
+                    << this->last_input_frame->sequence << std::endl;
+            }
+            this->last_input_frame = InputFrameInfo {
+                .sequence = packet.sequence,
+                .client_time_ms = packet.client_time_ms
+            };
+            std::move(packet.events.begin(), packet.events.end(), std::back_inserter(this->received_events));
+        } else if (type == PacketType::ServerAssignEID) {
+            auto packet = deserialize<ServerAssignEIDPacket>(data, format);
+            this->info.client_eid = packet.eid;
+            this->info.is_dungeon_master = packet.is_dungeon_master;
+            if (packet.snapshot_port != 0) {
+                this->info.snapshot_port = packet.snapshot_port;
+            }
+            std::cout << "Handling ServerAssignEID of " << *this->info.client_eid << "...\n";
+            std::cout << "Is Dungeon Master? " << (*this->info.is_dungeon_master ? "true" : "false") << "...\n";
+        } else if (type == PacketType::ClientDeclareInfo) {
+            this->info.client_name = deserialize<ClientDeclareInfoPacket>(data, format).player_name;
+            std::cout << "Handling ClientDeclareInfo from " << *this->info.client_name << "...\n";
+        } else {
+            std::cerr << "Unknown packet type received in Session::_addReceivedPacket " << (int) type << std::endl;
+        }
+    } catch (const std::exception& e) {
+        // a packet that can't be decoded is dropped rather than taking the session down with it
+        std::cerr << "Dropping packet of type " << static_cast<int>(type) << " that couldn't be decoded: "
+            << e.what() << std::endl;
     }
-    return {};
+
+    this->telemetry.deserialize_time += std::chrono::high_resolution_clock::now() - deserialize_start;
 }
 
 void Session::sendPacket(std::shared_ptr<PackagedPacket> packet) {
@@ -121,20 +247,100 @@ void Session::sendPacket(std::shared_ptr<PackagedPacket> packet) {
         return;
     }
 
-    boost::system::error_code ec;
-    boost::asio::write(this->socket, packet->toBuffer(), ec);
+    this->send_queue_bytes += packet->size();
+    this->send_queue.push_back(packet);
 
-    switch (_classifySocketError(ec, "sending packet")) {
-        case SocketError::NONE: break;
-        // not currently handling retry
-        case SocketError::FATAL: 
-            this->okay = false;
-            return;
+    this->telemetry.recordSent(*packet);
+    this->telemetry.max_send_queue_bytes = std::max(this->telemetry.max_send_queue_bytes, this->send_queue_bytes);
+
+    if (this->send_queue_bytes > SEND_QUEUE_MAX_BYTES) {
+        std::cerr << "Session send queue grew to " << this->send_queue_bytes
+            << " bytes, closing unresponsive session" << std::endl;
+        this->okay = false;
+        boost::system::error_code ec;
+        this->socket.close(ec);
+        return;
+    }
+
+    this->_doWrite();
+}
+
+void Session::_doWrite() {
+    if (this->writing || this->send_queue.empty() || !this->isOkay()) {
+        return;
     }
+
+    this->writing = true;
+
+    // capture the packet as well as ourselves, so the buffer stays alive for the write
+    auto self = shared_from_this();
+    auto packet = this->send_queue.front();
+    boost::asio::async_write(this->socket, packet->toBuffer(),
+        [this, self, packet](boost::system::error_code ec, std::size_t bytes_written) {
+            this->writing = false;
+
+            switch (_classifySocketError(ec, "sending packet")) {
+                case SocketError::NONE: break;
+                // not currently handling retry
+                case SocketError::FATAL:
+                    this->okay = false;
+                    return;
+            }
+
+            this->send_queue_bytes -= packet->size();
+            this->send_queue.pop_front();
+
+            this->_doWrite();
+        });
+}
+
+std::size_t Session::getSendQueueBytes() const {
+    return this->send_queue_bytes;
+}
+
+std::size_t Session::getReceiveBufferSize() const {
+    return this->recv_buffer.size();
+}
+
+bool Session::isBackedUp() const {
+    return this->send_queue_bytes >= SEND_QUEUE_HIGH_WATER_MARK;
 }
 
 void Session::sendEvent(Event event) {
-    this->sendPacket(PackagedPacket::make_shared(PacketType::Event, EventPacket(event)));
+    auto packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(event));
+    this->telemetry.serialize_time += packet->getSerializeTime();
+    this->sendPacket(packet);
+}
+
+void Session::addInput(Event evt) {
+    this->input_frame_events.push_back(std::move(evt));
+}
+
+void Session::sendInputFrame() {
+    if (this->input_frame_events.empty()) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    InputFramePacket packet {
+        .sequence = this->next_input_sequence++,
+        .client_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count(),
+        .events = {}
+    };
+    std::swap(packet.events, this->input_frame_events);
+
+    auto packaged = PackagedPacket::make_shared(PacketType::InputFrame, packet);
+    this->telemetry.serialize_time += packaged->getSerializeTime();
+    this->sendPacket(packaged);
+}
+
+uint32_t Session::getLastSentInputSequence() const {
+    return this->next_input_sequence - 1;
+}
+
+const std::optional<InputFrameInfo>& Session::getLastInputFrame() const {
+    return this->last_input_frame;
 }
 
 SocketError Session::_classifySocketError(boost::system::error_code ec, const char* where) {
@@ -159,14 +365,6 @@ SocketError Session::_classifySocketError(boost::system::error_code ec, const ch
     // }
 }
 
-bool Session::socketHasEnoughBytes(std::size_t bytes) {
-    boost::asio::socket_base::bytes_readable command(true);
-    socket.io_control(command);
-    std::size_t bytes_readable = command.get();
-
-    return bytes_readable >= bytes;
-}
-
 void Session::setDM(bool is_dm) {
     this->info.is_dungeon_master = is_dm;
 }
\ No newline at end of file
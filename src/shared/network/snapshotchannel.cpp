@@ -0,0 +1,206 @@
+#include "shared/network/snapshotchannel.hpp"
+
+#include <exception>
+#include <iostream>
+#include <span>
+#include <utility>
+
+#include "shared/utilities/serialize.hpp"
+
+SnapshotChannel::SnapshotChannel(udp::socket socket):
+    socket(std::move(socket)),
+    receiving(false),
+    eid(0),
+    next_hello_sequence(1),
+    newest_sequence(0)
+{
+}
+
+SnapshotChannel::~SnapshotChannel() {
+}
+
+void SnapshotChannel::listen() {
+    this->_doReceive();
+}
+
+unsigned short SnapshotChannel::getPort() const {
+    boost::system::error_code ec;
+    return this->socket.local_endpoint(ec).port();
+}
+
+void SnapshotChannel::connectTo(udp::endpoint server, EntityID eid) {
+    this->server = server;
+    this->eid = eid;
+    this->newest_sequence = 0;
+}
+
+void SnapshotChannel::sendHello() {
+    if (!this->server.has_value()) {
+        return;
+    }
+
+    this->_send(this->server.value(),
+        DatagramHeader(DatagramType::Hello, this->next_hello_sequence++, this->eid), nullptr);
+}
+
+bool SnapshotChannel::isEstablished() const {
+    return this->newest_sequence != 0;
+}
+
+bool SnapshotChannel::hasPeer(EntityID eid, const boost::asio::ip::address& addr) const {
+    auto peer = this->peers.find(eid);
+    return peer != this->peers.end() && peer->second.endpoint.address() == addr;
+}
+
+void SnapshotChannel::removePeer(EntityID eid) {
+    this->peers.erase(eid);
+}
+
+bool SnapshotChannel::sendSnapshot(EntityID eid, std::shared_ptr<PackagedPacket> packet) {
+    auto peer = this->peers.find(eid);
+    if (peer == this->peers.end() || sizeof(DatagramHeader) + packet->size() > MAX_DATAGRAM_BYTES) {
+        return false;
+    }
+
+    this->_send(peer->second.endpoint,
+        DatagramHeader(DatagramType::Snapshot, peer->second.next_sequence++, eid), packet);
+    return true;
+}
+
+std::vector<Event> SnapshotChannel::takeReceivedEvents() {
+    // make sure we are listening for the next batch of datagrams
+    this->_doReceive();
+
+    std::vector<Event> events;
+    std::swap(events, this->received_events);
+    return events;
+}
+
+void SnapshotChannel::setLossShim(std::function<bool(DatagramType, uint32_t)> should_drop) {
+    this->loss_shim = std::move(should_drop);
+}
+
+const SnapshotChannelStats& SnapshotChannel::getStats() const {
+    return this->stats;
+}
+
+void SnapshotChannel::_doReceive() {
+    if (this->receiving || !this->socket.is_open()) {
+        return;
+    }
+
+    this->receiving = true;
+
+    // capture a shared_ptr to ourselves so we outlive the outstanding receive
+    auto self = shared_from_this();
+    this->socket.async_receive_from(boost::asio::buffer(this->recv_buffer), this->recv_endpoint,
+        [this, self](boost::system::error_code ec, std::size_t bytes_read) {
+            this->receiving = false;
+
+            if (ec == boost::asio::error::operation_aborted) {
+                return;
+            }
+
+            // Errors on a UDP socket (e.g. ICMP port unreachable from a client that went
+            // away) only concern a single datagram, so just move on to the next one
+            if (!ec) {
+                this->_handleDatagram(bytes_read);
+            }
+
+            this->_doReceive();
+        });
+}
+
+void SnapshotChannel::_handleDatagram(std::size_t bytes) {
+    if (bytes < sizeof(DatagramHeader)) {
+        return;
+    }
+
+    DatagramHeader hdr(static_cast<const void*>(this->recv_buffer.data()));
+
+    if (hdr.type == DatagramType::Hello) {
+        auto peer = this->peers.find(hdr.eid);
+        if (peer == this->peers.end()) {
+            this->peers.insert({hdr.eid, Peer { .endpoint = this->recv_endpoint, .next_sequence = 1 }});
+        } else if (peer->second.endpoint != this->recv_endpoint) {
+            peer->second.endpoint = this->recv_endpoint;
+        }
+        return;
+    }
+
+    if (hdr.type != DatagramType::Snapshot || !this->server.has_value() ||
+        this->recv_endpoint != this->server.value()) {
+        return;
+    }
+
+    // Anything older than what we've already passed on is out of date
+    if (hdr.sequence <= this->newest_sequence) {
+        this->stats.datagrams_stale++;
+        return;
+    }
+
+    std::size_t offset = sizeof(DatagramHeader);
+    if (bytes < offset + sizeof(PacketHeader)) {
+        this->stats.datagrams_malformed++;
+        return;
+    }
+
+    PacketHeader packet_hdr(static_cast<void*>(this->recv_buffer.data() + offset));
+    offset += sizeof(PacketHeader);
+    if (packet_hdr.type != PacketType::Event || bytes - offset < packet_hdr.size) {
+        std::cerr << "Malformed snapshot datagram " << hdr.sequence << std::endl;
+        this->stats.datagrams_malformed++;
+        return;
+    }
+
+    // Source addresses of datagrams can be spoofed, so anything could be in here
+    std::span<const char> data(this->recv_buffer.data() + offset, packet_hdr.size);
+    Event event;
+    try {
+        event = deserialize<EventPacket>(data, packet_hdr.format).event;
+    } catch (const std::exception& e) {
+        std::cerr << "Dropping snapshot datagram " << hdr.sequence << " that couldn't be decoded: "
+            << e.what() << std::endl;
+        this->stats.datagrams_malformed++;
+        return;
+    }
+
+    // only datagrams that could be decoded move the sequence on, so that a bad one
+    // can't make the real ones look stale
+    if (this->newest_sequence != 0) {
+        this->stats.datagrams_missing += hdr.sequence - this->newest_sequence - 1;
+    }
+    this->newest_sequence = hdr.sequence;
+
+    this->received_events.push_back(std::move(event));
+    this->stats.datagrams_received++;
+}
+
+void SnapshotChannel::_send(const udp::endpoint& to, DatagramHeader hdr,
+    std::shared_ptr<PackagedPacket> packet) {
+    if (this->loss_shim && this->loss_shim(hdr.type, hdr.sequence)) {
+        this->stats.datagrams_dropped++;
+        return;
+    }
+
+    auto net_hdr = std::make_shared<DatagramHeader>(hdr);
+    net_hdr->to_network();
+
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.push_back(boost::asio::buffer(net_hdr.get(), sizeof(DatagramHeader)));
+    if (packet != nullptr) {
+        auto packet_buffers = packet->toBuffer();
+        buffers.insert(buffers.end(), packet_buffers.begin(), packet_buffers.end());
+    }
+
+    this->stats.datagrams_sent++;
+
+    // the header and packet have to stay alive until the send is done
+    auto self = shared_from_this();
+    this->socket.async_send_to(buffers, to,
+        [self, net_hdr, packet](boost::system::error_code ec, std::size_t /*bytes_sent*/) {
+            if (ec && ec != boost::asio::error::operation_aborted) {
+                std::cerr << "Error sending snapshot datagram: " << ec.message() << std::endl;
+            }
+        });
+}
@@ -0,0 +1,46 @@
+#include "shared/network/snapshotreceiver.hpp"
+
+SnapshotReceiver::SnapshotReceiver():
+    newest_id(0),
+    chunks_missing(0),
+    complete_id(0),
+    acked_id(0)
+{
+}
+
+bool SnapshotReceiver::accept(const SharedGameState& chunk) {
+    // untracked state, e.g. the full state sent on connection, always applies
+    if (chunk.snapshot_id == 0) {
+        return true;
+    }
+
+    if (chunk.snapshot_id < this->newest_id) {
+        return false;
+    }
+
+    if (chunk.snapshot_id > this->newest_id) {
+        this->newest_id = chunk.snapshot_id;
+        this->chunks_received.assign(chunk.num_chunks, false);
+        this->chunks_missing = chunk.num_chunks;
+    }
+
+    if (chunk.chunk_index < this->chunks_received.size() && !this->chunks_received[chunk.chunk_index]) {
+        this->chunks_received[chunk.chunk_index] = true;
+        this->chunks_missing--;
+
+        if (this->chunks_missing == 0) {
+            this->complete_id = this->newest_id;
+        }
+    }
+
+    return true;
+}
+
+uint32_t SnapshotReceiver::takeAck() {
+    if (this->complete_id <= this->acked_id) {
+        return 0;
+    }
+
+    this->acked_id = this->complete_id;
+    return this->acked_id;
+}
@@ -0,0 +1,118 @@
+#include "shared/network/telemetry.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+void TrafficCounter::add(std::size_t bytes) {
+    this->count++;
+    this->bytes += bytes;
+}
+
+void TrafficCounter::merge(const TrafficCounter& other) {
+    this->count += other.count;
+    this->bytes += other.bytes;
+}
+
+void NetworkTelemetry::recordSent(const PackagedPacket& packet) {
+    this->sent_by_packet[packet.getType()].add(packet.size());
+    if (packet.getEventType().has_value()) {
+        this->sent_by_event[packet.getEventType().value()].add(packet.size());
+    }
+    this->largest_packet_sent = std::max(this->largest_packet_sent, packet.size());
+}
+
+void NetworkTelemetry::recordReceived(PacketType type, std::size_t bytes) {
+    this->received_by_packet[type].add(bytes);
+    this->largest_packet_received = std::max(this->largest_packet_received, bytes);
+}
+
+/**
+ * Adds every counter in from to the matching counter in to
+ */
+template <typename Key>
+static void mergeCounters(std::map<Key, TrafficCounter>& to, const std::map<Key, TrafficCounter>& from) {
+    for (const auto& [key, counter] : from) {
+        to[key].merge(counter);
+    }
+}
+
+void NetworkTelemetry::merge(const NetworkTelemetry& other) {
+    mergeCounters(this->sent_by_packet, other.sent_by_packet);
+    mergeCounters(this->received_by_packet, other.received_by_packet);
+    mergeCounters(this->sent_by_event, other.sent_by_event);
+    mergeCounters(this->received_by_event, other.received_by_event);
+    this->serialize_time += other.serialize_time;
+    this->deserialize_time += other.deserialize_time;
+    this->max_send_queue_bytes = std::max(this->max_send_queue_bytes, other.max_send_queue_bytes);
+    this->largest_packet_sent = std::max(this->largest_packet_sent, other.largest_packet_sent);
+    this->largest_packet_received = std::max(this->largest_packet_received, other.largest_packet_received);
+}
+
+std::size_t NetworkTelemetry::totalBytesSent() const {
+    std::size_t bytes = 0;
+    for (const auto& [_type, counter] : this->sent_by_packet) { // cppcheck-suppress unusedVariable
+        bytes += counter.bytes;
+    }
+    return bytes;
+}
+
+std::size_t NetworkTelemetry::totalBytesReceived() const {
+    std::size_t bytes = 0;
+    for (const auto& [_type, counter] : this->received_by_packet) { // cppcheck-suppress unusedVariable
+        bytes += counter.bytes;
+    }
+    return bytes;
+}
+
+/**
+ * @returns The counters as a JSON object, keyed by the name of each type
+ */
+template <typename Key>
+static nlohmann::json countersToJson(const std::map<Key, TrafficCounter>& counters) {
+    nlohmann::json json = nlohmann::json::object();
+    for (const auto& [key, counter] : counters) {
+        std::ostringstream name;
+        name << key;
+        json[name.str()] = {{"count", counter.count}, {"bytes", counter.bytes}};
+    }
+    return json;
+}
+
+nlohmann::json NetworkTelemetry::toJson() const {
+    auto ms = [](std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::milli>(time).count();
+    };
+
+    return {
+        {"bytes_sent", this->totalBytesSent()},
+        {"bytes_received", this->totalBytesReceived()},
+        {"sent_by_packet", countersToJson(this->sent_by_packet)},
+        {"received_by_packet", countersToJson(this->received_by_packet)},
+        {"sent_by_event", countersToJson(this->sent_by_event)},
+        {"received_by_event", countersToJson(this->received_by_event)},
+        {"serialize_ms", ms(this->serialize_time)},
+        {"deserialize_ms", ms(this->deserialize_time)},
+        {"max_send_queue_bytes", this->max_send_queue_bytes},
+        {"largest_packet_sent", this->largest_packet_sent},
+        {"largest_packet_received", this->largest_packet_received}
+    };
+}
+
+#define TO_STR(type) \
+    case PacketType::type: \
+        os << #type; \
+        break
+
+std::ostream& operator<<(std::ostream& os, const PacketType& type) {
+    switch (type) {
+        TO_STR(ServerLobbyBroadcast);
+        TO_STR(ClientDeclareInfo);
+        TO_STR(ServerAssignEID);
+        TO_STR(Event);
+        TO_STR(InputFrame);
+        default:
+            os << "Unknown(" << static_cast<int>(type) << ")";
+    }
+
+    return os;
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "shared/utilities/entityset.hpp"
+
+TEST(EntitySetTest, InsertsOnce) {
+    EntitySet set;
+    EXPECT_TRUE(set.empty());
+
+    EXPECT_TRUE(set.insert(3));
+    EXPECT_FALSE(set.insert(3));
+    EXPECT_TRUE(set.insert(200));
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_TRUE(set.contains(200));
+    EXPECT_FALSE(set.contains(4));
+    EXPECT_FALSE(set.contains(100000));
+
+    EXPECT_TRUE(set.erase(3));
+    EXPECT_FALSE(set.erase(3));
+    EXPECT_FALSE(set.erase(100000));
+    EXPECT_EQ(set.size(), 1);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(200));
+}
+
+TEST(EntitySetTest, IteratesInOrder) {
+    EntitySet set;
+    // across several words, with a whole empty word in between
+    std::vector<EntityID> ids = {0, 1, 63, 64, 190, 191, 300};
+    for (auto it = ids.rbegin(); it != ids.rend(); it++) {
+        set.insert(*it);
+    }
+
+    std::vector<EntityID> visited;
+    for (EntityID id : set) {
+        visited.push_back(id);
+    }
+    EXPECT_EQ(visited, ids);
+
+    set.clear();
+    EXPECT_FALSE(set.begin() != set.end());
+    EntitySet empty;
+    EXPECT_FALSE(empty.begin() != empty.end());
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <unordered_set>
+
+#include "shared/utilities/keyset.hpp"
+
+TEST(KeySetTest, InsertsOnce) {
+    KeySet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(0));
+
+    EXPECT_TRUE(set.insert(0));
+    EXPECT_FALSE(set.insert(0));
+    EXPECT_TRUE(set.insert((uint64_t(3) << 32) | 7));
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.contains(0));
+    EXPECT_TRUE(set.contains((uint64_t(3) << 32) | 7));
+    EXPECT_FALSE(set.contains((uint64_t(7) << 32) | 3));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(0));
+    EXPECT_TRUE(set.insert(0));
+}
+
+TEST(KeySetTest, MatchesUnorderedSetWhileGrowing) {
+    KeySet set;
+    std::unordered_set<uint64_t> expected;
+
+    // pairs of EntityIDs, like collision pairs, with plenty of repeats
+    for (uint64_t a = 0; a < 60; a++) {
+        for (uint64_t b = a; b < a + 40; b += 3) {
+            uint64_t key = (a / 2 << 32) | b;
+            EXPECT_EQ(set.insert(key), expected.insert(key).second);
+        }
+    }
+
+    EXPECT_EQ(set.size(), expected.size());
+    for (uint64_t key : expected) {
+        EXPECT_TRUE(set.contains(key));
+    }
+    EXPECT_FALSE(set.contains(uint64_t(1000) << 32));
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "shared/game/movement.hpp"
+#include "shared/game/movementpredictor.hpp"
+
+static const EntityID PLAYER_EID = 1;
+
+static SharedPhysics playerPhysics(glm::vec3 corner) {
+	return SharedPhysics {
+		.corner = corner,
+		.facing = glm::vec3(0.0f, 0.0f, 1.0f),
+		.dimensions = glm::vec3(1.0f, 2.0f, 1.0f)
+	};
+}
+
+static Event moveCam(glm::vec3 direction) {
+	return Event(PLAYER_EID, EventType::StartAction,
+		StartActionEvent(PLAYER_EID, direction, ActionType::MoveCam));
+}
+
+/**
+ * Adds a wall to the state, with the given corner and dimensions
+ */
+static void addWall(SharedGameState& state, EntityID id, glm::vec3 corner, glm::vec3 dimensions) {
+	SharedObject wall;
+	wall.globalID = id;
+	wall.type = ObjectType::SolidSurface;
+	wall.physics = SharedPhysics {.corner = corner, .facing = glm::vec3(0.0f, 0.0f, 1.0f), .dimensions = dimensions};
+	wall.solidSurface = SharedSolidSurface {.surfaceType = SurfaceType::Wall, .is_internal = false};
+	state.objects.insert({id, wall});
+}
+
+TEST(MovementTest, SlidesAlongWalls) {
+	// a wall covering everything with x >= 2
+	auto collides = [](glm::vec3 corner) {
+		return boxesOverlap(corner, glm::vec3(1.0f), glm::vec3(2.0f, 0.0f, -100.0f), glm::vec3(1.0f, 10.0f, 200.0f));
+	};
+
+	glm::vec3 end = moveWithCollisions(glm::vec3(0.0f), glm::vec3(0.5f, 0.0f, 0.5f),
+		collides, [](glm::vec3) {});
+
+	// blocked in x but still free to move in z
+	EXPECT_LT(end.x + 1.0f, 2.0f);
+	EXPECT_FLOAT_EQ(end.z, 0.5f);
+}
+
+TEST(MovementPredictorTest, PredictsMovementImmediately) {
+	MovementPredictor predictor;
+	predictor.reset(playerPhysics(glm::vec3(0.0f)));
+
+	predictor.applyInput(moveCam(glm::vec3(1.0f, 0.0f, 0.0f)));
+	predictor.tick(1);
+
+	EXPECT_NEAR(predictor.getCorner().x, PLAYER_SPEED, 0.0001f);
+	EXPECT_FLOAT_EQ(predictor.getCorner().y, 0.0f);
+	EXPECT_EQ(predictor.numUnconfirmed(), 1);
+}
+
+TEST(MovementPredictorTest, PredictsJumps) {
+	MovementPredictor predictor;
+	predictor.reset(playerPhysics(glm::vec3(0.0f)));
+
+	predictor.applyInput(Event(PLAYER_EID, EventType::StartAction,
+		StartActionEvent(PLAYER_EID, glm::vec3(0.0f, 1.0f, 0.0f), ActionType::Jump)));
+	predictor.tick(1);
+	float height = predictor.getCorner().y;
+	EXPECT_GT(height, 0.0f);
+
+	// comes back down by itself, without jumping again
+	for (int i = 0; i < 100; i++) {
+		predictor.tick(1);
+	}
+	EXPECT_FLOAT_EQ(predictor.getCorner().y, 0.0f);
+}
+
+TEST(MovementPredictorTest, WallsStopMovement) {
+	SharedGameState state;
+	addWall(state, 2, glm::vec3(5.0f, 0.0f, -5.0f), glm::vec3(1.0f, 5.0f, 10.0f));
+
+	MovementPredictor predictor;
+	predictor.setStaticColliders(state);
+	predictor.reset(playerPhysics(glm::vec3(0.0f)));
+
+	predictor.applyInput(moveCam(glm::vec3(1.0f, 0.0f, 0.0f)));
+	for (uint32_t i = 1; i <= 10; i++) {
+		predictor.tick(i);
+	}
+
+	EXPECT_LT(predictor.getCorner().x + 1.0f, 5.0f);
+	EXPECT_GT(predictor.getCorner().x, 2.0f);
+}
+
+TEST(MovementPredictorTest, ReconcileReplaysUnconfirmedInput) {
+	MovementPredictor predictor;
+	predictor.reset(playerPhysics(glm::vec3(0.0f)));
+
+	predictor.applyInput(moveCam(glm::vec3(1.0f, 0.0f, 0.0f)));
+	for (uint32_t i = 1; i <= 5; i++) {
+		predictor.tick(i);
+	}
+
+	// the server agrees with the first 3 ticks
+	predictor.reconcile(ReconcileMovementEvent(3, glm::vec3(3 * PLAYER_SPEED, 0.0f, 0.0f),
+		glm::vec3(PLAYER_SPEED, 0.0f, 0.0f), glm::vec3(1.0f)));
+
+	EXPECT_EQ(predictor.numUnconfirmed(), 2);
+	EXPECT_NEAR(predictor.getPredictedCorner().x, 5 * PLAYER_SPEED, 0.001f);
+	EXPECT_NEAR(predictor.getStats().last_error, 0.0f, 0.001f);
+	EXPECT_EQ(predictor.getStats().corrections, 0);
+	EXPECT_EQ(predictor.getStats().ticks_replayed, 2);
+}
+
+TEST(MovementPredictorTest, ReconcileSmoothsSmallErrors) {
+	MovementPredictor predictor;
+	predictor.reset(playerPhysics(glm::vec3(0.0f)));
+
+	predictor.applyInput(moveCam(glm::vec3(1.0f, 0.0f, 0.0f)));
+	for (uint32_t i = 1; i <= 5; i++) {
+		predictor.tick(i);
+	}
+	glm::vec3 before = predictor.getCorner();
+
+	// something pushed the player sideways that the client didn't know about
+	predictor.reconcile(ReconcileMovementEvent(3, glm::vec3(3 * PLAYER_SPEED, 0.0f, 1.0f),
+		glm::vec3(PLAYER_SPEED, 0.0f, 0.0f), glm::vec3(1.0f)));
+
+	EXPECT_NEAR(predictor.getPredictedCorner().z, 1.0f, 0.001f);
+	EXPECT_EQ(predictor.getStats().corrections, 1);
+
+	// still drawn where it was, then eases over
+	EXPECT_NEAR(predictor.getCorner().z, before.z, 0.001f);
+	for (uint32_t i = 6; i <= 30; i++) {
+		predictor.tick(i);
+	}
+	EXPECT_NEAR(predictor.getCorner().z, 1.0f, 0.01f);
+}
+
+TEST(MovementPredictorTest, ReconcileSnapsLargeErrors) {
+	MovementPredictor predictor;
+	predictor.reset(playerPhysics(glm::vec3(0.0f)));
+	predictor.tick(1);
+
+	// e.g. respawning somewhere else entirely
+	glm::vec3 respawn(40.0f, 0.0f, 40.0f);
+	predictor.reconcile(ReconcileMovementEvent(1, respawn, glm::vec3(0.0f), glm::vec3(1.0f)));
+
+	EXPECT_NEAR(predictor.getCorner().x, respawn.x, 0.001f);
+	EXPECT_NEAR(predictor.getCorner().z, respawn.z, 0.001f);
+}
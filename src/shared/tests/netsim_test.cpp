@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "shared/netsim/delayline.hpp"
+#include "shared/netsim/netharness.hpp"
+#include "shared/network/packet.hpp"
+
+using namespace std::chrono_literals;
+
+using Clock = DelayLine::Clock;
+
+TEST(DelayLineTest, AddsLatencyAndJitter) {
+    LinkConditions conditions;
+    conditions.latency = 50ms;
+    conditions.jitter = 10ms;
+
+    DelayLine line(conditions, true);
+    Clock::time_point now = Clock::now();
+    Clock::time_point previous = now;
+    for (int i = 0; i < 1000; i++) {
+        auto arrival = line.schedule(100, now);
+        ASSERT_TRUE(arrival.has_value());
+        EXPECT_GE(arrival.value() - now, 40ms);
+        EXPECT_LE(arrival.value() - now, 60ms);
+
+        // TCP never reorders anything
+        EXPECT_GE(arrival.value(), previous);
+        previous = arrival.value();
+    }
+
+    EXPECT_EQ(line.getStats().sends, 1000);
+    EXPECT_EQ(line.getStats().bytes_sent, 100000);
+}
+
+TEST(DelayLineTest, BandwidthQueuesSends) {
+    LinkConditions conditions;
+    conditions.bandwidth = 1000;
+
+    DelayLine line(conditions, false);
+    Clock::time_point now = Clock::now();
+
+    EXPECT_EQ(line.schedule(100, now).value() - now, 100ms);
+    // has to wait for the first to get on the wire
+    EXPECT_EQ(line.schedule(100, now).value() - now, 200ms);
+    // but not once the link has caught up
+    EXPECT_EQ(line.schedule(100, now + 1s).value() - now, 1100ms);
+}
+
+TEST(DelayLineTest, UnreliableDropsLostSends) {
+    LinkConditions conditions;
+    conditions.loss = 0.25;
+
+    DelayLine line(conditions, false);
+    Clock::time_point now = Clock::now();
+    int dropped = 0;
+    for (int i = 0; i < 10000; i++) {
+        if (!line.schedule(100, now).has_value()) {
+            dropped++;
+        }
+    }
+
+    EXPECT_EQ(line.getStats().sends_lost, dropped);
+    EXPECT_NEAR(dropped, 2500, 250);
+}
+
+TEST(DelayLineTest, ReliableRetransmitsLostSends) {
+    LinkConditions conditions;
+    conditions.latency = 10ms;
+    conditions.loss = 1.0;
+
+    DelayLine line(conditions, true);
+    Clock::time_point now = Clock::now();
+    auto arrival = line.schedule(100, now);
+
+    ASSERT_TRUE(arrival.has_value());
+    EXPECT_EQ(arrival.value() - now, 10ms + conditions.retransmit_timeout);
+    EXPECT_EQ(line.getStats().sends_lost, 1);
+}
+
+/**
+ * @returns an event to send between sessions
+ */
+static Event makeEvent(std::size_t padding) {
+    SharedGameState state;
+    state.lobby.name = std::string(padding, 'x');
+    return Event(0, EventType::LoadGameState, LoadGameStateEvent(state));
+}
+
+TEST(NetHarnessTest, SessionsTalkThroughLink) {
+    LinkConditions conditions;
+    conditions.latency = 30ms;
+
+    NetHarness harness;
+    SessionPair pair = harness.connectSessions(conditions, conditions);
+
+    // both ways, with the link holding everything up by its latency
+    auto sent = Clock::now();
+    pair.client->sendEvent(makeEvent(10));
+    std::vector<Event> received;
+    ASSERT_TRUE(harness.pollUntil([&]() {
+        auto events = pair.server->handleAllReceivedPackets();
+        received.insert(received.end(), events.begin(), events.end());
+        return !received.empty();
+    }));
+    EXPECT_GE(Clock::now() - sent, 30ms);
+    EXPECT_EQ(received.size(), 1);
+
+    sent = Clock::now();
+    pair.server->sendEvent(makeEvent(10000));
+    received.clear();
+    ASSERT_TRUE(harness.pollUntil([&]() {
+        auto events = pair.client->handleAllReceivedPackets();
+        received.insert(received.end(), events.begin(), events.end());
+        return !received.empty();
+    }));
+    EXPECT_GE(Clock::now() - sent, 30ms);
+    EXPECT_EQ(received.size(), 1);
+
+    EXPECT_GT(pair.link->getStats(LinkDirection::FromTarget).bytes_sent, 10000);
+    EXPECT_LT(pair.link->getStats(LinkDirection::ToTarget).bytes_sent, 10000);
+}
+
+TEST(NetHarnessTest, ReliableLinkKeepsOrderThroughLoss) {
+    LinkConditions lossy;
+    lossy.latency = 5ms;
+    lossy.jitter = 5ms;
+    lossy.loss = 0.2;
+    lossy.retransmit_timeout = 20ms;
+
+    NetHarness harness;
+    SessionPair pair = harness.connectSessions(lossy, LinkConditions());
+
+    const std::size_t NUM_EVENTS = 50;
+    for (std::size_t i = 0; i < NUM_EVENTS; i++) {
+        pair.client->sendEvent(makeEvent(i));
+        harness.pollFor(1ms);
+    }
+
+    std::vector<Event> received;
+    ASSERT_TRUE(harness.pollUntil([&]() {
+        auto events = pair.server->handleAllReceivedPackets();
+        received.insert(received.end(), events.begin(), events.end());
+        return received.size() == NUM_EVENTS;
+    }));
+
+    for (std::size_t i = 0; i < NUM_EVENTS; i++) {
+        EXPECT_EQ(std::get<LoadGameStateEvent>(received[i].data).state.lobby.name.size(), i);
+    }
+    EXPECT_GT(pair.link->getStats(LinkDirection::ToTarget).sends_lost, 0);
+}
+
+TEST(NetHarnessTest, ClosingLinkDisconnectsSessions) {
+    NetHarness harness;
+    SessionPair pair = harness.connectSessions(LinkConditions(), LinkConditions());
+
+    pair.link->close();
+
+    // each side only finds out once it tries to use the connection
+    EXPECT_TRUE(harness.pollUntil([&]() {
+        pair.client->handleAllReceivedPackets();
+        pair.server->handleAllReceivedPackets();
+        return !pair.client->isOkay() && !pair.server->isOkay();
+    }));
+}
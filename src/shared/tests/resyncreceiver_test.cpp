@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "shared/network/constants.hpp"
+#include "shared/network/packetizer.hpp"
+#include "shared/network/resyncreceiver.hpp"
+
+/**
+ * @returns A resync with the given id, holding objects with ids [first_id, first_id + count)
+ */
+static SharedGameState makeResync(uint32_t resync_id, EntityID first_id, EntityID count) {
+    SharedGameState state;
+    state.phase = GamePhase::GAME;
+    state.timestep = 100 + resync_id;
+    state.resync_id = resync_id;
+    for (EntityID id = first_id; id < first_id + count; id++) {
+        SharedObject obj;
+        obj.globalID = id;
+        obj.type = ObjectType::SolidSurface;
+        state.objects.insert({id, obj});
+    }
+    return state;
+}
+
+TEST(ResyncReceiverTest, OnlyCompleteOnceEveryChunkArrives) {
+    auto chunks = splitSnapshot(0, makeResync(1, 0, 500), SNAPSHOT_DATAGRAM_BYTES);
+    ASSERT_GT(chunks.size(), 2);
+
+    // chunks can be repeated, and don't have to start with the first one
+    std::reverse(chunks.begin(), chunks.end());
+    chunks.insert(chunks.begin() + 1, chunks.front());
+
+    ResyncReceiver receiver;
+    EXPECT_FALSE(receiver.isResyncing());
+    for (std::size_t i = 0; i + 1 < chunks.size(); i++) {
+        EXPECT_FALSE(receiver.accept(chunks[i])) << "chunk " << i;
+        EXPECT_TRUE(receiver.isResyncing());
+    }
+    EXPECT_TRUE(receiver.accept(chunks.back()));
+    EXPECT_FALSE(receiver.isResyncing());
+
+    SharedGameState state = receiver.take();
+    EXPECT_EQ(state.objects.size(), 500);
+    EXPECT_EQ(state.phase, GamePhase::GAME);
+    EXPECT_EQ(state.timestep, 101);
+}
+
+TEST(ResyncReceiverTest, NewerResyncReplacesUnfinishedOne) {
+    auto old_chunks = splitSnapshot(0, makeResync(1, 0, 500), SNAPSHOT_DATAGRAM_BYTES);
+    auto new_chunks = splitSnapshot(0, makeResync(2, 1000, 10), SNAPSHOT_DATAGRAM_BYTES);
+    ASSERT_GT(old_chunks.size(), 1);
+    ASSERT_EQ(new_chunks.size(), 1);
+
+    ResyncReceiver receiver;
+    EXPECT_FALSE(receiver.accept(old_chunks[0]));
+    EXPECT_TRUE(receiver.accept(new_chunks[0]));
+
+    // the rest of the old one shows up too late to matter
+    for (std::size_t i = 1; i < old_chunks.size(); i++) {
+        EXPECT_FALSE(receiver.accept(old_chunks[i]));
+    }
+
+    SharedGameState state = receiver.take();
+    EXPECT_EQ(state.objects.size(), 10);
+    EXPECT_TRUE(state.objects.contains(1000));
+    EXPECT_EQ(state.timestep, 102);
+}
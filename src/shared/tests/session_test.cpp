@@ -0,0 +1,322 @@
+#include <gtest/gtest.h>
+
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "shared/network/session.hpp"
+#include "shared/network/packet.hpp"
+#include "shared/network/constants.hpp"
+
+using namespace std::chrono_literals;
+
+/**
+ * Sets up a pair of connected loopback sockets, one wrapped in a Session
+ * and one left raw so tests can control exactly when it reads or writes.
+ */
+class SessionTest : public ::testing::Test {
+protected:
+    SessionTest():
+        acceptor(context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+        peer(context)
+    {
+        tcp::socket accepted(context);
+        peer.connect(acceptor.local_endpoint());
+        acceptor.accept(accepted);
+
+        session = std::make_shared<Session>(std::move(accepted), SessionInfo({}, 1, false));
+    }
+
+    /**
+     * Runs the io_context until pred returns true or the timeout is hit
+     */
+    template <typename Pred>
+    bool pollUntil(Pred pred, std::chrono::milliseconds timeout = 2000ms) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            context.restart();
+            context.run_for(1ms);
+        }
+        return true;
+    }
+
+    /**
+     * @returns a LoadGameState event whose lobby name is the given size, to pad packets out
+     */
+    static Event makeEvent(std::size_t padding) {
+        SharedGameState state;
+        state.lobby.name = std::string(padding, 'x');
+        return Event(0, EventType::LoadGameState, LoadGameStateEvent(state));
+    }
+
+    boost::asio::io_context context;
+    tcp::acceptor acceptor;
+    tcp::socket peer;
+    std::shared_ptr<Session> session;
+};
+
+TEST_F(SessionTest, ReceivesPacketsSplitAcrossReads) {
+    auto packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(makeEvent(1000)));
+    auto buffers = packet->toBuffer();
+
+    std::string bytes(static_cast<const char*>(buffers[0].data()), buffers[0].size());
+    bytes.append(static_cast<const char*>(buffers[1].data()), buffers[1].size());
+
+    // nothing has been received yet, and checking doesn't block
+    EXPECT_TRUE(session->handleAllReceivedPackets().empty());
+
+    // send the header and half the data, which shouldn't produce an event yet
+    std::size_t half = bytes.size() / 2;
+    boost::asio::write(peer, boost::asio::buffer(bytes.data(), half));
+    context.restart();
+    context.run_for(50ms);
+    EXPECT_TRUE(session->handleAllReceivedPackets().empty());
+
+    // followed by the rest, along with a second full packet
+    boost::asio::write(peer, boost::asio::buffer(bytes.data() + half, bytes.size() - half));
+    boost::asio::write(peer, boost::asio::buffer(bytes));
+
+    std::vector<Event> events;
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        return events.size() >= 2;
+    }));
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].type, EventType::LoadGameState);
+    EXPECT_EQ(std::get<LoadGameStateEvent>(events[1].data).state.lobby.name.size(), 1000);
+}
+
+TEST_F(SessionTest, ReceivesPacketsLargerThanBuffer) {
+    // several packets that are each bigger than the buffer starts out as, sent back to back
+    auto packet = PackagedPacket::make_shared(PacketType::Event,
+        EventPacket(makeEvent(RECEIVE_BUFFER_INITIAL_SIZE * 3)));
+    for (int i = 0; i < 3; i++) {
+        boost::asio::write(peer, packet->toBuffer());
+    }
+
+    std::vector<Event> events;
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        return events.size() >= 3;
+    }));
+    ASSERT_EQ(events.size(), 3);
+    for (const auto& event : events) {
+        EXPECT_EQ(std::get<LoadGameStateEvent>(event.data).state.lobby.name.size(),
+            RECEIVE_BUFFER_INITIAL_SIZE * 3);
+    }
+
+    // and small packets keep working after the buffer has grown
+    boost::asio::write(peer, PackagedPacket::make_shared(PacketType::Event,
+        EventPacket(makeEvent(10)))->toBuffer());
+    events.clear();
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        return !events.empty();
+    }));
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(std::get<LoadGameStateEvent>(events[0].data).state.lobby.name.size(), 10);
+}
+
+TEST_F(SessionTest, ClosesOnOversizedHeader) {
+    // a header saying that nearly 4GB of data is on its way, which never comes
+    PacketHeader hdr(0xFFFF'FFF0, PacketType::Event);
+    hdr.to_network();
+    boost::asio::write(peer, boost::asio::buffer(&hdr, sizeof(hdr)));
+
+    EXPECT_TRUE(pollUntil([&]() {
+        session->handleAllReceivedPackets();
+        return !session->isOkay();
+    }));
+    EXPECT_TRUE(session->handleAllReceivedPackets().empty());
+}
+
+TEST_F(SessionTest, DropsPacketsWithUnknownFormat) {
+    // a packet claiming a WireFormat this build doesn't know, followed by a normal one
+    std::string data = serialize(EventPacket(makeEvent(10)));
+    PacketHeader hdr(data.size(), PacketType::Event, static_cast<WireFormat>(7));
+    hdr.to_network();
+    boost::asio::write(peer, boost::asio::buffer(&hdr, sizeof(hdr)));
+    boost::asio::write(peer, boost::asio::buffer(data));
+
+    auto packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(makeEvent(20)));
+    boost::asio::write(peer, packet->toBuffer());
+
+    std::vector<Event> events;
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        return !events.empty();
+    }));
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_TRUE(session->isOkay());
+    EXPECT_EQ(std::get<LoadGameStateEvent>(events[0].data).state.lobby.name.size(), 20);
+}
+
+TEST_F(SessionTest, ReceivesLargestAllowedPacket) {
+    // pad the event out so that the packet's data is exactly MAX_PACKET_BYTES
+    std::size_t padding = MAX_PACKET_BYTES - 1000;
+    auto packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(makeEvent(padding)));
+    padding += MAX_PACKET_BYTES - (packet->size() - sizeof(PacketHeader));
+    packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(makeEvent(padding)));
+    ASSERT_EQ(packet->size(), sizeof(PacketHeader) + MAX_PACKET_BYTES);
+
+    // sent twice, so that the second one is already arriving while the first is parsed
+    bool written = false;
+    std::vector<boost::asio::const_buffer> buffers;
+    for (int i = 0; i < 2; i++) {
+        auto packet_buffers = packet->toBuffer();
+        buffers.insert(buffers.end(), packet_buffers.begin(), packet_buffers.end());
+    }
+    boost::asio::async_write(peer, buffers,
+        [&](boost::system::error_code, std::size_t) { written = true; });
+
+    std::vector<Event> events;
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        EXPECT_LE(session->getReceiveBufferSize(), RECEIVE_BUFFER_MAX_SIZE);
+        return events.size() >= 2 && written;
+    }, 20'000ms));
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_TRUE(session->isOkay());
+    EXPECT_EQ(std::get<LoadGameStateEvent>(events[1].data).state.lobby.name.size(), padding);
+}
+
+TEST_F(SessionTest, SendsQueuedPacketsInOrder) {
+    session->sendEvent(makeEvent(10));
+    session->sendEvent(makeEvent(20));
+    EXPECT_GT(session->getSendQueueBytes(), 0);
+
+    EXPECT_TRUE(pollUntil([&]() { return session->getSendQueueBytes() == 0; }));
+
+    auto peer_session = std::make_shared<Session>(std::move(peer), SessionInfo({}, {}, {}));
+    std::vector<Event> events;
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = peer_session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        return events.size() >= 2;
+    }));
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(std::get<LoadGameStateEvent>(events[0].data).state.lobby.name.size(), 10);
+    EXPECT_EQ(std::get<LoadGameStateEvent>(events[1].data).state.lobby.name.size(), 20);
+}
+
+TEST_F(SessionTest, InputFramesBundleEvents) {
+    auto peer_session = std::make_shared<Session>(std::move(peer), SessionInfo({}, {}, {}));
+
+    // nothing added, so nothing is sent
+    session->sendInputFrame();
+    EXPECT_EQ(session->getSendQueueBytes(), 0);
+
+    for (int frame = 0; frame < 2; frame++) {
+        session->addInput(Event(1, EventType::ChangeFacing, ChangeFacingEvent(1, glm::vec3(1.0f * frame))));
+        session->addInput(Event(1, EventType::StartAction, StartActionEvent(1, glm::vec3(0.0f), ActionType::Jump)));
+        session->addInput(Event(1, EventType::UseItem, UseItemEvent(1)));
+        session->sendInputFrame();
+    }
+
+    std::vector<Event> events;
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = peer_session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        return events.size() >= 6;
+    }));
+
+    // events come out in the order they went in
+    ASSERT_EQ(events.size(), 6);
+    for (int frame = 0; frame < 2; frame++) {
+        EXPECT_EQ(events[frame * 3].type, EventType::ChangeFacing);
+        EXPECT_EQ(std::get<ChangeFacingEvent>(events[frame * 3].data).facing.x, 1.0f * frame);
+        EXPECT_EQ(events[frame * 3 + 1].type, EventType::StartAction);
+        EXPECT_EQ(events[frame * 3 + 2].type, EventType::UseItem);
+    }
+
+    ASSERT_TRUE(peer_session->getLastInputFrame().has_value());
+    EXPECT_EQ(peer_session->getLastInputFrame()->sequence, 2);
+}
+
+TEST_F(SessionTest, SlowReaderDoesNotBlockSender) {
+    // the peer never reads, so the kernel buffers fill up almost immediately
+    peer.set_option(boost::asio::socket_base::receive_buffer_size(4096));
+
+    auto packet = PackagedPacket::make_shared(PacketType::Event, EventPacket(makeEvent(50'000)));
+
+    auto start = std::chrono::steady_clock::now();
+    while (!session->isBackedUp()) {
+        session->sendPacket(packet);
+        context.restart();
+        context.poll();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // queueing a megabyte for a stalled reader should never wait on the network
+    EXPECT_LT(elapsed, 1s);
+    EXPECT_TRUE(session->isOkay());
+    EXPECT_GE(session->getSendQueueBytes(), SEND_QUEUE_HIGH_WATER_MARK);
+
+    // Continuing to send past the hard limit closes the session instead of growing forever
+    while (session->isOkay()) {
+        session->sendPacket(packet);
+    }
+    EXPECT_GT(session->getSendQueueBytes(), SEND_QUEUE_MAX_BYTES);
+
+    // and further sends are ignored
+    std::size_t queued = session->getSendQueueBytes();
+    session->sendPacket(packet);
+    EXPECT_EQ(session->getSendQueueBytes(), queued);
+}
+
+TEST_F(SessionTest, CountsTrafficByType) {
+    auto peer_session = std::make_shared<Session>(std::move(peer), SessionInfo({}, {}, {}));
+
+    auto big = PackagedPacket::make_shared(PacketType::Event, EventPacket(makeEvent(5000)));
+    session->sendPacket(big);
+    session->sendEvent(makeEvent(10));
+    session->addInput(Event(1, EventType::UseItem, UseItemEvent(1)));
+    session->addInput(Event(1, EventType::UseItem, UseItemEvent(1)));
+    session->sendInputFrame();
+
+    const NetworkTelemetry& sent = session->getTelemetry();
+    EXPECT_EQ(sent.sent_by_packet.at(PacketType::Event).count, 2);
+    EXPECT_EQ(sent.sent_by_packet.at(PacketType::InputFrame).count, 1);
+    EXPECT_EQ(sent.sent_by_event.at(EventType::LoadGameState).count, 2);
+    EXPECT_EQ(sent.largest_packet_sent, big->size());
+    EXPECT_GE(sent.max_send_queue_bytes, big->size());
+    EXPECT_EQ(sent.totalBytesSent(),
+        sent.sent_by_packet.at(PacketType::Event).bytes + sent.sent_by_packet.at(PacketType::InputFrame).bytes);
+
+    std::vector<Event> events;
+    EXPECT_TRUE(pollUntil([&]() {
+        auto received = peer_session->handleAllReceivedPackets();
+        events.insert(events.end(), received.begin(), received.end());
+        return events.size() >= 4;
+    }));
+
+    NetworkTelemetry received = peer_session->takeTelemetry();
+    EXPECT_EQ(received.received_by_packet.at(PacketType::Event).count, 2);
+    EXPECT_EQ(received.received_by_packet.at(PacketType::Event).bytes, sent.sent_by_packet.at(PacketType::Event).bytes);
+    EXPECT_EQ(received.received_by_event.at(EventType::LoadGameState).count, 2);
+    // events in an InputFrame are counted, but their bytes go to the InputFrame
+    EXPECT_EQ(received.received_by_event.at(EventType::UseItem).count, 2);
+    EXPECT_EQ(received.received_by_event.at(EventType::UseItem).bytes, 0);
+    EXPECT_EQ(received.totalBytesReceived(), sent.totalBytesSent());
+    EXPECT_EQ(received.largest_packet_received, big->size());
+
+    // taking the telemetry starts the counts over
+    EXPECT_EQ(peer_session->getTelemetry().totalBytesReceived(), 0);
+
+    // and adding sessions together adds up their counts
+    NetworkTelemetry total = received;
+    total.merge(received);
+    EXPECT_EQ(total.received_by_event.at(EventType::UseItem).count, 4);
+    EXPECT_EQ(total.toJson().at("received_by_event").at("UseItem").at("count"), 4);
+    EXPECT_EQ(total.toJson().at("bytes_received"), 2 * received.totalBytesReceived());
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+
+#include "shared/utilities/smartvector.hpp"
+
+TEST(SmartVectorTest, PushReusesGaps) {
+    int a = 1, b = 2, c = 3, d = 4;
+    SmartVector<int*> vector;
+    EXPECT_EQ(vector.push(&a), 0);
+    EXPECT_EQ(vector.push(&b), 1);
+    EXPECT_EQ(vector.push(&c), 2);
+
+    EXPECT_TRUE(vector.remove(1));
+    EXPECT_TRUE(vector.remove(1));
+    EXPECT_FALSE(vector.remove(3));
+    EXPECT_EQ(vector.get(1), nullptr);
+    EXPECT_EQ(vector.get(3), nullptr);
+    EXPECT_EQ(vector.numElements(), 2);
+
+    // removing twice must not hand out the same gap twice
+    EXPECT_EQ(vector.push(&d), 1);
+    EXPECT_EQ(vector.push(&d), 3);
+    EXPECT_EQ(vector.get(1), &d);
+    EXPECT_EQ(vector.size(), 4);
+    EXPECT_EQ(vector.numElements(), 4);
+}
+
+TEST(SmartVectorTest, SetFillsGap) {
+    int a = 1, b = 2;
+    SmartVector<int*> vector;
+    std::size_t empty = vector.pushEmpty();
+    EXPECT_EQ(vector.get(empty), nullptr);
+    EXPECT_EQ(vector.numElements(), 0);
+
+    EXPECT_TRUE(vector.set(&a, empty));
+    EXPECT_FALSE(vector.set(&a, 5));
+    EXPECT_EQ(vector.get(empty), &a);
+    EXPECT_EQ(vector.numElements(), 1);
+
+    // the gap was filled, so it can't be pushed into again
+    EXPECT_EQ(vector.push(&b), 1);
+    EXPECT_EQ(vector.get(empty), &a);
+}
+
+TEST(SmartVectorTest, IterationSkipsGaps) {
+    std::vector<int> values(200);
+    SmartVector<int*> vector;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        values[i] = i;
+        vector.push(&values[i]);
+    }
+    // leave whole words of the bitset empty as well as single gaps
+    for (std::size_t i = 0; i < values.size(); i++) {
+        if (i % 3 == 0 || (i >= 64 && i < 192)) {
+            vector.remove(i);
+        }
+    }
+
+    std::vector<std::size_t> visited;
+    for (auto it = vector.begin(); it != vector.end(); ++it) {
+        EXPECT_EQ(static_cast<std::size_t>(**it), it.index());
+        visited.push_back(it.index());
+    }
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        if (vector.get(i) != nullptr) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_EQ(visited, expected);
+    EXPECT_EQ(visited.size(), vector.numElements());
+
+    SmartVector<int*> empty;
+    EXPECT_FALSE(empty.begin() != empty.end());
+}
+
+TEST(SmartVectorTest, IterationSkipsObjectsRemovedAhead) {
+    std::vector<int> values(100);
+    SmartVector<int*> vector;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        vector.push(&values[i]);
+    }
+
+    std::size_t visited = 0;
+    for (auto it = vector.begin(); it != vector.end(); ++it) {
+        // removing the next one, in the same word or the next, means it is never reached
+        vector.remove(it.index() + 1);
+        EXPECT_EQ(it.index() % 2, 0);
+        visited++;
+    }
+    EXPECT_EQ(visited, 50);
+}
+
+struct Boxed {
+    int value;
+
+    DEF_SERIALIZE(Archive& ar, const unsigned int version) {
+        ar & value;
+    }
+};
+
+TEST(SmartVectorTest, SerializesGaps) {
+    std::vector<Boxed> values(5);
+    SmartVector<Boxed*> vector;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        values[i].value = i;
+        vector.push(&values[i]);
+    }
+    vector.remove(1);
+    vector.remove(3);
+
+    std::stringstream stream;
+    {
+        boost::archive::text_oarchive out(stream);
+        out << vector;
+    }
+    SmartVector<Boxed*> loaded;
+    {
+        boost::archive::text_iarchive in(stream);
+        in >> loaded;
+    }
+
+    EXPECT_EQ(loaded.size(), 5);
+    EXPECT_EQ(loaded.numElements(), 3);
+    for (Boxed* boxed : loaded) {
+        EXPECT_EQ(boxed->value % 2, 0);
+        delete boxed;
+    }
+
+    // the gaps come back as gaps
+    Boxed extra;
+    EXPECT_EQ(loaded.push(&extra) % 2, 1);
+    EXPECT_EQ(loaded.push(&extra) % 2, 1);
+    EXPECT_EQ(loaded.push(&extra), 5);
+}
+
+/**
+ * Not a correctness test: reports how long it takes to walk a SmartVector with holes
+ * in it, and to remove and push objects into it, like ServerGameState does every tick
+ */
+TEST(SmartVectorTest, DISABLED_IterationAndChurnCost) {
+    const std::size_t NUM_SLOTS = 10'000;
+    const int ITERATIONS = 200;
+
+    std::vector<int> values(NUM_SLOTS, 1);
+    SmartVector<int*> vector;
+    for (std::size_t i = 0; i < NUM_SLOTS; i++) {
+        vector.push(&values[i]);
+    }
+    // a quarter of the slots are empty
+    for (std::size_t i = 0; i < NUM_SLOTS; i += 4) {
+        vector.remove(i);
+    }
+
+    long long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (std::size_t i = 0; i < vector.size(); i++) {
+            int* value = vector.get(i);
+            if (value == nullptr) continue;
+            sum += *value;
+        }
+    }
+    auto iterated = std::chrono::steady_clock::now();
+
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (int* value : vector) {
+            sum += *value;
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    // remove and put back a tenth of the objects, like projectiles coming and going
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (std::size_t i = 1; i < NUM_SLOTS; i += 10) {
+            vector.remove(i);
+        }
+        for (std::size_t i = 1; i < NUM_SLOTS; i += 10) {
+            vector.push(&values[i]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto per_slot = [&](auto duration, std::size_t slots) {
+        return std::chrono::duration<double, std::nano>(duration).count() / ITERATIONS / slots;
+    };
+    std::cout << "SmartVector of " << NUM_SLOTS << " slots: get() " << per_slot(iterated - start, NUM_SLOTS)
+        << " ns per slot, range-for " << per_slot(mid - iterated, NUM_SLOTS)
+        << " ns per slot, remove + push " << per_slot(end - mid, NUM_SLOTS / 10) << " ns per object\n";
+
+    EXPECT_EQ(vector.numElements(), NUM_SLOTS - NUM_SLOTS / 4);
+    EXPECT_NE(sum, 0);
+}
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <boost/asio/io_context.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "shared/network/snapshotchannel.hpp"
+#include "shared/network/snapshotreceiver.hpp"
+#include "shared/network/packet.hpp"
+
+using namespace std::chrono_literals;
+
+static const EntityID CLIENT_EID = 7;
+
+/**
+ * Sets up a server and a client SnapshotChannel talking to each other over loopback
+ */
+class SnapshotChannelTest : public ::testing::Test {
+protected:
+    SnapshotChannelTest():
+        server(std::make_shared<SnapshotChannel>(udp::socket(context, udp::endpoint(address_v4::loopback(), 0)))),
+        client(std::make_shared<SnapshotChannel>(udp::socket(context, udp::endpoint(address_v4::loopback(), 0))))
+    {
+        server->listen();
+        client->connectTo(udp::endpoint(address_v4::loopback(), server->getPort()), CLIENT_EID);
+        client->listen();
+    }
+
+    /**
+     * Runs the io_context until pred returns true or the timeout is hit
+     */
+    template <typename Pred>
+    bool pollUntil(Pred pred, std::chrono::milliseconds timeout = 2000ms) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            context.restart();
+            context.run_for(1ms);
+        }
+        return true;
+    }
+
+    /**
+     * Says hello from the client until the server knows about it
+     */
+    void handshake() {
+        ASSERT_TRUE(pollUntil([&]() {
+            client->sendHello();
+            return server->hasPeer(CLIENT_EID, address_v4::loopback());
+        }));
+    }
+
+    /**
+     * @returns a packaged snapshot chunk with the given id
+     */
+    static std::shared_ptr<PackagedPacket> makeSnapshot(uint32_t snapshot_id) {
+        SharedGameState state;
+        state.snapshot_id = snapshot_id;
+        return PackagedPacket::make_shared(PacketType::Event,
+            EventPacket(Event(0, EventType::LoadGameState, LoadGameStateEvent(state))));
+    }
+
+    static uint32_t snapshotId(const Event& event) {
+        return std::get<LoadGameStateEvent>(event.data).state.snapshot_id;
+    }
+
+    boost::asio::io_context context;
+    std::shared_ptr<SnapshotChannel> server;
+    std::shared_ptr<SnapshotChannel> client;
+};
+
+TEST_F(SnapshotChannelTest, SendsSnapshotsAfterHello) {
+    // nowhere to send it yet
+    EXPECT_FALSE(server->sendSnapshot(CLIENT_EID, makeSnapshot(1)));
+    EXPECT_FALSE(client->isEstablished());
+
+    handshake();
+    ASSERT_TRUE(server->sendSnapshot(CLIENT_EID, makeSnapshot(1)));
+
+    std::vector<Event> events;
+    ASSERT_TRUE(pollUntil([&]() {
+        for (const auto& event : client->takeReceivedEvents()) {
+            events.push_back(event);
+        }
+        return !events.empty();
+    }));
+
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(snapshotId(events[0]), 1);
+    EXPECT_TRUE(client->isEstablished());
+
+    // and forgets about the client once told to
+    server->removePeer(CLIENT_EID);
+    EXPECT_FALSE(server->sendSnapshot(CLIENT_EID, makeSnapshot(2)));
+}
+
+TEST_F(SnapshotChannelTest, LostDatagramsDontHoldUpLaterOnes) {
+    handshake();
+
+    // lose every third snapshot on the way out
+    server->setLossShim([](DatagramType type, uint32_t sequence) {
+        return type == DatagramType::Snapshot && sequence % 3 == 0;
+    });
+
+    // the last one has to get through for us to know when to stop waiting
+    const uint32_t NUM_SNAPSHOTS = 31;
+    const uint32_t NUM_LOST = NUM_SNAPSHOTS / 3;
+    for (uint32_t id = 1; id <= NUM_SNAPSHOTS; id++) {
+        ASSERT_TRUE(server->sendSnapshot(CLIENT_EID, makeSnapshot(id)));
+    }
+
+    std::vector<Event> events;
+    ASSERT_TRUE(pollUntil([&]() {
+        for (const auto& event : client->takeReceivedEvents()) {
+            events.push_back(event);
+        }
+        return !events.empty() && snapshotId(events.back()) == NUM_SNAPSHOTS;
+    }));
+
+    EXPECT_EQ(events.size(), NUM_SNAPSHOTS - NUM_LOST);
+    for (const auto& event : events) {
+        EXPECT_NE(snapshotId(event) % 3, 0);
+    }
+    EXPECT_EQ(server->getStats().datagrams_dropped, NUM_LOST);
+    EXPECT_EQ(client->getStats().datagrams_missing, NUM_LOST);
+}
+
+TEST_F(SnapshotChannelTest, DropsStaleDatagrams) {
+    // pretend to be the server from a raw socket, so the sequence numbers can be
+    // sent out of order
+    udp::socket raw(context, udp::endpoint(address_v4::loopback(), 0));
+    client->connectTo(raw.local_endpoint(), CLIENT_EID);
+
+    auto sendRaw = [&](uint32_t sequence, uint32_t snapshot_id) {
+        auto packet = makeSnapshot(snapshot_id);
+        DatagramHeader hdr(DatagramType::Snapshot, sequence, CLIENT_EID);
+        hdr.to_network();
+
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.push_back(boost::asio::buffer(&hdr, sizeof(DatagramHeader)));
+        for (const auto& buffer : packet->toBuffer()) {
+            buffers.push_back(buffer);
+        }
+        raw.send_to(buffers, udp::endpoint(address_v4::loopback(), client->getPort()));
+    };
+
+    sendRaw(5, 5);
+    sendRaw(3, 3);
+    sendRaw(6, 6);
+
+    std::vector<Event> events;
+    ASSERT_TRUE(pollUntil([&]() {
+        for (const auto& event : client->takeReceivedEvents()) {
+            events.push_back(event);
+        }
+        return client->getStats().datagrams_received + client->getStats().datagrams_stale == 3;
+    }));
+
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(snapshotId(events[0]), 5);
+    EXPECT_EQ(snapshotId(events[1]), 6);
+    EXPECT_EQ(client->getStats().datagrams_stale, 1);
+}
+
+TEST_F(SnapshotChannelTest, SkipsMalformedDatagrams) {
+    udp::socket raw(context, udp::endpoint(address_v4::loopback(), 0));
+    client->connectTo(raw.local_endpoint(), CLIENT_EID);
+    udp::endpoint client_endpoint(address_v4::loopback(), client->getPort());
+
+    // valid headers followed by junk, in a format that exists and in one that doesn't
+    std::string junk(64, '\xAB');
+    for (auto format : {WireFormat::Binary, static_cast<WireFormat>(7)}) {
+        DatagramHeader hdr(DatagramType::Snapshot, format == WireFormat::Binary ? 10 : 11, CLIENT_EID);
+        hdr.to_network();
+        PacketHeader packet_hdr(junk.size(), PacketType::Event, format);
+        packet_hdr.to_network();
+        raw.send_to(std::vector<boost::asio::const_buffer> {
+            boost::asio::buffer(&hdr, sizeof(hdr)),
+            boost::asio::buffer(&packet_hdr, sizeof(packet_hdr)),
+            boost::asio::buffer(junk)
+        }, client_endpoint);
+    }
+
+    // followed by a real snapshot
+    DatagramHeader hdr(DatagramType::Snapshot, 3, CLIENT_EID);
+    hdr.to_network();
+    std::vector<boost::asio::const_buffer> buffers {boost::asio::buffer(&hdr, sizeof(hdr))};
+    auto packet = makeSnapshot(3);
+    for (const auto& buffer : packet->toBuffer()) {
+        buffers.push_back(buffer);
+    }
+    raw.send_to(buffers, client_endpoint);
+
+    std::vector<Event> events;
+    ASSERT_TRUE(pollUntil([&]() {
+        for (const auto& event : client->takeReceivedEvents()) {
+            events.push_back(event);
+        }
+        return !events.empty();
+    }));
+
+    // the bad ones don't count towards the sequence, so the real one isn't stale
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(snapshotId(events[0]), 3);
+    EXPECT_EQ(client->getStats().datagrams_malformed, 2);
+    EXPECT_EQ(client->getStats().datagrams_stale, 0);
+}
+
+static SharedGameState makeChunk(uint32_t snapshot_id, uint32_t chunk_index, uint32_t num_chunks) {
+    SharedGameState chunk;
+    chunk.snapshot_id = snapshot_id;
+    chunk.chunk_index = chunk_index;
+    chunk.num_chunks = num_chunks;
+    return chunk;
+}
+
+TEST(SnapshotReceiverTest, AcksOnlyCompleteSnapshots) {
+    SnapshotReceiver receiver;
+
+    EXPECT_TRUE(receiver.accept(makeChunk(1, 1, 2)));
+    EXPECT_EQ(receiver.takeAck(), 0);
+
+    EXPECT_TRUE(receiver.accept(makeChunk(1, 0, 2)));
+    EXPECT_EQ(receiver.takeAck(), 1);
+    EXPECT_EQ(receiver.takeAck(), 0);
+
+    // snapshot 2 never finishes, but 3 acknowledges everything before it
+    EXPECT_TRUE(receiver.accept(makeChunk(2, 0, 2)));
+    EXPECT_TRUE(receiver.accept(makeChunk(3, 0, 1)));
+    EXPECT_EQ(receiver.takeAck(), 3);
+}
+
+TEST(SnapshotReceiverTest, DropsChunksOfOlderSnapshots) {
+    SnapshotReceiver receiver;
+
+    EXPECT_TRUE(receiver.accept(makeChunk(4, 0, 2)));
+    EXPECT_FALSE(receiver.accept(makeChunk(3, 1, 2)));
+    EXPECT_TRUE(receiver.accept(makeChunk(4, 1, 2)));
+    EXPECT_EQ(receiver.takeAck(), 4);
+
+    // untracked state always applies
+    EXPECT_TRUE(receiver.accept(makeChunk(0, 0, 1)));
+    EXPECT_EQ(receiver.takeAck(), 0);
+}
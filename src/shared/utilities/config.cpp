@@ -48,7 +48,14 @@ GameConfig GameConfig::parse(int argc, char** argv) { // cppcheck-suppress const
                     .procedural = json.at("server").at("maze").at("procedural"),
                     .maze_file = json.at("server").at("maze").at("maze_file")
                 },
-                .disable_enemies = json.at("server").at("disable_enemies") 
+                .disable_enemies = json.at("server").at("disable_enemies"),
+                .max_packet_bytes = json.at("server").at("max_packet_bytes"),
+                .interest_radius = json.at("server").at("interest_radius"),
+                .udp_snapshots = json.at("server").at("udp_snapshots"),
+                .telemetry = {
+                    .interval_ticks = json.at("server").at("telemetry").at("interval_ticks"),
+                    .file = json.at("server").at("telemetry").at("file")
+                }
             },
             .client = {
                 .lobby_discovery = json.at("client").at("lobby_discovery"),
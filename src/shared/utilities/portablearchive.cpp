@@ -0,0 +1,23 @@
+#include "shared/utilities/portablearchive.hpp"
+
+// The boost archive templates are only defined in these, so the parts of them that
+// the portable archives use have to be instantiated here
+#include <boost/archive/impl/archive_serializer_map.ipp>
+#include <boost/archive/impl/basic_binary_iarchive.ipp>
+#include <boost/archive/impl/basic_binary_iprimitive.ipp>
+#include <boost/archive/impl/basic_binary_oarchive.ipp>
+#include <boost/archive/impl/basic_binary_oprimitive.ipp>
+
+namespace boost {
+    namespace archive {
+        template class detail::archive_serializer_map<PortableBinaryOArchive>;
+        template class basic_binary_oprimitive<PortableBinaryOArchive, char, std::char_traits<char>>;
+        template class basic_binary_oarchive<PortableBinaryOArchive>;
+        template class binary_oarchive_impl<PortableBinaryOArchive, char, std::char_traits<char>>;
+
+        template class detail::archive_serializer_map<PortableBinaryIArchive>;
+        template class basic_binary_iprimitive<PortableBinaryIArchive, char, std::char_traits<char>>;
+        template class basic_binary_iarchive<PortableBinaryIArchive>;
+        template class binary_iarchive_impl<PortableBinaryIArchive, char, std::char_traits<char>>;
+    }
+}